@@ -0,0 +1,464 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QFile>
+#include <QTextStream>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <math.h>
+#include <stdio.h>
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+#include "CBenchmarkRunner.h"
+#include "CCommons.h"
+#include "CPerformance.h"
+
+CBenchmarkRunner::CBenchmarkRunner(CCacheManager *cacheManagerPointer) : cacheManager(cacheManagerPointer)
+{
+    double aspectRatio = (double)CONST_DEF_WIDTH/(double)CONST_DEF_HEIGHT;
+
+    // create Earth Buffers - cache manager accepts only these two earths
+    earth = new CEarth;
+    earthExchanged = new CEarth;
+    cacheManager->setEarthBuffers(earthExchanged, earth);
+
+    // nothing is drawn - only state used by tree updating matters
+    dss.drawTerrainPoint = false;
+    dss.drawTerrainPointColor = false;
+    dss.drawTerrainWire = false;
+    dss.drawTerrainWireColor = false;
+    dss.drawTerrainSolid = false;
+    dss.drawTerrainSolidStrip = false;
+    dss.drawTerrainSolidColor = false;
+    dss.drawTerrainTexture = false;
+    dss.drawTerrainTextureStrip = false;
+    dss.drawTerrainBottomPlaneWire = false;
+    dss.drawTerrainBottomPlaneWireColor = false;
+    dss.drawTerrainBottomPlaneSolid = false;
+    dss.drawTerrainBottomPlaneSolidColor = false;
+    dss.drawTerrainBottomPlaneTexture = false;
+    dss.drawTerrainNormals = false;
+    dss.drawEarthPoint = false;
+    dss.drawGrid = false;
+    dss.drawAxes = false;
+    dss.sunEnabled = false;
+    dss.treeUpdating = true;
+    dss.treeUpdatingBudget = BENCHMARK_TREE_UPDATING_BUDGET;
+    dss.camFOV = CAM_FOV;
+    dss.camViewportHeight = CONST_DEF_HEIGHT;
+    dss.camClippingAngleCosine = cos(CONST_PIDIV180 * (CAM_FOV * aspectRatio * 1.1) / 2.0);   // like CCamera
+    dss.lodMultiplier = BENCHMARK_LOD_MULTIPLIER;
+    dss.dontUseCache = false;
+    dss.dontUseDiskHgt = false;
+    dss.dontUseDiskRaw = false;
+
+    earth->setDrawingStateSnapshot(&dss);
+    earthExchanged->setDrawingStateSnapshot(&dss);
+
+    treeUpdatesChanged = 0;
+    flightTime = 0;
+    terrainsInTree = 0;
+    maxLOD = 0;
+
+    setDefaultFlight();
+}
+
+CBenchmarkRunner::~CBenchmarkRunner()
+{
+    delete earth;
+    delete earthExchanged;
+}
+
+void CBenchmarkRunner::setDefaultFlight()
+{
+    int i;
+
+    // locations of benchmark from CAnimationThread
+    flightLon.clear();
+    flightLat.clear();
+    flightAlt.clear();
+    flightLon << 20.088333 << 21.101202 << 41.101202 << 21.101202 << 301.101202 << 20.088333;
+    flightLat << 49.179444 << 47.123456 << -17.123456 << 37.123456 << 47.123456 << 49.179444;
+    flightAlt << 2503.000 << 1500.0 << 2340.0 << 9030.0 << 34.0 << 2503.000;
+    for (i=0; i<flightAlt.size(); i++)
+        flightAlt[i] += BENCHMARK_CAMERA_HEIGHT;
+}
+
+bool CBenchmarkRunner::loadFlight(const QString &fileName)
+{
+    QFile file(fileName);
+    QString line;
+    QStringList values;
+    bool lonOk, latOk, altOk;
+    double lon, lat, alt;
+
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qWarning("Benchmark - could not open flight file %s", qPrintable(fileName));
+        return false;
+    }
+
+    // one waypoint per line: lon lat alt (camera altitude above sea level in meters), # starts comment
+    flightLon.clear();
+    flightLat.clear();
+    flightAlt.clear();
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        line = in.readLine().section('#', 0, 0).trimmed();
+        if (line.isEmpty()) continue;
+
+        values = line.split(' ', QString::SkipEmptyParts);
+        if (values.size()!=3) {
+            qWarning("Benchmark - wrong waypoint '%s' in %s", qPrintable(line), qPrintable(fileName));
+            return false;
+        }
+        lon = values.at(0).toDouble(&lonOk);
+        lat = values.at(1).toDouble(&latOk);
+        alt = values.at(2).toDouble(&altOk);
+        if (!lonOk || !latOk || !altOk) {
+            qWarning("Benchmark - wrong waypoint '%s' in %s", qPrintable(line), qPrintable(fileName));
+            return false;
+        }
+        if (lon<0.0) lon += 360.0;
+        flightLon << lon;
+        flightLat << lat;
+        flightAlt << alt;
+    }
+
+    if (flightLon.size()<2) {
+        qWarning("Benchmark - flight file %s needs at least two waypoints", qPrintable(fileName));
+        return false;
+    }
+
+    return true;
+}
+
+bool CBenchmarkRunner::loadCameraPath(const QString &fileName)
+{
+    return cameraPath.load(fileName);
+}
+
+void CBenchmarkRunner::setTreeUpdatingBudget(int budgetMs)
+{
+    dss.treeUpdatingBudget = budgetMs;
+}
+
+void CBenchmarkRunner::setDontUseCache(bool dontUseCache)
+{
+    dss.dontUseCache = dontUseCache;
+}
+
+void CBenchmarkRunner::run()
+{
+    CPerformance *performance = CPerformance::getInstance();
+    CCameraPathSample sample;
+    QElapsedTimer flightTimer;
+
+    flightTimer.start();
+
+    if (cameraPath.getTicks()>0) {
+        cameraPath.getSample(0, &sample);
+        sample.applyToSnapshot(&dss);
+    } else {
+        setCamera(flightLon.at(0), flightLat.at(0), flightAlt.at(0));
+    }
+    earth->initLOD_0();
+    earthExchanged->initLOD_0();
+
+    if (cameraPath.getTicks()>0)
+        replayCameraPath();
+    else
+        flyWaypoints();
+
+    flightTime = flightTimer.elapsed();
+    terrainsInTree = performance->terrainsInTree;
+    maxLOD = performance->maxLOD;
+}
+
+void CBenchmarkRunner::flyWaypoints()
+{
+    double deltaLon, deltaLat, deltaAlt, deltaLonLatLength;
+    double cosFunc, cosFuncAlt;
+    double animPositionInUnit;
+    double lon, lat, alt;
+    int i, step;
+
+    settleTree();
+
+    for (i=0; i<flightLon.size()-1; i++) {
+        deltaLon = flightLon.at(i+1) - flightLon.at(i);
+        if (deltaLon>180.0)
+            deltaLon = deltaLon - 360.0;
+        if (deltaLon<-180.0)
+            deltaLon = deltaLon + 360.0;
+        deltaLat = flightLat.at(i+1) - flightLat.at(i);
+        deltaAlt = flightAlt.at(i+1) - flightAlt.at(i);
+        deltaLonLatLength = sqrt(deltaLon*deltaLon + deltaLat*deltaLat);
+
+        // same path as CAnimationThread::animateEarthPoint but in fixed steps instead of real time
+        for (step=1; step<=BENCHMARK_STEPS_PER_SEGMENT; step++) {
+            animPositionInUnit = (double)step/(double)BENCHMARK_STEPS_PER_SEGMENT;
+            cosFunc = (cos(-CONST_PI + animPositionInUnit*CONST_PI)+1.0)/2.0;
+            cosFuncAlt = (cos(-CONST_PI + animPositionInUnit*2.0*CONST_PI)+1.0)/2.0;
+
+            lon = flightLon.at(i) + deltaLon*cosFunc;
+            lat = flightLat.at(i) + deltaLat*cosFunc;
+            alt = flightAlt.at(i) + deltaAlt*cosFunc + ANIMATION_EP_ALT*cosFuncAlt*(deltaLonLatLength/254.56);
+
+            if (lon<0.0) lon += 360.0;
+            if (lon>360.0) lon -= 360.0;
+
+            setCamera(lon, lat, alt);
+            updateTree();
+        }
+
+        // camera stops at waypoint - load everything that is visible from there
+        settleTree();
+    }
+}
+
+void CBenchmarkRunner::replayCameraPath()
+{
+    CCameraPathSample sample;
+    int tick;
+
+    // one tree update per recorded animation tick, camera from recorded session replaces benchmark defaults
+    for (tick=0; tick<cameraPath.getTicks(); tick++) {
+        cameraPath.getSample(tick, &sample);
+        sample.applyToSnapshot(&dss);
+        updateTree();
+    }
+
+    settleTree();
+}
+
+void CBenchmarkRunner::setCamera(double lon, double lat, double alt)
+{
+    double x, y, z;
+
+    // camera in orbit mode looks at Earth center
+    CCommons::getCartesianFromSpherical(lon, lat, CONST_EARTH_RADIUS + alt, &x, &y, &z);
+    dss.camPosition.setX(x);
+    dss.camPosition.setY(y);
+    dss.camPosition.setZ(z);
+    dss.camLookingDirectionNormal = -dss.camPosition.normalized();
+}
+
+bool CBenchmarkRunner::updateTree()
+{
+    QElapsedTimer timer;
+    CEarth *tmp;
+    bool treeUpdated;
+
+    // same work as one loop of CTerrainLoaderThread
+    timer.start();
+    treeUpdated = earth->updateTerrainTree();
+    if (treeUpdated)
+        cacheManager->cacheKeepSize(earth);
+    updateTimes.append(timer.nsecsElapsed());
+
+    if (!treeUpdated)
+        return false;
+
+    treeUpdatesChanged++;
+
+    // exchange earths - there are no textures in VRAM to remove
+    tmp = earth;
+    earth = earthExchanged;
+    earthExchanged = tmp;
+    earthExchanged->textureIDListToRemoveFromVRAM.clear();
+
+    return true;
+}
+
+void CBenchmarkRunner::settleTree()
+{
+    CPerformance *performance = CPerformance::getInstance();
+    bool treeUpdated;
+    int i;
+
+    // camera stopped - time to full detail ends with first tree without postponed splits,
+    // textures are built with terrain data here so nothing else is missing
+    performance->startConvergence(performance->getTimeNs());
+    for (i=0; i<BENCHMARK_MAX_SETTLE_UPDATES; i++) {
+        treeUpdated = updateTree();
+        if (!treeUpdated || earthExchanged->splitsPostponed==0) {
+            performance->setConvergenceTreeReady(performance->getTimeNs());
+            performance->checkConvergence();
+        }
+        if (!treeUpdated)
+            break;
+    }
+    performance->cancelConvergence();
+}
+
+qint64 CBenchmarkRunner::getPercentile(const QVector<qint64> &sortedTimes, double percent)
+{
+    int index;
+
+    if (sortedTimes.isEmpty())
+        return 0;
+
+    // nearest rank
+    index = (int)ceil(percent/100.0 * sortedTimes.size()) - 1;
+    if (index<0) index = 0;
+    if (index>=sortedTimes.size()) index = sortedTimes.size()-1;
+
+    return sortedTimes.at(index);
+}
+
+qint64 CBenchmarkRunner::getPeakMemoryKB()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS pmc;
+
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return -1;
+    return (qint64)pmc.PeakWorkingSetSize/1024;
+#elif defined(Q_OS_UNIX)
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage)!=0)
+        return -1;
+#if defined(Q_OS_MAC)
+    return (qint64)usage.ru_maxrss/1024;           // bytes on Mac
+#else
+    return (qint64)usage.ru_maxrss;                // kilobytes on Linux
+#endif
+#else
+    return -1;
+#endif
+}
+
+bool CBenchmarkRunner::writeReport(const QString &fileName)
+{
+    CPerformance *performance = CPerformance::getInstance();
+    CTerrainDataCounters counters = performance->getTerrainDataCounters();
+    CMetricStats fullDetail = performance->getConvergenceStats();
+    CIoCounters io;
+    QVector<qint64> sortedTimes = updateTimes;
+    QFile file;
+    qint64 totalTime = 0;
+    double updatingSeconds, hitRate;
+    int i;
+
+    qSort(sortedTimes.begin(), sortedTimes.end());
+    for (i=0; i<sortedTimes.size(); i++)
+        totalTime += sortedTimes.at(i);
+    updatingSeconds = totalTime/1000000000.0;
+    hitRate = counters.cacheFinds>0 ? (double)counters.cacheHits/(double)counters.cacheFinds : 0.0;
+
+    // no file name - report goes to standard output
+    if (fileName.isEmpty()) {
+        if (!file.open(stdout, QIODevice::WriteOnly | QIODevice::Text))
+            return false;
+    } else {
+        file.setFileName(fileName);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            qWarning("Benchmark - could not write report %s", qPrintable(fileName));
+            return false;
+        }
+    }
+
+    QTextStream out(&file);
+    out << "{" << endl;
+    if (cameraPath.getTicks()>0) {
+        out << "  \"cameraPathTicks\": " << cameraPath.getTicks() << "," << endl;
+    } else {
+        out << "  \"waypoints\": " << flightLon.size() << "," << endl;
+        out << "  \"stepsPerSegment\": " << BENCHMARK_STEPS_PER_SEGMENT << "," << endl;
+    }
+    out << "  \"treeUpdatingBudgetMs\": " << dss.treeUpdatingBudget << "," << endl;
+    out << "  \"useCache\": " << (dss.dontUseCache ? "false" : "true") << "," << endl;
+    out << "  \"flightTimeMs\": " << flightTime << "," << endl;
+    out << "  \"treeUpdates\": {" << endl;
+    out << "    \"count\": " << sortedTimes.size() << "," << endl;
+    out << "    \"changed\": " << treeUpdatesChanged << "," << endl;
+    out << "    \"totalMs\": " << QString::number(totalTime/1000000.0, 'f', 3) << "," << endl;
+    out << "    \"meanMs\": " << QString::number(sortedTimes.isEmpty() ? 0.0 : totalTime/1000000.0/sortedTimes.size(), 'f', 3) << "," << endl;
+    out << "    \"p50Ms\": " << QString::number(getPercentile(sortedTimes, 50.0)/1000000.0, 'f', 3) << "," << endl;
+    out << "    \"p90Ms\": " << QString::number(getPercentile(sortedTimes, 90.0)/1000000.0, 'f', 3) << "," << endl;
+    out << "    \"p99Ms\": " << QString::number(getPercentile(sortedTimes, 99.0)/1000000.0, 'f', 3) << "," << endl;
+    out << "    \"maxMs\": " << QString::number(getPercentile(sortedTimes, 100.0)/1000000.0, 'f', 3) << endl;
+    out << "  }," << endl;
+    out << "  \"timeToFullDetail\": {" << endl;
+    out << "    \"count\": " << fullDetail.count << "," << endl;
+    out << "    \"meanMs\": " << QString::number(fullDetail.meanMs, 'f', 3) << "," << endl;
+    out << "    \"p50Ms\": " << QString::number(fullDetail.p50Ms, 'f', 3) << "," << endl;
+    out << "    \"p95Ms\": " << QString::number(fullDetail.p95Ms, 'f', 3) << "," << endl;
+    out << "    \"p99Ms\": " << QString::number(fullDetail.p99Ms, 'f', 3) << "," << endl;
+    out << "    \"maxMs\": " << QString::number(fullDetail.maxMs, 'f', 3) << endl;
+    out << "  }," << endl;
+    out << "  \"io\": {" << endl;
+    for (i=0; i<IO_SOURCES; i++) {
+        io = cacheManager->ioStats->getCounters(i);
+        out << "    \"" << CIoStats::getSourceName(i) << "\": {" << endl;
+        out << "      \"opens\": " << io.opens << "," << endl;
+        out << "      \"seeks\": " << io.seeks << "," << endl;
+        out << "      \"reads\": " << io.reads << "," << endl;
+        out << "      \"bytesRead\": " << io.bytesRead << "," << endl;
+        out << "      \"timeMs\": " << QString::number(io.timeNs/1000000.0, 'f', 3) << "," << endl;
+        out << "      \"terrains\": " << io.tiles << "," << endl;
+        out << "      \"bytesPerTerrain\": " << QString::number(io.tiles>0 ? (double)io.bytesRead/io.tiles : 0.0, 'f', 1) << endl;
+        out << "    }" << (i<IO_SOURCES-1 ? "," : "") << endl;
+    }
+    out << "  }," << endl;
+    out << "  \"terrains\": {" << endl;
+    out << "    \"built\": " << counters.built << "," << endl;
+    out << "    \"loadedFromDiskCache\": " << counters.loadedFromDisk << "," << endl;
+    out << "    \"builtPerSecond\": " << QString::number(updatingSeconds>0.0 ? counters.built/updatingSeconds : 0.0, 'f', 1) << "," << endl;
+    out << "    \"loadedPerSecond\": " << QString::number(updatingSeconds>0.0 ? counters.loadedFromDisk/updatingSeconds : 0.0, 'f', 1) << "," << endl;
+    out << "    \"cacheFinds\": " << counters.cacheFinds << "," << endl;
+    out << "    \"cacheHits\": " << counters.cacheHits << "," << endl;
+    out << "    \"cacheHitRate\": " << QString::number(hitRate, 'f', 4) << "," << endl;
+    out << "    \"inTree\": " << terrainsInTree << "," << endl;
+    out << "    \"maxLOD\": " << maxLOD << endl;
+    out << "  }," << endl;
+    out << "  \"peakMemoryKB\": " << getPeakMemoryKB() << endl;
+    out << "}" << endl;
+
+    return true;
+}
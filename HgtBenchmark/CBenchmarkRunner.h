@@ -0,0 +1,99 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CBENCHMARKRUNNER_H
+#define CBENCHMARKRUNNER_H
+
+#include <QString>
+#include <QList>
+#include <QVector>
+#include "CEarth.h"
+#include "CCacheManager.h"
+#include "CDrawingStateSnapshot.h"
+#include "CCameraPath.h"
+
+#define BENCHMARK_STEPS_PER_SEGMENT      100      // camera positions between two waypoints
+#define BENCHMARK_MAX_SETTLE_UPDATES    1000      // tree updates at waypoint while tree still changes
+#define BENCHMARK_CAMERA_HEIGHT       3000.0      // default flight - camera above benchmark locations
+#define BENCHMARK_LOD_MULTIPLIER        1.74      // same as CDrawingState default
+#define BENCHMARK_TREE_UPDATING_BUDGET    40      // same as CDrawingState default
+
+// flies camera between waypoints (or replays recorded camera path) and updates terrain tree like CTerrainLoaderThread but without window and GL context
+class CBenchmarkRunner
+{
+public:
+    CBenchmarkRunner(CCacheManager *cacheManagerPointer);
+    ~CBenchmarkRunner();
+
+    void setDefaultFlight();
+    bool loadFlight(const QString &fileName);
+    bool loadCameraPath(const QString &fileName);
+    void setTreeUpdatingBudget(int budgetMs);
+    void setDontUseCache(bool dontUseCache);
+    void run();
+    bool writeReport(const QString &fileName);
+
+private:
+    CCacheManager *cacheManager;
+    CEarth *earth;                          // earth updated in this thread
+    CEarth *earthExchanged;                 // earth that would be drawn - buffers are exchanged like in OpenGL thread
+    CDrawingStateSnapshot dss;
+    QList<double> flightLon;
+    QList<double> flightLat;
+    QList<double> flightAlt;               // camera altitude above sea level in meters
+    CCameraPath cameraPath;                // recorded in GUI - used instead of waypoints when loaded
+    QVector<qint64> updateTimes;           // each tree update in ns
+    int treeUpdatesChanged;
+    qint64 flightTime;                     // whole flight in ms
+    int terrainsInTree;
+    int maxLOD;
+
+    void flyWaypoints();
+    void replayCameraPath();
+    void setCamera(double lon, double lat, double alt);
+    bool updateTree();
+    void settleTree();
+    static qint64 getPercentile(const QVector<qint64> &sortedTimes, double percent);
+    static qint64 getPeakMemoryKB();
+};
+
+#endif // CBENCHMARKRUNNER_H
@@ -0,0 +1,80 @@
+#-------------------------------------------------
+#
+# Headless benchmark of terrain tree updating -
+# flies camera between waypoints without window
+# and GL context and writes JSON report
+#
+#-------------------------------------------------
+
+QT       += core gui opengl
+
+TARGET = HgtBenchmark
+CONFIG   += console
+CONFIG   -= app_bundle
+TEMPLATE = app
+
+INCLUDEPATH += ../HgtReader
+
+win32:LIBS += -lpsapi
+
+SOURCES += main.cpp \
+    CBenchmarkRunner.cpp \
+    ../HgtReader/CTerrain.cpp \
+    ../HgtReader/CPerformance.cpp \
+    ../HgtReader/CHgtFile.cpp \
+    ../HgtReader/CEarth.cpp \
+    ../HgtReader/CCommons.cpp \
+    ../HgtReader/CCacheManager.cpp \
+    ../HgtReader/CAvability.cpp \
+    ../HgtReader/CDrawingStateSnapshot.cpp \
+    ../HgtReader/CTerrainData.cpp \
+    ../HgtReader/CCachedTerrainDataGroup.cpp \
+    ../HgtReader/CCachedTerrainData.cpp \
+    ../HgtReader/CRawFile.cpp \
+    ../HgtReader/CTerrainUpdateTask.cpp \
+    ../HgtReader/CCompactTerrainData.cpp \
+    ../HgtReader/CTileDiskCache.cpp \
+    ../HgtReader/CTerrainContainer.cpp \
+    ../HgtReader/CIndexedFile.cpp \
+    ../HgtReader/CHeightRangeTable.cpp \
+    ../HgtReader/CElevationCodec.cpp \
+    ../HgtReader/CRawTiledFile.cpp \
+    ../HgtReader/CBc1Codec.cpp \
+    ../HgtReader/CTextureTiles.cpp \
+    ../HgtReader/CCameraPath.cpp \
+    ../HgtReader/CCacheTrace.cpp \
+    ../HgtReader/CTraceZone.cpp \
+    ../HgtReader/CMetricRing.cpp \
+    ../HgtReader/CIoStats.cpp
+
+HEADERS += CBenchmarkRunner.h \
+    ../HgtReader/CTerrain.h \
+    ../HgtReader/CPerformance.h \
+    ../HgtReader/CHgtFile.h \
+    ../HgtReader/CEarth.h \
+    ../HgtReader/CCommons.h \
+    ../HgtReader/CCacheManager.h \
+    ../HgtReader/CAvability.h \
+    ../HgtReader/CDrawingStateSnapshot.h \
+    ../HgtReader/CTerrainData.h \
+    ../HgtReader/CCachedTerrainDataGroup.h \
+    ../HgtReader/CCachedTerrainData.h \
+    ../HgtReader/CRawFile.h \
+    ../HgtReader/CTerrainUpdateTask.h \
+    ../HgtReader/CCompactTerrainData.h \
+    ../HgtReader/CTileDiskCache.h \
+    ../HgtReader/CTerrainContainer.h \
+    ../HgtReader/CIndexedFile.h \
+    ../HgtReader/CHeightRangeTable.h \
+    ../HgtReader/CElevationCodec.h \
+    ../HgtReader/CRawTiledFile.h \
+    ../HgtReader/CBc1Codec.h \
+    ../HgtReader/CTextureTiles.h \
+    ../HgtReader/CCameraPath.h \
+    ../HgtReader/CCacheTrace.h \
+    ../HgtReader/CTraceZone.h \
+    ../HgtReader/CMetricRing.h \
+    ../HgtReader/CSeqRing.h \
+    ../HgtReader/CIoStats.h \
+    ../HgtReader/CIoCounters.h \
+    ../HgtReader/CTileFileName.h
@@ -0,0 +1,133 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <QDir>
+#include <QDebug>
+#include "CCacheManager.h"
+#include "CPerformance.h"
+#include "CBenchmarkRunner.h"
+#include "CTraceZone.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QStringList args = a.arguments();
+    CCacheManager *cacheManager;
+    CPerformance *performance;
+    CBenchmarkRunner *runner;
+    QString flightFileName, reportFileName, traceFileName, zonesFileName;
+    bool noCache, noBudget, reportWritten;
+    int i;
+
+    // -nocache builds every terrain from HGT and RAW files, -nobudget lets each tree update finish in one go
+    noCache = args.contains("-nocache");
+    noBudget = args.contains("-nobudget");
+    args.removeAll("-nocache");
+    args.removeAll("-nobudget");
+
+    // -cachetrace <file> logs cache operations for HgtCacheReplay
+    i = args.indexOf("-cachetrace");
+    if (i>0 && i+1<args.size()) {
+        traceFileName = QDir::current().absoluteFilePath(args.at(i+1));
+        args.removeAt(i+1);
+        args.removeAt(i);
+    }
+
+    // -trace <file> writes timing zones of last events as Chrome trace JSON
+    i = args.indexOf("-trace");
+    if (i>0 && i+1<args.size()) {
+        zonesFileName = QDir::current().absoluteFilePath(args.at(i+1));
+        args.removeAt(i+1);
+        args.removeAt(i);
+    }
+
+    if (args.size()<2) {
+        qDebug("usage: HgtBenchmark [-nocache] [-nobudget] [-cachetrace <file>] [-trace <file>] <data dir> [flight file|camera path .hcp|-] [JSON report file]");
+        return 1;
+    }
+
+    // files given by user are relative to directory where benchmark was started
+    if (args.size()>2 && args.at(2)!="-")
+        flightFileName = QDir::current().absoluteFilePath(args.at(2));
+    if (args.size()>3)
+        reportFileName = QDir::current().absoluteFilePath(args.at(3));
+
+    // cache manager finds HGT, RAW and cache files relative to current directory
+    if (!QDir::setCurrent(args.at(1))) {
+        qWarning("Benchmark - data directory %s not found", qPrintable(args.at(1)));
+        return 1;
+    }
+
+    cacheManager = new CCacheManager;
+    performance = new CPerformance;
+    runner = new CBenchmarkRunner(cacheManager);
+
+    // camera path recorded in HgtReader (F9) or text file with waypoints
+    if (!flightFileName.isEmpty()) {
+        if (flightFileName.endsWith(".hcp") ? !runner->loadCameraPath(flightFileName) : !runner->loadFlight(flightFileName)) {
+            delete runner;
+            delete performance;
+            delete cacheManager;
+            return 1;
+        }
+    }
+    runner->setDontUseCache(noCache);
+    if (noBudget) runner->setTreeUpdatingBudget(0);
+
+    if (!traceFileName.isEmpty())
+        cacheManager->cacheTrace->start(traceFileName);
+    if (!zonesFileName.isEmpty())
+        CTraceZone::setEnabled(true);
+    runner->run();
+    cacheManager->cacheTrace->stop();
+    if (!zonesFileName.isEmpty())
+        CTraceZone::writeChromeTrace(zonesFileName);
+    reportWritten = runner->writeReport(reportFileName);
+
+    delete runner;
+    delete performance;
+    delete cacheManager;
+
+    return reportWritten ? 0 : 1;
+}
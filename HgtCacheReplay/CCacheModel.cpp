@@ -0,0 +1,291 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QElapsedTimer>
+#include <QtAlgorithms>
+#include "CCacheModel.h"
+
+CCacheModelEntry::CCacheModelEntry()
+{
+    topLeftLon = 0.0;
+    topLeftLat = 0.0;
+    lod = 0;
+    inUseA = false;
+    inUseB = false;
+    compact = false;
+    empty = false;
+    time = 0;
+}
+
+CCacheModelStats::CCacheModelStats()
+{
+    finds = 0;
+    hits = 0;
+    compactHits = 0;
+    misses = 0;
+    divergentFinds = 0;
+    registers = 0;
+    frees = 0;
+    zombieFrees = 0;
+    keepSizes = 0;
+    compactions = 0;
+    evictions = 0;
+    peakEntries = 0;
+    scannedEntries = 0;
+    replayNs = 0;
+}
+
+CCacheModel::CCacheModel(int evictionPolicy, int maxUnused, int maxCompact)
+{
+    policy = evictionPolicy;
+    maxUnusedCount = maxUnused;
+    maxCompactCount = maxCompact;
+    entryCount = 0;
+}
+
+CCacheModel::~CCacheModel()
+{
+}
+
+QString CCacheModel::getPolicyName() const
+{
+    switch (policy) {
+        case CACHE_MODEL_POLICY_WINDOW: return "window";
+        case CACHE_MODEL_POLICY_LRU:    return "lru";
+        case CACHE_MODEL_POLICY_NONE:   return "none";
+    }
+    return "unknown";
+}
+
+void CCacheModel::replay(const QVector<CCacheTraceRecord> &records)
+{
+    QElapsedTimer timer;
+    int i;
+
+    timer.start();
+    for (i=0; i<records.size(); i++) {
+        switch (records.at(i).operation) {
+            case CACHE_TRACE_FIND:      find(records.at(i));
+                                        break;
+            case CACHE_TRACE_REGISTER:  registerTerrain(records.at(i));
+                                        break;
+            case CACHE_TRACE_FREE:      freeTerrain(records.at(i));
+                                        break;
+            case CACHE_TRACE_KEEP_SIZE: keepSize();
+                                        break;
+        }
+    }
+    stats.replayNs = timer.nsecsElapsed();
+}
+
+void CCacheModel::find(const CCacheTraceRecord &r)
+{
+    CCacheModelEntry *entry;
+    bool found;
+
+    stats.finds++;
+    entry = findEntry(r.topLeftLon, r.topLeftLat, r.lod);
+    found = (entry!=0);
+
+    if (found) {
+        stats.hits++;
+        if (entry->compact) {
+            stats.compactHits++;
+            entry->compact = false;
+        }
+    } else {
+        // terrain is built and registered after miss - trace has register only when recorded find missed too
+        stats.misses++;
+        entry = addEntry(r.topLeftLon, r.topLeftLat, r.lod);
+        entryCount++;
+        if (entryCount>stats.peakEntries)
+            stats.peakEntries = entryCount;
+    }
+
+    if (found != (r.found!=0))
+        stats.divergentFinds++;
+
+    setInUse(entry, r.earth, true);
+    entry->time = r.time;
+}
+
+void CCacheModel::registerTerrain(const CCacheTraceRecord &r)
+{
+    CCacheModelEntry *entry;
+
+    stats.registers++;
+    entry = findEntry(r.topLeftLon, r.topLeftLat, r.lod);
+    if (entry==0) {
+        entry = addEntry(r.topLeftLon, r.topLeftLat, r.lod);
+        entryCount++;
+        if (entryCount>stats.peakEntries)
+            stats.peakEntries = entryCount;
+    }
+
+    // new terrain data replaces compact copy
+    entry->compact = false;
+    setInUse(entry, r.earth, true);
+    entry->time = r.time;
+}
+
+void CCacheModel::freeTerrain(const CCacheTraceRecord &r)
+{
+    CCacheModelEntry *entry;
+
+    stats.frees++;
+    entry = findEntry(r.topLeftLon, r.topLeftLat, r.lod);
+    if (entry==0) {
+        stats.zombieFrees++;
+        return;
+    }
+
+    setInUse(entry, r.earth, false);
+    entry->time = r.time;
+}
+
+void CCacheModel::keepSize()
+{
+    QVector<CCacheModelEntry *> entries;
+
+    stats.keepSizes++;
+    if (policy==CACHE_MODEL_POLICY_NONE)
+        return;
+
+    getEntries(&entries);
+    if (policy==CACHE_MODEL_POLICY_WINDOW)
+        keepSizeWindow(entries); else
+        keepSizeLru(entries);
+}
+
+void CCacheModel::keepSizeWindow(QVector<CCacheModelEntry *> &entries)
+{
+    CCacheModelEntry *e;
+    quint32 minNotInUseTime = 25*3600*1000;
+    quint32 minCompactTime = 25*3600*1000;
+    int notInUseCount = 0;
+    int compactCount = 0;
+    int i;
+
+    // the same counters as CCacheManager::cacheInfo - computed once before both tiers
+    for (i=0; i<entries.size(); i++) {
+        e = entries.at(i);
+        if (e->compact) {
+            compactCount++;
+            if (e->time<minCompactTime) minCompactTime = e->time;
+        }
+        if (!e->inUseA && !e->inUseB && !e->compact) {
+            notInUseCount++;
+            if (e->time<minNotInUseTime) minNotInUseTime = e->time;
+        }
+    }
+
+    // hot tier - the oldest terrain data not in use is packed to compact form
+    if (notInUseCount>maxUnusedCount) {
+        for (i=0; i<entries.size(); i++) {
+            e = entries.at(i);
+            if (!e->inUseA && !e->inUseB && !e->compact && e->time<minNotInUseTime + CACHE_MODEL_WINDOW_MS) {
+                e->compact = true;
+                stats.compactions++;
+            }
+        }
+    }
+
+    // cold tier - the oldest entries not in use are dropped (also terrain data compacted above)
+    if (compactCount>maxCompactCount) {
+        for (i=0; i<entries.size(); i++) {
+            e = entries.at(i);
+            if (!e->inUseA && !e->inUseB && e->time<minCompactTime + CACHE_MODEL_WINDOW_MS)
+                evict(e);
+        }
+    }
+}
+
+void CCacheModel::keepSizeLru(QVector<CCacheModelEntry *> &entries)
+{
+    QVector<CCacheModelEntry *> notInUse;
+    QVector<CCacheModelEntry *> compacted;
+    int i;
+
+    for (i=0; i<entries.size(); i++) {
+        if (entries.at(i)->inUseA || entries.at(i)->inUseB)
+            continue;
+        if (entries.at(i)->compact)
+            compacted.append(entries.at(i)); else
+            notInUse.append(entries.at(i));
+    }
+
+    // hot tier - least recently used terrain data over limit is packed
+    if (notInUse.size()>maxUnusedCount) {
+        qSort(notInUse.begin(), notInUse.end(), isOlder);
+        for (i=0; i<notInUse.size()-maxUnusedCount; i++) {
+            notInUse.at(i)->compact = true;
+            compacted.append(notInUse.at(i));
+            stats.compactions++;
+        }
+    }
+
+    // cold tier - least recently used compact terrain data over limit is dropped
+    if (compacted.size()>maxCompactCount) {
+        qSort(compacted.begin(), compacted.end(), isOlder);
+        for (i=0; i<compacted.size()-maxCompactCount; i++)
+            evict(compacted.at(i));
+    }
+}
+
+void CCacheModel::setInUse(CCacheModelEntry *entry, int earth, bool inUse)
+{
+    if (earth==CACHE_TRACE_EARTH_A)
+        entry->inUseA = inUse; else
+        entry->inUseB = inUse;
+}
+
+void CCacheModel::evict(CCacheModelEntry *entry)
+{
+    stats.evictions++;
+    entryCount--;
+    removeEntry(entry);
+}
+
+bool CCacheModel::isOlder(const CCacheModelEntry *a, const CCacheModelEntry *b)
+{
+    return a->time < b->time;
+}
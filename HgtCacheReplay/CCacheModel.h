@@ -0,0 +1,129 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CCACHEMODEL_H
+#define CCACHEMODEL_H
+
+#include <QString>
+#include <QVector>
+#include "CCacheTrace.h"
+
+#define CACHE_MODEL_POLICY_WINDOW      0      // CCacheManager::cacheKeepSize - entries older than oldest + 5 s
+#define CACHE_MODEL_POLICY_LRU         1      // exact least recently used order until tier is under limit
+#define CACHE_MODEL_POLICY_NONE        2      // nothing is evicted - upper bound of hit rate
+#define CACHE_MODEL_WINDOW_MS       5000      // the same window as CCacheManager::cacheKeepSize
+
+// cached terrain without terrain data - only state which decides about hits and evictions
+class CCacheModelEntry
+{
+public:
+    CCacheModelEntry();
+
+    double topLeftLon;
+    double topLeftLat;
+    int lod;
+    bool inUseA;
+    bool inUseB;
+    bool compact;                       // terrain data packed to compact form (cold tier)
+    bool empty;                         // evicted entry left in list like in CCachedTerrainDataGroup
+    quint32 time;
+};
+
+class CCacheModelStats
+{
+public:
+    CCacheModelStats();
+
+    int finds;
+    int hits;
+    int compactHits;                    // compact terrain data expanded again
+    int misses;                         // terrain must be built from HGT and RAW files
+    int divergentFinds;                 // result differs from the one recorded in trace
+    int registers;
+    int frees;
+    int zombieFrees;                    // free of terrain which is not in cache
+    int keepSizes;
+    int compactions;
+    int evictions;
+    int peakEntries;
+    qint64 scannedEntries;              // entries compared during find/register/free
+    qint64 replayNs;
+};
+
+// replays cache trace - subclasses provide index of entries, eviction policy is common
+class CCacheModel
+{
+public:
+    CCacheModel(int evictionPolicy, int maxUnused, int maxCompact);
+    virtual ~CCacheModel();
+
+    virtual QString getName() const = 0;
+    QString getPolicyName() const;
+    void replay(const QVector<CCacheTraceRecord> &records);
+    const CCacheModelStats &getStats() const { return stats; }
+
+protected:
+    CCacheModelStats stats;
+    int entryCount;                     // entries which are not empty
+
+    virtual CCacheModelEntry *findEntry(double topLeftLon, double topLeftLat, int lod) = 0;
+    virtual CCacheModelEntry *addEntry(double topLeftLon, double topLeftLat, int lod) = 0;
+    virtual void removeEntry(CCacheModelEntry *entry) = 0;
+    virtual void getEntries(QVector<CCacheModelEntry *> *entries) = 0;
+
+private:
+    int policy;
+    int maxUnusedCount;
+    int maxCompactCount;
+
+    void find(const CCacheTraceRecord &r);
+    void registerTerrain(const CCacheTraceRecord &r);
+    void freeTerrain(const CCacheTraceRecord &r);
+    void keepSize();
+    void keepSizeWindow(QVector<CCacheModelEntry *> &entries);
+    void keepSizeLru(QVector<CCacheModelEntry *> &entries);
+    void setInUse(CCacheModelEntry *entry, int earth, bool inUse);
+    void evict(CCacheModelEntry *entry);
+    static bool isOlder(const CCacheModelEntry *a, const CCacheModelEntry *b);
+};
+
+#endif // CCACHEMODEL_H
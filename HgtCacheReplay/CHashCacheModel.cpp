@@ -0,0 +1,113 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <string.h>
+#include "CHashCacheModel.h"
+
+uint qHash(const CCacheModelKey &key)
+{
+    double lon = key.topLeftLon;
+    double lat = key.topLeftLat;
+    quint64 lonBits, latBits;
+
+    // -0.0 and 0.0 are equal keys
+    if (lon==0.0) lon = 0.0;
+    if (lat==0.0) lat = 0.0;
+    memcpy(&lonBits, &lon, sizeof(lonBits));
+    memcpy(&latBits, &lat, sizeof(latBits));
+
+    return qHash(lonBits) ^ (qHash(latBits)*31) ^ (uint)key.lod;
+}
+
+CHashCacheModel::CHashCacheModel(int evictionPolicy, int maxUnused, int maxCompact) :
+    CCacheModel(evictionPolicy, maxUnused, maxCompact)
+{
+}
+
+CHashCacheModel::~CHashCacheModel()
+{
+    qDeleteAll(index);
+}
+
+CCacheModelKey CHashCacheModel::getKey(double topLeftLon, double topLeftLat, int lod)
+{
+    CCacheModelKey key;
+
+    key.topLeftLon = topLeftLon;
+    key.topLeftLat = topLeftLat;
+    key.lod = lod;
+
+    return key;
+}
+
+CCacheModelEntry *CHashCacheModel::findEntry(double topLeftLon, double topLeftLat, int lod)
+{
+    stats.scannedEntries++;
+    return index.value(getKey(topLeftLon, topLeftLat, lod), 0);
+}
+
+CCacheModelEntry *CHashCacheModel::addEntry(double topLeftLon, double topLeftLat, int lod)
+{
+    CCacheModelEntry *e = new CCacheModelEntry;
+
+    e->topLeftLon = topLeftLon;
+    e->topLeftLat = topLeftLat;
+    e->lod = lod;
+    index.insert(getKey(topLeftLon, topLeftLat, lod), e);
+
+    return e;
+}
+
+void CHashCacheModel::removeEntry(CCacheModelEntry *entry)
+{
+    index.remove(getKey(entry->topLeftLon, entry->topLeftLat, entry->lod));
+    delete entry;
+}
+
+void CHashCacheModel::getEntries(QVector<CCacheModelEntry *> *entries)
+{
+    QHash<CCacheModelKey, CCacheModelEntry *>::const_iterator i;
+
+    entries->reserve(index.size());
+    for (i=index.constBegin(); i!=index.constEnd(); i++)
+        entries->append(i.value());
+}
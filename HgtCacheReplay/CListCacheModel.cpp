@@ -0,0 +1,134 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <math.h>
+#include "CListCacheModel.h"
+
+CListCacheModel::CListCacheModel(int evictionPolicy, int maxUnused, int maxCompact) :
+    CCacheModel(evictionPolicy, maxUnused, maxCompact)
+{
+    int i;
+
+    // HGT file sizes of L00-L03, L04-L08 and L09-L13
+    groupDegreeSize[0] = 60.0;
+    groupDegreeSize[1] = 15.0;
+    groupDegreeSize[2] = 3.75;
+
+    for (i=0; i<LIST_MODEL_SOURCES; i++) {
+        groupWidth[i] = (int)(360.0 / groupDegreeSize[i]);
+        groups[i].resize(groupWidth[i] * (int)(180.0 / groupDegreeSize[i]));
+    }
+}
+
+CListCacheModel::~CListCacheModel()
+{
+    int i, j;
+
+    for (i=0; i<LIST_MODEL_SOURCES; i++)
+        for (j=0; j<groups[i].size(); j++)
+            qDeleteAll(groups[i][j]);
+}
+
+QList<CCacheModelEntry *> *CListCacheModel::getGroup(double topLeftLon, double topLeftLat, int lod)
+{
+    int source, x, y, height;
+
+    source = (lod<=3) ? 0 : ((lod<=8) ? 1 : 2);
+    height = groups[source].size() / groupWidth[source];
+
+    // top left corner lies on grid - small epsilon keeps it in its own group
+    x = (int)floor((topLeftLon + 180.0) / groupDegreeSize[source] + 1.0e-9);
+    y = (int)floor((90.0 - topLeftLat) / groupDegreeSize[source] + 1.0e-9);
+    x = ((x % groupWidth[source]) + groupWidth[source]) % groupWidth[source];
+    if (y<0) y = 0;
+    if (y>=height) y = height-1;
+
+    return &groups[source][y*groupWidth[source] + x];
+}
+
+CCacheModelEntry *CListCacheModel::findEntry(double topLeftLon, double topLeftLat, int lod)
+{
+    QList<CCacheModelEntry *> *group = getGroup(topLeftLon, topLeftLat, lod);
+    CCacheModelEntry *e;
+    int i;
+
+    for (i=0; i<group->size(); i++) {
+        e = group->at(i);
+        stats.scannedEntries++;
+        if (e->empty)
+            continue;
+        if (e->topLeftLon==topLeftLon && e->topLeftLat==topLeftLat && e->lod==lod)
+            return e;
+    }
+
+    return 0;
+}
+
+CCacheModelEntry *CListCacheModel::addEntry(double topLeftLon, double topLeftLat, int lod)
+{
+    CCacheModelEntry *e = new CCacheModelEntry;
+
+    e->topLeftLon = topLeftLon;
+    e->topLeftLat = topLeftLat;
+    e->lod = lod;
+    getGroup(topLeftLon, topLeftLat, lod)->append(e);
+
+    return e;
+}
+
+void CListCacheModel::removeEntry(CCacheModelEntry *entry)
+{
+    // entry is not erased from list - the same as CCachedTerrainDataGroup::deleteNotInUse
+    entry->empty = true;
+    entry->compact = false;
+}
+
+void CListCacheModel::getEntries(QVector<CCacheModelEntry *> *entries)
+{
+    int i, j, k;
+
+    for (i=0; i<LIST_MODEL_SOURCES; i++)
+        for (j=0; j<groups[i].size(); j++)
+            for (k=0; k<groups[i].at(j).size(); k++)
+                if (!groups[i].at(j).at(k)->empty)
+                    entries->append(groups[i].at(j).at(k));
+}
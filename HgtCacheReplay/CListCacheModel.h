@@ -0,0 +1,75 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CLISTCACHEMODEL_H
+#define CLISTCACHEMODEL_H
+
+#include <QList>
+#include <QVector>
+#include "CCacheModel.h"
+
+#define LIST_MODEL_SOURCES              3      // L00-L03, L04-L08, L09-L13 like CCacheManager
+
+// the same index as CCacheManager - list of entries for each HGT file area, searched linearly, evicted entries stay empty
+class CListCacheModel : public CCacheModel
+{
+public:
+    CListCacheModel(int evictionPolicy, int maxUnused, int maxCompact);
+    ~CListCacheModel();
+
+    QString getName() const { return "list"; }
+
+protected:
+    CCacheModelEntry *findEntry(double topLeftLon, double topLeftLat, int lod);
+    CCacheModelEntry *addEntry(double topLeftLon, double topLeftLat, int lod);
+    void removeEntry(CCacheModelEntry *entry);
+    void getEntries(QVector<CCacheModelEntry *> *entries);
+
+private:
+    QVector< QList<CCacheModelEntry *> > groups[LIST_MODEL_SOURCES];
+    int groupWidth[LIST_MODEL_SOURCES];
+    double groupDegreeSize[LIST_MODEL_SOURCES];
+
+    QList<CCacheModelEntry *> *getGroup(double topLeftLon, double topLeftLat, int lod);
+};
+
+#endif // CLISTCACHEMODEL_H
@@ -0,0 +1,28 @@
+#-------------------------------------------------
+#
+# Offline replay of cache trace recorded by HgtReader
+# (F11) or HgtBenchmark (-cachetrace) - compares
+# cache indexes and eviction policies
+#
+#-------------------------------------------------
+
+QT       += core
+QT       -= gui
+
+TARGET = HgtCacheReplay
+CONFIG   += console
+CONFIG   -= app_bundle
+TEMPLATE = app
+
+INCLUDEPATH += ../HgtReader
+
+SOURCES += main.cpp \
+    CCacheModel.cpp \
+    CListCacheModel.cpp \
+    CHashCacheModel.cpp \
+    ../HgtReader/CCacheTrace.cpp
+
+HEADERS += CCacheModel.h \
+    CListCacheModel.h \
+    CHashCacheModel.h \
+    ../HgtReader/CCacheTrace.h
@@ -0,0 +1,156 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+#include "CCacheTrace.h"
+#include "CListCacheModel.h"
+#include "CHashCacheModel.h"
+
+#define REPLAY_MAX_UNUSED_TERRAIN_DATA    5000      // CACHE_MAX_UNUSED_TERRAIN_DATA
+#define REPLAY_MAX_COMPACT_TERRAIN_DATA 500000      // CACHE_MAX_COMPACT_TERRAIN_DATA
+
+static bool writeReport(const QString &fileName, const QString &traceFileName, const QVector<CCacheTraceRecord> &records,
+                        int recordedHits, int recordedFinds, const QList<CCacheModel *> &models)
+{
+    QFile file;
+    int i;
+
+    // no file name - report goes to standard output
+    if (fileName.isEmpty()) {
+        if (!file.open(stdout, QIODevice::WriteOnly | QIODevice::Text))
+            return false;
+    } else {
+        file.setFileName(fileName);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            qWarning("Cache replay - could not write report %s", qPrintable(fileName));
+            return false;
+        }
+    }
+
+    QTextStream out(&file);
+    out << "{" << endl;
+    out << "  \"trace\": \"" << traceFileName << "\"," << endl;
+    out << "  \"records\": " << records.size() << "," << endl;
+    out << "  \"traceMs\": " << (records.isEmpty() ? 0 : records.last().time) << "," << endl;
+    out << "  \"recordedHitRate\": " << QString::number(recordedFinds>0 ? (double)recordedHits/recordedFinds : 0.0, 'f', 4) << "," << endl;
+    out << "  \"models\": [" << endl;
+    for (i=0; i<models.size(); i++) {
+        const CCacheModelStats &s = models.at(i)->getStats();
+        out << "    { \"index\": \"" << models.at(i)->getName() << "\", ";
+        out << "\"policy\": \"" << models.at(i)->getPolicyName() << "\", ";
+        out << "\"finds\": " << s.finds << ", ";
+        out << "\"hitRate\": " << QString::number(s.finds>0 ? (double)s.hits/s.finds : 0.0, 'f', 4) << ", ";
+        out << "\"misses\": " << s.misses << ", ";
+        out << "\"compactHits\": " << s.compactHits << ", ";
+        out << "\"divergentFinds\": " << s.divergentFinds << ", ";
+        out << "\"zombieFrees\": " << s.zombieFrees << ", ";
+        out << "\"compactions\": " << s.compactions << ", ";
+        out << "\"evictions\": " << s.evictions << ", ";
+        out << "\"peakEntries\": " << s.peakEntries << ", ";
+        out << "\"scannedPerOp\": " << QString::number((double)s.scannedEntries/qMax(1, s.finds + s.registers + s.frees), 'f', 1) << ", ";
+        out << "\"nsPerOp\": " << QString::number((double)s.replayNs/qMax(1, records.size()), 'f', 1) << " }";
+        out << (i<models.size()-1 ? "," : "") << endl;
+    }
+    out << "  ]" << endl;
+    out << "}" << endl;
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QStringList args = a.arguments();
+    QVector<CCacheTraceRecord> records;
+    QList<CCacheModel *> models;
+    CCacheModel *model;
+    int maxUnused = REPLAY_MAX_UNUSED_TERRAIN_DATA;
+    int maxCompact = REPLAY_MAX_COMPACT_TERRAIN_DATA;
+    int recordedFinds = 0, recordedHits = 0;
+    int policy, i;
+    bool reportWritten;
+
+    if (args.size()<2) {
+        qDebug("usage: HgtCacheReplay <cache trace .hct> [max unused terrains] [max compact terrains] [JSON report file]");
+        return 1;
+    }
+    if (args.size()>2) maxUnused = args.at(2).toInt();
+    if (args.size()>3) maxCompact = args.at(3).toInt();
+
+    if (!CCacheTrace::load(args.at(1), &records))
+        return 1;
+
+    for (i=0; i<records.size(); i++) {
+        if (records.at(i).operation==CACHE_TRACE_FIND) {
+            recordedFinds++;
+            if (records.at(i).found) recordedHits++;
+        }
+    }
+    qDebug("%d records, %d finds, recorded hit rate %.4f, limits %d unused / %d compact",
+           records.size(), recordedFinds, recordedFinds>0 ? (double)recordedHits/recordedFinds : 0.0, maxUnused, maxCompact);
+
+    // hit rates depend only on policy - index changes cost
+    for (policy=CACHE_MODEL_POLICY_WINDOW; policy<=CACHE_MODEL_POLICY_NONE; policy++) {
+        for (i=0; i<2; i++) {
+            if (i==0)
+                model = new CListCacheModel(policy, maxUnused, maxCompact); else
+                model = new CHashCacheModel(policy, maxUnused, maxCompact);
+            model->replay(records);
+            models.append(model);
+
+            const CCacheModelStats &s = model->getStats();
+            qDebug("%-5s %-7s hit rate %.4f  misses %8d  compact hits %8d  evictions %8d  peak %8d  %10.1f ns/op",
+                   qPrintable(model->getName()), qPrintable(model->getPolicyName()),
+                   s.finds>0 ? (double)s.hits/s.finds : 0.0, s.misses, s.compactHits, s.evictions, s.peakEntries,
+                   (double)s.replayNs/qMax(1, records.size()));
+        }
+    }
+
+    reportWritten = writeReport(args.size()>4 ? args.at(4) : QString(), args.at(1), records, recordedHits, recordedFinds, models);
+    qDeleteAll(models);
+
+    return reportWritten ? 0 : 1;
+}
@@ -0,0 +1,204 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QFile>
+#include <QDir>
+#include <QByteArray>
+#include <QThreadPool>
+#include <QTime>
+#include <QDebug>
+#include <math.h>
+#include "CDatasetGenerator.h"
+#include "CGeneratorTask.h"
+#include "CHgtFile.h"
+#include "CTileFileName.h"
+
+CDatasetGenerator::CDatasetGenerator(const QString &outputPath, quint32 seed)
+{
+    fractalTerrain = new CFractalTerrain(seed);
+    pathOutput = outputPath;
+
+    // same directories and sizes as checked in CCacheManager::setupAvabilityTables
+    hgtDir[0] = "L00-L03/"; hgtSize[0] = 65;   hgtDegreeSize[0] = 60.00;
+    hgtDir[1] = "L04-L08/"; hgtSize[1] = 513;  hgtDegreeSize[1] = 15.00;
+    hgtDir[2] = "L09-L13/"; hgtSize[2] = 4097; hgtDegreeSize[2] = 3.75;
+
+    // and in CCacheManager::setupTextureAvalibityTables
+    texDir[0] = "Textures/L00_L02/"; texPxSize[0] = 96;
+    texDir[1] = "Textures/L03_L05/"; texPxSize[1] = 768;
+    texDir[2] = "Textures/L06_L08/"; texPxSize[2] = 6144;
+    texDir[3] = "Textures/L09_L10/"; texPxSize[3] = 24576;
+
+    setCoverage(0.0, 0.0, 0.0);
+    textureGroups = GENERATOR_TEX_GROUPS;
+    filesWritten = 0;
+    bytesWritten = 0;
+}
+
+CDatasetGenerator::~CDatasetGenerator()
+{
+    delete fractalTerrain;
+}
+
+void CDatasetGenerator::setCoverage(double lon, double lat, double degreeSize)
+{
+    coverageLonMin = lon - degreeSize/2.0;
+    coverageLonMax = lon + degreeSize/2.0;
+    coverageLatMin = qMax(lat - degreeSize/2.0, -90.0);
+    coverageLatMax = qMin(lat + degreeSize/2.0, 90.0);
+}
+
+void CDatasetGenerator::setTextureGroups(int groups)
+{
+    textureGroups = qBound(0, groups, GENERATOR_TEX_GROUPS);
+}
+
+bool CDatasetGenerator::generate()
+{
+    QTime time;
+    int i;
+
+    time.start();
+    filesWritten = 0;
+    bytesWritten = 0;
+
+    for (i=0; i<GENERATOR_HGT_GROUPS; i++)
+        if (!generateGroup(hgtDir[i], hgtDegreeSize[i], hgtSize[i], false))
+            return false;
+    for (i=0; i<textureGroups; i++)
+        if (!generateGroup(texDir[i], GENERATOR_TEX_DEGREE_SIZE, texPxSize[i], true))
+            return false;
+
+    qDebug("Dataset generated: %d files, %.1f MB in %.1f s", filesWritten, bytesWritten/1048576.0, time.elapsed()/1000.0);
+
+    return true;
+}
+
+bool CDatasetGenerator::generateGroup(const QString &dir, double degreeSize, int size, bool texture)
+{
+    int lonIndex, latIndex;
+    int lonIndexMin, lonIndexMax, latIndexMin, latIndexMax;
+    double tlLon, tlLat, step;
+
+    if (!QDir().mkpath(pathOutput + dir)) {
+        qWarning("Generator - can't create %s", qPrintable(pathOutput + dir));
+        return false;
+    }
+
+    // HGT samples include both edges of file, RAW pixels don't
+    step = texture ? degreeSize/size : degreeSize/(size - 1);
+
+    // every file touching coverage - coarse levels cover more than asked
+    lonIndexMin = (int)floor(coverageLonMin/degreeSize);
+    lonIndexMax = (int)ceil(coverageLonMax/degreeSize);
+    latIndexMin = qMax((int)floor((90.0 - coverageLatMax)/degreeSize), 0);
+    latIndexMax = qMin((int)ceil((90.0 - coverageLatMin)/degreeSize), (int)(180.0/degreeSize));
+    if (lonIndexMax - lonIndexMin > (int)(360.0/degreeSize))
+        lonIndexMax = lonIndexMin + (int)(360.0/degreeSize);
+
+    for (latIndex=latIndexMin; latIndex<latIndexMax; latIndex++)
+        for (lonIndex=lonIndexMin; lonIndex<lonIndexMax; lonIndex++) {
+            tlLon = lonIndex*degreeSize;
+            while (tlLon<0.0) tlLon += 360.0;
+            while (tlLon>=360.0) tlLon -= 360.0;
+            tlLat = 90.0 - latIndex*degreeSize;
+
+            if (!generateFile(pathOutput + dir + CTileFileName::getName(tlLon, tlLat, texture ? "raw" : "hgt"),
+                              tlLon, tlLat, step, size, texture))
+                return false;
+        }
+
+    return true;
+}
+
+bool CDatasetGenerator::generateFile(const QString &fileName, double tlLon, double tlLat, double step, int size, bool texture)
+{
+    QFile file(fileName + ".tmp");
+    QByteArray band;
+    QTime time;
+    int rowBytes = texture ? 3*size : 2*size;
+    int bandStart, bandRows, row;
+
+    time.start();
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning("Generator - can't create %s", qPrintable(file.fileName()));
+        return false;
+    }
+
+    // file is written band by band - L09_L10 texture would not fit in memory
+    band.resize(GENERATOR_BAND_ROWS*rowBytes);
+    for (bandStart=0; bandStart<size; bandStart+=GENERATOR_BAND_ROWS) {
+        bandRows = qMin(GENERATOR_BAND_ROWS, size - bandStart);
+        for (row=0; row<bandRows; row+=GENERATOR_TASK_ROWS)
+            QThreadPool::globalInstance()->start(new CGeneratorTask(fractalTerrain,
+                                                                    texture ? GENERATOR_TASK_COLORS : GENERATOR_TASK_HEIGHTS,
+                                                                    tlLon, tlLat, step, size,
+                                                                    bandStart + row, bandStart + qMin(row + GENERATOR_TASK_ROWS, bandRows),
+                                                                    band.data() + row*rowBytes));
+        QThreadPool::globalInstance()->waitForDone();
+
+        if (!texture)
+            CHgtFile::convertBigEndian((const quint16 *)band.constData(), (quint16 *)band.data(), bandRows*size);
+
+        if (file.write(band.constData(), (qint64)bandRows*rowBytes)!=(qint64)bandRows*rowBytes) {
+            qWarning("Generator - can't write %s", qPrintable(file.fileName()));
+            file.close();
+            file.remove();
+            return false;
+        }
+    }
+    file.close();
+
+    // half written file is never seen by viewer - size check would skip it anyway
+    QFile::remove(fileName);
+    if (!file.rename(fileName)) {
+        qWarning("Generator - can't rename %s", qPrintable(file.fileName()));
+        return false;
+    }
+
+    filesWritten++;
+    bytesWritten += (qint64)size*rowBytes;
+    qDebug("%s %.1f s", qPrintable(fileName), time.elapsed()/1000.0);
+
+    return true;
+}
+
@@ -0,0 +1,86 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CDATASETGENERATOR_H
+#define CDATASETGENERATOR_H
+
+#include <QString>
+#include "CFractalTerrain.h"
+
+#define GENERATOR_HGT_GROUPS           3        // L00-L03, L04-L08, L09-L13
+#define GENERATOR_TEX_GROUPS           4        // L00_L02, L03_L05, L06_L08, L09_L10
+#define GENERATOR_TEX_DEGREE_SIZE  45.00        // same as TEX_DEGREE_SIZE in CCacheManager
+#define GENERATOR_BAND_ROWS          256        // rows of file kept in memory
+#define GENERATOR_TASK_ROWS            8        // rows generated by one task
+
+// writes synthetic HGT levels and RAW textures with names and sizes expected by CCacheManager
+class CDatasetGenerator
+{
+public:
+    CDatasetGenerator(const QString &outputPath, quint32 seed);
+    ~CDatasetGenerator();
+
+    void setCoverage(double lon, double lat, double degreeSize);
+    void setTextureGroups(int groups);
+    bool generate();
+
+private:
+    CFractalTerrain *fractalTerrain;
+    QString pathOutput;
+    double coverageLonMin;
+    double coverageLonMax;
+    double coverageLatMin;
+    double coverageLatMax;
+    int textureGroups;
+    QString hgtDir[GENERATOR_HGT_GROUPS];
+    int hgtSize[GENERATOR_HGT_GROUPS];
+    double hgtDegreeSize[GENERATOR_HGT_GROUPS];
+    QString texDir[GENERATOR_TEX_GROUPS];
+    int texPxSize[GENERATOR_TEX_GROUPS];
+    int filesWritten;
+    qint64 bytesWritten;
+
+    bool generateGroup(const QString &dir, double degreeSize, int size, bool texture);
+    bool generateFile(const QString &fileName, double tlLon, double tlLat, double step, int size, bool texture);
+};
+
+#endif // CDATASETGENERATOR_H
@@ -0,0 +1,150 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <math.h>
+#include "CFractalTerrain.h"
+#include "CCommons.h"
+
+// hypsometric colors - height in meters, sea is darker with depth
+static const double paletteHeight[FRACTAL_PALETTE_SIZE] = { -4000.0, -1.0,   0.0, 300.0, 1000.0, 2000.0, 3200.0, 4500.0 };
+static const int paletteRed[FRACTAL_PALETTE_SIZE]       = {      10,   60,   90,    70,    150,    130,    150,    245 };
+static const int paletteGreen[FRACTAL_PALETTE_SIZE]     = {      30,  110,  140,   130,    150,    110,    150,    245 };
+static const int paletteBlue[FRACTAL_PALETTE_SIZE]      = {      80,  170,   80,    60,     80,     80,    150,    250 };
+
+CFractalTerrain::CFractalTerrain(quint32 noiseSeed)
+{
+    seed = noiseSeed;
+}
+
+short CFractalTerrain::getHeight(double lon, double lat, double spacing) const
+{
+    double height = FRACTAL_HEIGHT_SCALE*getFbm(lon, lat, spacing, seed) + FRACTAL_HEIGHT_OFFSET;
+
+    // sea is flat like in SRTM dataset
+    if (height<0.0) return 0;
+    if (height>32767.0) return 32767;
+    return (short)(height + 0.5);
+}
+
+void CFractalTerrain::getColor(double lon, double lat, double spacing, unsigned char *rgb) const
+{
+    double height, variation, t;
+    int i;
+
+    // same fBm as heights (not clamped at sea level) and small independent color variation
+    height = FRACTAL_HEIGHT_SCALE*getFbm(lon, lat, spacing, seed) + FRACTAL_HEIGHT_OFFSET;
+    variation = 1.0 + 0.15*getFbm(lon, lat, spacing, seed ^ 0x9E3779B9);
+
+    for (i=1; i<FRACTAL_PALETTE_SIZE-1; i++)
+        if (height<paletteHeight[i]) break;
+    t = (height - paletteHeight[i-1]) / (paletteHeight[i] - paletteHeight[i-1]);
+    if (t<0.0) t = 0.0;
+    if (t>1.0) t = 1.0;
+
+    rgb[0] = (unsigned char)qBound(0.0, variation*(paletteRed[i-1]   + t*(paletteRed[i]   - paletteRed[i-1])),   255.0);
+    rgb[1] = (unsigned char)qBound(0.0, variation*(paletteGreen[i-1] + t*(paletteGreen[i] - paletteGreen[i-1])), 255.0);
+    rgb[2] = (unsigned char)qBound(0.0, variation*(paletteBlue[i-1]  + t*(paletteBlue[i]  - paletteBlue[i-1])),  255.0);
+}
+
+double CFractalTerrain::getFbm(double lon, double lat, double spacing, quint32 fbmSeed) const
+{
+    double x, y, z;
+    double frequency, amplitude, sum;
+    double spacingRad = spacing * CONST_PIDIV180;
+    int octave;
+
+    x = sin(lon*CONST_PIDIV180)*cos(lat*CONST_PIDIV180);
+    y = sin(lat*CONST_PIDIV180);
+    z = cos(lon*CONST_PIDIV180)*cos(lat*CONST_PIDIV180);
+
+    // octaves finer than two samples are skipped - coarse levels get smooth terrain instead of aliasing
+    // and are much faster to generate, amplitude is not renormalized so all levels keep the same shape
+    frequency = FRACTAL_BASE_FREQUENCY;
+    amplitude = 0.5;
+    sum = 0.0;
+    for (octave=0; octave<FRACTAL_MAX_OCTAVES; octave++) {
+        if (1.0/frequency < 2.0*spacingRad) break;
+        sum += amplitude*getValueNoise(x*frequency, y*frequency, z*frequency, fbmSeed + octave*0x632BE5AB);
+        frequency *= 2.0;
+        amplitude *= FRACTAL_PERSISTENCE;
+    }
+
+    return sum;
+}
+
+double CFractalTerrain::getValueNoise(double x, double y, double z, quint32 octaveSeed) const
+{
+    double fx, fy, fz, sx, sy, sz;
+    double c00, c10, c01, c11, c0, c1;
+    int ix, iy, iz;
+
+    ix = (int)floor(x); fx = x - ix;
+    iy = (int)floor(y); fy = y - iy;
+    iz = (int)floor(z); fz = z - iz;
+    sx = fx*fx*(3.0 - 2.0*fx);
+    sy = fy*fy*(3.0 - 2.0*fy);
+    sz = fz*fz*(3.0 - 2.0*fz);
+
+    c00 = getLatticeValue(ix, iy,   iz,   octaveSeed) + sx*(getLatticeValue(ix+1, iy,   iz,   octaveSeed) - getLatticeValue(ix, iy,   iz,   octaveSeed));
+    c10 = getLatticeValue(ix, iy+1, iz,   octaveSeed) + sx*(getLatticeValue(ix+1, iy+1, iz,   octaveSeed) - getLatticeValue(ix, iy+1, iz,   octaveSeed));
+    c01 = getLatticeValue(ix, iy,   iz+1, octaveSeed) + sx*(getLatticeValue(ix+1, iy,   iz+1, octaveSeed) - getLatticeValue(ix, iy,   iz+1, octaveSeed));
+    c11 = getLatticeValue(ix, iy+1, iz+1, octaveSeed) + sx*(getLatticeValue(ix+1, iy+1, iz+1, octaveSeed) - getLatticeValue(ix, iy+1, iz+1, octaveSeed));
+    c0 = c00 + sy*(c10 - c00);
+    c1 = c01 + sy*(c11 - c01);
+
+    return c0 + sz*(c1 - c0);
+}
+
+double CFractalTerrain::getLatticeValue(int x, int y, int z, quint32 octaveSeed)
+{
+    quint32 h;
+
+    // integer hash - same value on every platform for given seed
+    h = (quint32)x*73856093u ^ (quint32)y*19349663u ^ (quint32)z*83492791u ^ octaveSeed*2654435761u;
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+
+    return (h / 2147483647.5) - 1.0;           // -1.0 .. 1.0
+}
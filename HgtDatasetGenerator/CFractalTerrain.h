@@ -0,0 +1,72 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CFRACTALTERRAIN_H
+#define CFRACTALTERRAIN_H
+
+#include <QtGlobal>
+
+#define FRACTAL_BASE_FREQUENCY        6.0       // first octave - features about 10 deg wide
+#define FRACTAL_MAX_OCTAVES            16       // last octave - features about 25 m wide
+#define FRACTAL_PERSISTENCE          0.50       // amplitude of next octave
+#define FRACTAL_HEIGHT_SCALE       7000.0       // meters for fBm value 1.0
+#define FRACTAL_HEIGHT_OFFSET       300.0       // a bit more land than sea
+#define FRACTAL_PALETTE_SIZE            8
+
+// deterministic fBm of 3D value noise on unit sphere - no seam at 0/360 deg and no pinching at poles
+class CFractalTerrain
+{
+public:
+    CFractalTerrain(quint32 noiseSeed);
+
+    short getHeight(double lon, double lat, double spacing) const;
+    void getColor(double lon, double lat, double spacing, unsigned char *rgb) const;
+
+private:
+    quint32 seed;
+
+    double getFbm(double lon, double lat, double spacing, quint32 fbmSeed) const;
+    double getValueNoise(double x, double y, double z, quint32 octaveSeed) const;
+    static double getLatticeValue(int x, int y, int z, quint32 octaveSeed);
+};
+
+#endif // CFRACTALTERRAIN_H
@@ -0,0 +1,79 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include "CGeneratorTask.h"
+
+CGeneratorTask::CGeneratorTask(const CFractalTerrain *fractalTerrain, int taskType, double tlLon, double tlLat,
+                               double sampleStep, int samples, int rowStart, int rowStop, char *rows)
+{
+    terrain = fractalTerrain;
+    type = taskType;
+    topLeftLon = tlLon;
+    topLeftLat = tlLat;
+    step = sampleStep;
+    size = samples;
+    start = rowStart;
+    stop = rowStop;
+    data = rows;
+}
+
+void CGeneratorTask::run()
+{
+    short *heights = (short *)data;
+    unsigned char *pixels = (unsigned char *)data;
+    double lat;
+    int x, y;
+
+    // first sample of row is at top left corner of file like in CCacheManager lookups
+    for (y=start; y<stop; y++) {
+        lat = topLeftLat - y*step;
+        for (x=0; x<size; x++) {
+            if (type==GENERATOR_TASK_HEIGHTS) {
+                (*heights) = terrain->getHeight(topLeftLon + x*step, lat, step);
+                heights++;
+            } else {
+                terrain->getColor(topLeftLon + x*step, lat, step, pixels);
+                pixels += 3;
+            }
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#-------------------------------------------------
+#
+# Generator of synthetic fractal L00-L13 HGT files
+# and RAW textures for reproducible benchmarks
+# without NASA SRTM and TrueMarble datasets
+#
+#-------------------------------------------------
+
+QT       += core
+QT       -= gui
+
+TARGET = HgtDatasetGenerator
+CONFIG   += console
+CONFIG   -= app_bundle
+TEMPLATE = app
+
+INCLUDEPATH += ../HgtReader
+
+SOURCES += main.cpp \
+    CDatasetGenerator.cpp \
+    CFractalTerrain.cpp \
+    CGeneratorTask.cpp \
+    ../HgtReader/CHgtFile.cpp
+
+HEADERS += CDatasetGenerator.h \
+    CFractalTerrain.h \
+    CGeneratorTask.h \
+    ../HgtReader/CHgtFile.h \
+    ../HgtReader/CIoCounters.h \
+    ../HgtReader/CTileFileName.h
@@ -0,0 +1,89 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <QDebug>
+#include "CDatasetGenerator.h"
+
+#define GENERATOR_DEFAULT_LON          20.088333        // first benchmark location
+#define GENERATOR_DEFAULT_LAT          49.179444
+#define GENERATOR_DEFAULT_SIZE          3.75            // one L09-L13 file
+#define GENERATOR_DEFAULT_TEX_GROUPS    3               // L09_L10 texture is 1.7 GB
+#define GENERATOR_DEFAULT_SEED         11               // land and coast at all benchmark locations
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QStringList args = a.arguments();
+    CDatasetGenerator *generator;
+    QString outputPath;
+    double lon, lat, size;
+    int textureGroups;
+    quint32 seed;
+    bool generated;
+
+    if (args.size()<2) {
+        qDebug("usage: HgtDatasetGenerator <output dir> [lon] [lat] [size in deg] [texture groups 0-4] [seed]");
+        return 1;
+    }
+
+    outputPath = args.at(1);
+    if (!outputPath.endsWith("/") && !outputPath.endsWith("\\")) outputPath += "/";
+
+    lon = (args.size()>2) ? args.at(2).toDouble() : GENERATOR_DEFAULT_LON;
+    lat = (args.size()>3) ? args.at(3).toDouble() : GENERATOR_DEFAULT_LAT;
+    size = (args.size()>4) ? args.at(4).toDouble() : GENERATOR_DEFAULT_SIZE;
+    textureGroups = (args.size()>5) ? args.at(5).toInt() : GENERATOR_DEFAULT_TEX_GROUPS;
+    seed = (args.size()>6) ? args.at(6).toUInt() : GENERATOR_DEFAULT_SEED;
+
+    qDebug("Coverage: lon %.6f lat %.6f size %.2f deg, texture groups: %d, seed: %u", lon, lat, size, textureGroups, seed);
+
+    // same arguments give byte identical files on every machine
+    generator = new CDatasetGenerator(outputPath, seed);
+    generator->setCoverage(lon, lat, size);
+    generator->setTextureGroups(textureGroups);
+    generated = generator->generate();
+    delete generator;
+
+    return generated ? 0 : 1;
+}
@@ -0,0 +1,328 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QDebug>
+#include "CCoreKernels.h"
+#include "CCommons.h"
+#include "CTerrainData.h"
+
+CCoreKernels::CCoreKernels(CCacheManager *cacheManagerPointer) : cacheManager(cacheManagerPointer)
+{
+    // create Earth Buffers - cache manager accepts only these two earths
+    earth = new CEarth;
+    earthExchanged = new CEarth;
+    cacheManager->setEarthBuffers(earthExchanged, earth);
+
+    // terrains are built from HGT and RAW files - tile disk cache would turn building into loading
+    dss.dontUseCache = true;
+    dss.dontUseDiskHgt = false;
+    dss.dontUseDiskRaw = false;
+
+    texture.setPixelsPointer(TEX_TERRAIN_SIZE, TEX_TERRAIN_SIZE, texturePixels);
+    lod = 0;
+    blockSkipping = 1;
+    cacheOccupancy = 0;
+    sink = 0.0;
+
+    setLocation(KERNEL_LON, KERNEL_LAT);
+}
+
+CCoreKernels::~CCoreKernels()
+{
+    delete earth;
+    delete earthExchanged;
+}
+
+void CCoreKernels::setLocation(double lon, double lat)
+{
+    locationLon = lon;
+    locationLat = lat;
+    prepareInputs();
+}
+
+double CCoreKernels::getRandom()
+{
+    // simple LCG - inputs must be the same on every platform
+    random = random*1103515245 + 12345;
+    return (double)((random >> 8) & 0xFFFFFF) / (double)0x1000000;
+}
+
+void CCoreKernels::prepareInputs()
+{
+    double tlLon, tlLat;
+    int i;
+
+    random = KERNEL_SEED;
+    globalLon.resize(KERNEL_INPUTS);
+    globalLat.resize(KERNEL_INPUTS);
+    globalTopLeftLon.resize(KERNEL_INPUTS);
+    globalTopLeftLat.resize(KERNEL_INPUTS);
+    tileLon.resize(KERNEL_INPUTS);
+    tileLat.resize(KERNEL_INPUTS);
+
+    // HGT file L09-L13 with location
+    CCommons::findTopLeftCornerOfHgtFile(locationLon, locationLat, KERNEL_TILE_LOD, &tlLon, &tlLat);
+
+    for (i=0; i<KERNEL_INPUTS; i++) {
+        globalLon[i] = -180.0 + 360.0*getRandom();
+        globalLat[i] = -89.9 + 179.8*getRandom();
+        CCommons::findTopLeftCorner(globalLon[i], globalLat[i], HGT_SOURCE_DEGREE_SIZE_L09_L13, &globalTopLeftLon[i], &globalTopLeftLat[i]);
+        tileLon[i] = tlLon + HGT_SOURCE_DEGREE_SIZE_L09_L13*getRandom();
+        tileLat[i] = tlLat - HGT_SOURCE_DEGREE_SIZE_L09_L13*getRandom();
+    }
+}
+
+void CCoreKernels::run(CMicroBenchmark *benchmark)
+{
+    runCommons(benchmark);
+    runHgtFile(benchmark, 13);
+    runHgtFile(benchmark, 9);
+    runTerrainData(benchmark, 6);
+    runTerrainData(benchmark, 12);
+    runTexture(benchmark, 4);
+    runTexture(benchmark, 10);
+    runCache(benchmark, 100, 0);
+    runCache(benchmark, 1000, 1);
+    runCache(benchmark, 10000, 2);
+}
+
+void CCoreKernels::runCommons(CMicroBenchmark *benchmark)
+{
+    benchmark->run("CCommons::getCartesianFromSpherical", kernelCartesianFromSpherical, this);
+    benchmark->run("CCommons::findTopLeftCorner", kernelFindTopLeftCorner, this);
+    benchmark->run("CCommons::convertTopLeft2AvabilityIndex", kernelTopLeft2AvabilityIndex, this);
+}
+
+void CCoreKernels::runHgtFile(CMicroBenchmark *benchmark, int hgtLod)
+{
+    QString name = QString("CHgtFile::fileGetHeightBlock LOD %1").arg(hgtLod);
+    QString filePath;
+    bool fileFound;
+    int x, y, hgtSize, range;
+    int i;
+
+    if (!benchmark->isSelected(name))
+        return;
+
+    cacheManager->findHgtFileName(locationLon, locationLat, hgtLod, &filePath, &fileFound, &x, &y, &blockSkipping, &hgtSize);
+    if (!fileFound) {
+        benchmark->skip(name, "no HGT file at location");
+        return;
+    }
+
+    // blocks with the same skipping as terrains of this LOD - anywhere in the file
+    range = hgtSize - (KERNEL_HGT_BLOCK_SIZE-1)*blockSkipping;
+    blockX.resize(KERNEL_INPUTS);
+    blockY.resize(KERNEL_INPUTS);
+    for (i=0; i<KERNEL_INPUTS; i++) {
+        blockX[i] = (int)(range*getRandom());
+        blockY[i] = (int)(range*getRandom());
+    }
+
+    hgtFile.fileOpen(filePath, hgtSize, hgtSize);
+    benchmark->run(name, kernelHgtBlock, this);
+    hgtFile.fileClose();
+}
+
+void CCoreKernels::runTerrainData(CMicroBenchmark *benchmark, int terrainLod)
+{
+    lod = terrainLod;
+    benchmark->run(QString("CTerrainData::initTerrainData LOD %1").arg(lod), kernelInitTerrainData, this);
+}
+
+void CCoreKernels::runTexture(CMicroBenchmark *benchmark, int textureLod)
+{
+    QString name = QString("CCacheManager::buildTextureFromRawFiles LOD %1").arg(textureLod);
+    int RAWfilesIndex[4];
+    int pixOffsetLon, pixOffsetLat;
+    int i;
+
+    if (!benchmark->isSelected(name))
+        return;
+
+    lod = textureLod;
+    terrainTopLeftLon.resize(KERNEL_INPUTS);
+    terrainTopLeftLat.resize(KERNEL_INPUTS);
+    for (i=0; i<KERNEL_INPUTS; i++)
+        CCommons::findTopLeftCorner(tileLon[i], tileLat[i], cacheManager->LODdegreeSizeLookUp[lod], &terrainTopLeftLon[i], &terrainTopLeftLat[i]);
+
+    if (!cacheManager->findRawFiles(terrainTopLeftLon[0], terrainTopLeftLat[0], lod, RAWfilesIndex, &pixOffsetLon, &pixOffsetLat)) {
+        benchmark->skip(name, "no RAW file at location");
+        return;
+    }
+
+    benchmark->run(name, kernelBuildTexture, this);
+}
+
+void CCoreKernels::runCache(CMicroBenchmark *benchmark, int occupancy, int groupOffset)
+{
+    QString registerName = QString("CCacheManager::cacheTerrainDataRegister+Free fill %1").arg(occupancy);
+    QString findHitName = QString("CCacheManager::cacheTerrainDataFind hit+Free at %1").arg(occupancy);
+    QString findMissName = QString("CCacheManager::cacheTerrainDataFind miss at %1").arg(occupancy);
+    double degreeSize = cacheManager->LODdegreeSizeLookUp[KERNEL_CACHE_LOD];
+    double tlLon, tlLat;
+    int perRow;
+    int i;
+
+    if (!benchmark->isSelected(registerName) && !benchmark->isSelected(findHitName) && !benchmark->isSelected(findMissName))
+        return;
+
+    // freed entries stay in group list - each occupancy has its own cache group (HGT file area)
+    CCommons::findTopLeftCornerOfHgtFile(KERNEL_CACHE_LON + groupOffset*HGT_SOURCE_DEGREE_SIZE_L09_L13, KERNEL_CACHE_LAT,
+                                         KERNEL_CACHE_LOD, &tlLon, &tlLat);
+    perRow = (int)(HGT_SOURCE_DEGREE_SIZE_L09_L13/degreeSize);
+    cacheOccupancy = occupancy;
+    cacheTerrains.resize(occupancy);
+    cacheLon.resize(occupancy);
+    cacheLat.resize(occupancy);
+    for (i=0; i<occupancy; i++) {
+        cacheLon[i] = tlLon + ((i % perRow) + 0.5)*degreeSize;
+        cacheLat[i] = tlLat - ((i / perRow) + 0.5)*degreeSize;
+        cacheTerrains[i] = new CTerrainData;
+        CCommons::findTopLeftCorner(cacheLon[i], cacheLat[i], degreeSize, &cacheTerrains[i]->topLeftLon, &cacheTerrains[i]->topLeftLat);
+        cacheTerrains[i]->LOD = KERNEL_CACHE_LOD;
+    }
+
+    // cache owns terrains after register - filled once, average over growing occupancy
+    if (benchmark->isSelected(registerName)) {
+        benchmark->runFixed(registerName, kernelCacheRegisterFree, this, occupancy);
+    } else {
+        for (i=0; i<occupancy; i++)
+            kernelCacheRegisterFree(this, i);
+    }
+
+    benchmark->run(findHitName, kernelCacheFindHit, this);
+    benchmark->run(findMissName, kernelCacheFindMiss, this);
+
+    cacheManager->cacheClear(earth);
+    cacheTerrains.clear();
+}
+
+void CCoreKernels::kernelCartesianFromSpherical(void *context, int iteration)
+{
+    CCoreKernels *k = (CCoreKernels *)context;
+    int i = iteration & (KERNEL_INPUTS-1);
+    double x, y, z;
+
+    CCommons::getCartesianFromSpherical(k->globalLon[i], k->globalLat[i], CONST_EARTH_RADIUS, &x, &y, &z);
+    k->sink = x + y + z;
+}
+
+void CCoreKernels::kernelFindTopLeftCorner(void *context, int iteration)
+{
+    CCoreKernels *k = (CCoreKernels *)context;
+    int i = iteration & (KERNEL_INPUTS-1);
+    double tlLon, tlLat;
+
+    CCommons::findTopLeftCorner(k->globalLon[i], k->globalLat[i], k->cacheManager->LODdegreeSizeLookUp[iteration % 14], &tlLon, &tlLat);
+    k->sink = tlLon + tlLat;
+}
+
+void CCoreKernels::kernelTopLeft2AvabilityIndex(void *context, int iteration)
+{
+    CCoreKernels *k = (CCoreKernels *)context;
+    int i = iteration & (KERNEL_INPUTS-1);
+    int index;
+
+    CCommons::convertTopLeft2AvabilityIndex(k->globalTopLeftLon[i], k->globalTopLeftLat[i], HGT_SOURCE_DEGREE_SIZE_L09_L13, &index);
+    k->sink = index;
+}
+
+void CCoreKernels::kernelHgtBlock(void *context, int iteration)
+{
+    CCoreKernels *k = (CCoreKernels *)context;
+    int i = iteration & (KERNEL_INPUTS-1);
+
+    k->hgtFile.fileGetHeightBlock(k->heightBlock, k->blockX[i], k->blockY[i], KERNEL_HGT_BLOCK_SIZE, KERNEL_HGT_BLOCK_SIZE, k->blockSkipping);
+    k->sink = k->heightBlock[KERNEL_HGT_BLOCK_SIZE*KERNEL_HGT_BLOCK_SIZE/2];
+}
+
+void CCoreKernels::kernelInitTerrainData(void *context, int iteration)
+{
+    CCoreKernels *k = (CCoreKernels *)context;
+    int i = iteration & (KERNEL_INPUTS-1);
+    CTerrainData *terrainData;
+
+    // the same as CTerrain - new terrain for each cache miss
+    terrainData = new CTerrainData;
+    terrainData->initTerrainData(k->tileLon[i], k->tileLat[i], k->lod, &k->dss);
+    k->sink = terrainData->topLeftLon;
+    delete terrainData;
+}
+
+void CCoreKernels::kernelBuildTexture(void *context, int iteration)
+{
+    CCoreKernels *k = (CCoreKernels *)context;
+    int i = iteration & (KERNEL_INPUTS-1);
+
+    k->cacheManager->buildTextureFromRawFiles(k->terrainTopLeftLon[i], k->terrainTopLeftLat[i], k->lod, &k->texture);
+    k->sink = k->texturePixels[0].r;
+}
+
+void CCoreKernels::kernelCacheRegisterFree(void *context, int iteration)
+{
+    CCoreKernels *k = (CCoreKernels *)context;
+
+    k->cacheManager->cacheTerrainDataRegister(k->earth, &k->cacheTerrains[iteration]);
+    k->cacheManager->cacheTerrainDataFree(k->earth, &k->cacheTerrains[iteration], false);
+}
+
+void CCoreKernels::kernelCacheFindHit(void *context, int iteration)
+{
+    CCoreKernels *k = (CCoreKernels *)context;
+    int i = (int)(((unsigned int)iteration*7919u) % (unsigned int)k->cacheOccupancy);     // jump around whole list
+    CTerrainData *terrainData;
+
+    if (k->cacheManager->cacheTerrainDataFind(k->cacheLon[i], k->cacheLat[i], KERNEL_CACHE_LOD, k->earth, &terrainData))
+        k->cacheManager->cacheTerrainDataFree(k->earth, &terrainData, false);
+}
+
+void CCoreKernels::kernelCacheFindMiss(void *context, int iteration)
+{
+    CCoreKernels *k = (CCoreKernels *)context;
+    int i = (int)(((unsigned int)iteration*7919u) % (unsigned int)k->cacheOccupancy);
+    CTerrainData *terrainData;
+
+    // parent LOD shares cache group but was never registered - whole list is searched
+    if (k->cacheManager->cacheTerrainDataFind(k->cacheLon[i], k->cacheLat[i], KERNEL_CACHE_LOD-1, k->earth, &terrainData))
+        qFatal("MicroBenchmark - unexpected cache hit");
+}
@@ -0,0 +1,125 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CCOREKERNELS_H
+#define CCOREKERNELS_H
+
+#include <QString>
+#include <QVector>
+#include "CEarth.h"
+#include "CCacheManager.h"
+#include "CDrawingStateSnapshot.h"
+#include "CHgtFile.h"
+#include "CRawFile.h"
+#include "CMicroBenchmark.h"
+
+#define KERNEL_INPUTS                   4096      // precomputed pseudo random inputs (power of two)
+#define KERNEL_SEED                       11      // the same inputs in every run
+#define KERNEL_LON                 20.088333      // default location - the same as HgtDatasetGenerator
+#define KERNEL_LAT                 49.179444
+#define KERNEL_TILE_LOD                    9      // terrain and texture inputs are in L09-L13 HGT file with location
+#define KERNEL_HGT_BLOCK_SIZE              9      // block read by CCacheManager::getTerrainPoints
+#define KERNEL_CACHE_LOD                  13      // terrains registered in cache
+#define KERNEL_CACHE_LON              -172.5      // cache kernels use empty ocean far away from data
+#define KERNEL_CACHE_LAT               -50.0
+
+// inputs and state of core kernels - CCommons conversions, CHgtFile block reads, terrain building and cache operations
+class CCoreKernels
+{
+public:
+    CCoreKernels(CCacheManager *cacheManagerPointer);
+    ~CCoreKernels();
+
+    void setLocation(double lon, double lat);
+    void run(CMicroBenchmark *benchmark);
+
+private:
+    CCacheManager *cacheManager;
+    CEarth *earth;                          // cache accepts only earth buffers known by cache manager
+    CEarth *earthExchanged;
+    CDrawingStateSnapshot dss;
+    double locationLon;
+    double locationLat;
+    unsigned int random;
+
+    QVector<double> globalLon;              // whole Earth
+    QVector<double> globalLat;
+    QVector<double> globalTopLeftLon;       // top left corners of HGT files L09-L13
+    QVector<double> globalTopLeftLat;
+    QVector<double> tileLon;                // inside L09-L13 HGT file around location
+    QVector<double> tileLat;
+    QVector<double> terrainTopLeftLon;      // top left corners of terrains in tile for current LOD
+    QVector<double> terrainTopLeftLat;
+    QVector<int> blockX;
+    QVector<int> blockY;
+    int blockSkipping;
+    int lod;
+    CHgtFile hgtFile;
+    int heightBlock[KERNEL_HGT_BLOCK_SIZE*KERNEL_HGT_BLOCK_SIZE];
+    CRawPixel texturePixels[TEX_TERRAIN_SIZE*TEX_TERRAIN_SIZE];
+    CRawFile texture;
+    QVector<CTerrainData *> cacheTerrains;
+    QVector<double> cacheLon;
+    QVector<double> cacheLat;
+    int cacheOccupancy;
+    volatile double sink;                   // results are stored so compiler can't remove kernel
+
+    double getRandom();
+    void prepareInputs();
+    void runCommons(CMicroBenchmark *benchmark);
+    void runHgtFile(CMicroBenchmark *benchmark, int hgtLod);
+    void runTerrainData(CMicroBenchmark *benchmark, int terrainLod);
+    void runTexture(CMicroBenchmark *benchmark, int textureLod);
+    void runCache(CMicroBenchmark *benchmark, int occupancy, int groupOffset);
+
+    static void kernelCartesianFromSpherical(void *context, int iteration);
+    static void kernelFindTopLeftCorner(void *context, int iteration);
+    static void kernelTopLeft2AvabilityIndex(void *context, int iteration);
+    static void kernelHgtBlock(void *context, int iteration);
+    static void kernelInitTerrainData(void *context, int iteration);
+    static void kernelBuildTexture(void *context, int iteration);
+    static void kernelCacheRegisterFree(void *context, int iteration);
+    static void kernelCacheFindHit(void *context, int iteration);
+    static void kernelCacheFindMiss(void *context, int iteration);
+};
+
+#endif // CCOREKERNELS_H
@@ -0,0 +1,181 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+#include "CMicroBenchmark.h"
+
+QAtomicInt CMicroBenchmark::allocations;
+
+CMicroBenchmark::CMicroBenchmark()
+{
+}
+
+void CMicroBenchmark::setFilter(const QString &f)
+{
+    filter = f;
+}
+
+bool CMicroBenchmark::isSelected(const QString &name)
+{
+    return filter.isEmpty() || name.contains(filter, Qt::CaseInsensitive);
+}
+
+void CMicroBenchmark::run(const QString &name, CMicroBenchmarkKernel kernel, void *context)
+{
+    qint64 elapsedNs;
+    int allocationCount;
+    int iterations = 1;
+
+    if (!isSelected(name))
+        return;
+
+    // double iterations until run is long enough to make timer resolution and warm-up negligible
+    while (true) {
+        measure(kernel, context, iterations, &elapsedNs, &allocationCount);
+        if (elapsedNs >= (qint64)MICRO_BENCHMARK_MIN_TIME_MS*1000000 || iterations >= MICRO_BENCHMARK_MAX_ITERATIONS)
+            break;
+        iterations *= 2;
+    }
+
+    addResult(name, iterations, elapsedNs, allocationCount);
+}
+
+void CMicroBenchmark::runFixed(const QString &name, CMicroBenchmarkKernel kernel, void *context, int iterations)
+{
+    qint64 elapsedNs;
+    int allocationCount;
+
+    if (!isSelected(name))
+        return;
+
+    // kernels which change state (filling cache) can run only once with given number of iterations
+    measure(kernel, context, iterations, &elapsedNs, &allocationCount);
+    addResult(name, iterations, elapsedNs, allocationCount);
+}
+
+void CMicroBenchmark::skip(const QString &name, const QString &reason)
+{
+    CMicroBenchmarkResult result;
+
+    if (!isSelected(name))
+        return;
+
+    result.name = name;
+    result.iterations = 0;
+    result.nsPerOp = 0.0;
+    result.allocsPerOp = 0.0;
+    result.skipReason = reason;
+    results.append(result);
+
+    qDebug("%-52s skipped - %s", qPrintable(name), qPrintable(reason));
+}
+
+void CMicroBenchmark::measure(CMicroBenchmarkKernel kernel, void *context, int iterations, qint64 *elapsedNs, int *allocationCount)
+{
+    QElapsedTimer timer;
+    int allocationsStart;
+    int i;
+
+    allocationsStart = getAllocations();
+    timer.start();
+    for (i=0; i<iterations; i++)
+        kernel(context, i);
+    (*elapsedNs) = timer.nsecsElapsed();
+    (*allocationCount) = getAllocations() - allocationsStart;
+}
+
+void CMicroBenchmark::addResult(const QString &name, int iterations, qint64 elapsedNs, int allocationCount)
+{
+    CMicroBenchmarkResult result;
+
+    result.name = name;
+    result.iterations = iterations;
+    result.nsPerOp = iterations>0 ? (double)elapsedNs/(double)iterations : 0.0;
+    result.allocsPerOp = iterations>0 ? (double)allocationCount/(double)iterations : 0.0;
+    results.append(result);
+
+    qDebug("%-52s %14.1f ns/op %10.2f allocs/op %10d ops",
+           qPrintable(name), result.nsPerOp, result.allocsPerOp, result.iterations);
+}
+
+bool CMicroBenchmark::writeReport(const QString &fileName)
+{
+    QFile file;
+    int i;
+
+    // no file name - report goes to standard output
+    if (fileName.isEmpty()) {
+        if (!file.open(stdout, QIODevice::WriteOnly | QIODevice::Text))
+            return false;
+    } else {
+        file.setFileName(fileName);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            qWarning("MicroBenchmark - could not write report %s", qPrintable(fileName));
+            return false;
+        }
+    }
+
+    QTextStream out(&file);
+    out << "{" << endl;
+    out << "  \"minTimeMs\": " << MICRO_BENCHMARK_MIN_TIME_MS << "," << endl;
+    out << "  \"allocsCounted\": \"" << MICRO_BENCHMARK_ALLOCS_COUNTED << "\"," << endl;
+    out << "  \"kernels\": [" << endl;
+    for (i=0; i<results.size(); i++) {
+        const CMicroBenchmarkResult &result = results.at(i);
+        out << "    { \"name\": \"" << result.name << "\", ";
+        if (result.skipReason.isEmpty()) {
+            out << "\"iterations\": " << result.iterations << ", ";
+            out << "\"nsPerOp\": " << QString::number(result.nsPerOp, 'f', 1) << ", ";
+            out << "\"allocsPerOp\": " << QString::number(result.allocsPerOp, 'f', 2) << " }";
+        } else {
+            out << "\"skipped\": \"" << result.skipReason << "\" }";
+        }
+        out << (i<results.size()-1 ? "," : "") << endl;
+    }
+    out << "  ]" << endl;
+    out << "}" << endl;
+
+    return true;
+}
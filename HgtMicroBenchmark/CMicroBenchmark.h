@@ -0,0 +1,94 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CMICROBENCHMARK_H
+#define CMICROBENCHMARK_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QAtomicInt>
+
+#define MICRO_BENCHMARK_MIN_TIME_MS        250      // iterations are doubled until kernel runs at least this long
+#define MICRO_BENCHMARK_MAX_ITERATIONS  (1<<26)      // upper limit for very fast kernels
+#define MICRO_BENCHMARK_ALLOCS_COUNTED  "operator new/new[] only - Qt container allocations (qMalloc) are excluded"
+
+// one operation of benchmarked kernel - iteration selects input so kernel does not work on the same data all the time
+typedef void (*CMicroBenchmarkKernel)(void *context, int iteration);
+
+class CMicroBenchmarkResult
+{
+public:
+    QString name;
+    int iterations;
+    double nsPerOp;
+    double allocsPerOp;
+    QString skipReason;                 // not empty when kernel could not run (missing data)
+};
+
+// runs kernels, measures ns/op and allocations/op (counted by operator new replaced in main.cpp,
+// allocations of Qt containers are not seen - see MICRO_BENCHMARK_ALLOCS_COUNTED)
+class CMicroBenchmark
+{
+public:
+    CMicroBenchmark();
+
+    void setFilter(const QString &filter);
+    bool isSelected(const QString &name);
+    void run(const QString &name, CMicroBenchmarkKernel kernel, void *context);
+    void runFixed(const QString &name, CMicroBenchmarkKernel kernel, void *context, int iterations);
+    void skip(const QString &name, const QString &reason);
+    bool writeReport(const QString &fileName);
+
+    static void countAllocation() { allocations.fetchAndAddRelaxed(1); }
+    static int getAllocations() { return (int)allocations; }
+
+private:
+    static QAtomicInt allocations;
+    QString filter;
+    QList<CMicroBenchmarkResult> results;
+
+    void measure(CMicroBenchmarkKernel kernel, void *context, int iterations, qint64 *elapsedNs, int *allocationCount);
+    void addResult(const QString &name, int iterations, qint64 elapsedNs, int allocationCount);
+};
+
+#endif // CMICROBENCHMARK_H
@@ -0,0 +1,80 @@
+#-------------------------------------------------
+#
+# Microbenchmarks of core kernels - coordinate
+# conversions, HGT block reads, terrain and texture
+# building and cache operations in ns/op and allocs/op
+#
+#-------------------------------------------------
+
+QT       += core gui opengl
+
+TARGET = HgtMicroBenchmark
+CONFIG   += console
+CONFIG   -= app_bundle
+TEMPLATE = app
+
+INCLUDEPATH += ../HgtReader
+
+SOURCES += main.cpp \
+    CMicroBenchmark.cpp \
+    CCoreKernels.cpp \
+    ../HgtReader/CTerrain.cpp \
+    ../HgtReader/CPerformance.cpp \
+    ../HgtReader/CHgtFile.cpp \
+    ../HgtReader/CEarth.cpp \
+    ../HgtReader/CCommons.cpp \
+    ../HgtReader/CCacheManager.cpp \
+    ../HgtReader/CAvability.cpp \
+    ../HgtReader/CDrawingStateSnapshot.cpp \
+    ../HgtReader/CTerrainData.cpp \
+    ../HgtReader/CCachedTerrainDataGroup.cpp \
+    ../HgtReader/CCachedTerrainData.cpp \
+    ../HgtReader/CRawFile.cpp \
+    ../HgtReader/CTerrainUpdateTask.cpp \
+    ../HgtReader/CCompactTerrainData.cpp \
+    ../HgtReader/CTileDiskCache.cpp \
+    ../HgtReader/CTerrainContainer.cpp \
+    ../HgtReader/CIndexedFile.cpp \
+    ../HgtReader/CHeightRangeTable.cpp \
+    ../HgtReader/CElevationCodec.cpp \
+    ../HgtReader/CRawTiledFile.cpp \
+    ../HgtReader/CBc1Codec.cpp \
+    ../HgtReader/CTextureTiles.cpp \
+    ../HgtReader/CCameraPath.cpp \
+    ../HgtReader/CCacheTrace.cpp \
+    ../HgtReader/CTraceZone.cpp \
+    ../HgtReader/CMetricRing.cpp \
+    ../HgtReader/CIoStats.cpp
+
+HEADERS += CMicroBenchmark.h \
+    CCoreKernels.h \
+    ../HgtReader/CTerrain.h \
+    ../HgtReader/CPerformance.h \
+    ../HgtReader/CHgtFile.h \
+    ../HgtReader/CEarth.h \
+    ../HgtReader/CCommons.h \
+    ../HgtReader/CCacheManager.h \
+    ../HgtReader/CAvability.h \
+    ../HgtReader/CDrawingStateSnapshot.h \
+    ../HgtReader/CTerrainData.h \
+    ../HgtReader/CCachedTerrainDataGroup.h \
+    ../HgtReader/CCachedTerrainData.h \
+    ../HgtReader/CRawFile.h \
+    ../HgtReader/CTerrainUpdateTask.h \
+    ../HgtReader/CCompactTerrainData.h \
+    ../HgtReader/CTileDiskCache.h \
+    ../HgtReader/CTerrainContainer.h \
+    ../HgtReader/CIndexedFile.h \
+    ../HgtReader/CHeightRangeTable.h \
+    ../HgtReader/CElevationCodec.h \
+    ../HgtReader/CRawTiledFile.h \
+    ../HgtReader/CBc1Codec.h \
+    ../HgtReader/CTextureTiles.h \
+    ../HgtReader/CCameraPath.h \
+    ../HgtReader/CCacheTrace.h \
+    ../HgtReader/CTraceZone.h \
+    ../HgtReader/CMetricRing.h \
+    ../HgtReader/CSeqRing.h \
+    ../HgtReader/CIoStats.h \
+    ../HgtReader/CIoCounters.h \
+    ../HgtReader/CTileFileName.h
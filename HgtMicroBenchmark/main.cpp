@@ -0,0 +1,145 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <QDir>
+#include <QDebug>
+#include <new>
+#include <cstdlib>
+#include "CCacheManager.h"
+#include "CPerformance.h"
+#include "CMicroBenchmark.h"
+#include "CCoreKernels.h"
+
+// replaced global allocation functions - every operator new/new[] is counted for allocs/op,
+// Qt containers (QVector, QByteArray, QString...) allocate by qMalloc/malloc so they are not counted
+#if __cplusplus >= 201103L
+#define MICRO_BENCHMARK_THROW_BAD_ALLOC
+#else
+#define MICRO_BENCHMARK_THROW_BAD_ALLOC throw(std::bad_alloc)
+#endif
+
+void *operator new(size_t size) MICRO_BENCHMARK_THROW_BAD_ALLOC
+{
+    void *p;
+
+    CMicroBenchmark::countAllocation();
+    p = malloc(size>0 ? size : 1);
+    if (p==0)
+        throw std::bad_alloc();
+    return p;
+}
+
+void *operator new[](size_t size) MICRO_BENCHMARK_THROW_BAD_ALLOC
+{
+    void *p;
+
+    CMicroBenchmark::countAllocation();
+    p = malloc(size>0 ? size : 1);
+    if (p==0)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) throw()
+{
+    free(p);
+}
+
+void operator delete[](void *p) throw()
+{
+    free(p);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QStringList args = a.arguments();
+    CCacheManager *cacheManager;
+    CPerformance *performance;
+    CMicroBenchmark *benchmark;
+    CCoreKernels *kernels;
+    QString reportFileName, filter;
+    bool reportWritten;
+    int i;
+
+    // -filter <text> runs only kernels with text in name
+    i = args.indexOf("-filter");
+    if (i>0 && i+1<args.size()) {
+        filter = args.at(i+1);
+        args.removeAt(i+1);
+        args.removeAt(i);
+    }
+
+    if (args.size()<2) {
+        qDebug("usage: HgtMicroBenchmark [-filter <kernel name part>] <data dir> [JSON report file]");
+        return 1;
+    }
+
+    // report file given by user is relative to directory where benchmark was started
+    if (args.size()>2)
+        reportFileName = QDir::current().absoluteFilePath(args.at(2));
+
+    // cache manager finds HGT, RAW and cache files relative to current directory
+    if (!QDir::setCurrent(args.at(1))) {
+        qWarning("MicroBenchmark - data directory %s not found", qPrintable(args.at(1)));
+        return 1;
+    }
+
+    cacheManager = new CCacheManager;
+    performance = new CPerformance;
+    benchmark = new CMicroBenchmark;
+    kernels = new CCoreKernels(cacheManager);
+
+    benchmark->setFilter(filter);
+    qDebug("allocs/op counts %s", MICRO_BENCHMARK_ALLOCS_COUNTED);
+    kernels->run(benchmark);
+    reportWritten = benchmark->writeReport(reportFileName);
+
+    delete kernels;
+    delete benchmark;
+    delete performance;
+    delete cacheManager;
+
+    return reportWritten ? 0 : 1;
+}
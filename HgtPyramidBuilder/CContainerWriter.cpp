@@ -0,0 +1,190 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QDataStream>
+#include <QMap>
+#include "CContainerWriter.h"
+#include "CHgtFile.h"
+#include "CElevationCodec.h"
+
+CContainerWriter::CContainerWriter(CPyramidBuilder *pyramidBuilder, bool compressChunks)
+{
+    builder = pyramidBuilder;
+    compress = compressChunks;
+}
+
+void CContainerWriter::getZOrder(int width, int height, QVector<int> *order)
+{
+    QMap<quint64, int> sorted;
+    QMap<quint64, int>::const_iterator i;
+    int x, y;
+
+    // index y*width + x of each cell sorted by Morton code
+    for (y=0; y<height; y++)
+        for (x=0; x<width; x++)
+            sorted.insert(CTerrainContainer::getChunkKey(0, x, y), y*width + x);
+
+    order->clear();
+    order->reserve(sorted.size());
+    for (i=sorted.constBegin(); i!=sorted.constEnd(); ++i)
+        order->append(i.value());
+}
+
+bool CContainerWriter::write(const QString &fileName)
+{
+    QFile file(fileName + ".tmp");
+    QDataStream stream(&file);
+    quint64 indexOffset;
+    int level, i;
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning("Container writer - can't create %s", qPrintable(file.fileName()));
+        return false;
+    }
+
+    chunkKeys.clear();
+    chunks.clear();
+
+    // header is written again with index offset when chunks are done
+    file.seek(TERRAIN_CONTAINER_HEADER_SIZE);
+    for (level=PYRAMID_LEVEL_L00_L03; level<=PYRAMID_LEVEL_L09_L13; level++) {
+        if (!writeLevel(&file, level)) {
+            file.close();
+            QFile::remove(file.fileName());
+            return false;
+        }
+    }
+
+    indexOffset = file.pos();
+    for (i=0; i<chunkKeys.size(); i++)
+        stream << chunkKeys.at(i) << chunks.at(i).offset << chunks.at(i).size << chunks.at(i).flags;
+
+    file.seek(0);
+    stream << (quint32)TERRAIN_CONTAINER_MAGIC << (quint32)TERRAIN_CONTAINER_VERSION
+           << (quint32)TERRAIN_CONTAINER_CHUNK_INTERVALS << (quint32)TERRAIN_CONTAINER_LEVELS;
+    for (level=PYRAMID_LEVEL_L00_L03; level<=PYRAMID_LEVEL_L09_L13; level++) {
+        stream << (qint32)((int)(360.0 / builder->levelDegreeSize[level]) * (builder->levelSize[level] - 1));
+        stream << (qint32)((int)(180.0 / builder->levelDegreeSize[level]) * (builder->levelSize[level] - 1));
+    }
+    stream << indexOffset << (quint64)chunkKeys.size();
+    file.close();
+
+    // container is replaced only when new one is complete
+    QFile::remove(fileName);
+    if (!QFile::rename(file.fileName(), fileName)) {
+        qWarning("Container writer - can't rename %s", qPrintable(file.fileName()));
+        return false;
+    }
+
+    qDebug("Terrain container written: %d chunks, %lld MB", chunkKeys.size(), QFile(fileName).size() / (1024*1024));
+
+    return true;
+}
+
+bool CContainerWriter::writeLevel(QFile *file, int level)
+{
+    CHgtFile hgtFile;
+    CIndexedFileEntry chunk;
+    QVector<int> filesOrder, chunksOrder;
+    QString fileName;
+    QByteArray bytes, compressed;
+    quint16 samples[TERRAIN_CONTAINER_CHUNK_SAMPLES*TERRAIN_CONTAINER_CHUNK_SAMPLES];
+    int size = builder->levelSize[level];
+    int width = (int)(360.0 / builder->levelDegreeSize[level]);
+    int height = (int)(180.0 / builder->levelDegreeSize[level]);
+    int chunksPerFile = (size - 1) / TERRAIN_CONTAINER_CHUNK_INTERVALS;
+    int f, c, i, fx, fy, cx, cy;
+    bool notEmpty;
+
+    // chunks per file is power of 2 - Z-order of files followed by Z-order
+    // of chunks inside file is Z-order of chunks in whole level
+    getZOrder(width, height, &filesOrder);
+    getZOrder(chunksPerFile, chunksPerFile, &chunksOrder);
+    bytes.resize(TERRAIN_CONTAINER_CHUNK_SAMPLES*TERRAIN_CONTAINER_CHUNK_SAMPLES*2);
+
+    for (f=0; f<filesOrder.size(); f++) {
+        fileName = builder->getFilePath(level, filesOrder.at(f));
+        if (!QFile::exists(fileName))
+            continue;                                   // sea level
+        fx = filesOrder.at(f) % width;
+        fy = filesOrder.at(f) / width;
+        hgtFile.loadFile(fileName, size, size);
+
+        for (c=0; c<chunksOrder.size(); c++) {
+            cx = chunksOrder.at(c) % chunksPerFile;
+            cy = chunksOrder.at(c) / chunksPerFile;
+            hgtFile.getHeightBlock(samples, cx*TERRAIN_CONTAINER_CHUNK_INTERVALS, cy*TERRAIN_CONTAINER_CHUNK_INTERVALS,
+                                   TERRAIN_CONTAINER_CHUNK_SAMPLES, TERRAIN_CONTAINER_CHUNK_SAMPLES, 1);
+
+            notEmpty = false;
+            for (i=0; i<TERRAIN_CONTAINER_CHUNK_SAMPLES*TERRAIN_CONTAINER_CHUNK_SAMPLES; i++) {
+                if (samples[i]!=0) notEmpty = true;
+                bytes[2*i]     = (char)((samples[i] & 0xFF00) >> 8);
+                bytes[2*i + 1] = (char)(samples[i] & 0xFF);
+            }
+            if (!notEmpty)
+                continue;                               // sea level chunks are not stored
+
+            chunk.offset = file->pos();
+            chunk.flags = TERRAIN_CONTAINER_CHUNK_RAW;
+            if (compress) {
+                compressed = CElevationCodec::encode(samples, TERRAIN_CONTAINER_CHUNK_SAMPLES, TERRAIN_CONTAINER_CHUNK_SAMPLES);
+                if (compressed.size() < bytes.size())
+                    chunk.flags = TERRAIN_CONTAINER_CHUNK_DELTA;
+            }
+            if (chunk.flags==TERRAIN_CONTAINER_CHUNK_DELTA) {
+                chunk.size = compressed.size();
+                if (file->write(compressed)!=compressed.size()) return false;
+            } else {
+                chunk.size = bytes.size();
+                if (file->write(bytes)!=bytes.size()) return false;
+            }
+
+            chunkKeys.append(CTerrainContainer::getChunkKey(level, fx*chunksPerFile + cx, fy*chunksPerFile + cy));
+            chunks.append(chunk);
+        }
+
+        qDebug("%s packed", qPrintable(fileName));
+    }
+
+    return true;
+}
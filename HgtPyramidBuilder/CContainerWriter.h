@@ -0,0 +1,72 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CCONTAINERWRITER_H
+#define CCONTAINERWRITER_H
+
+#include <QString>
+#include <QFile>
+#include <QVector>
+#include "CPyramidBuilder.h"
+#include "CTerrainContainer.h"
+
+// packs HGT files of all pyramid levels to one CTerrainContainer file - one HGT
+// file in memory at a time, files and chunks inside files are written in Z-order,
+// chunks are coded with CElevationCodec when compression is on
+class CContainerWriter
+{
+public:
+    CContainerWriter(CPyramidBuilder *pyramidBuilder, bool compressChunks);
+
+    bool write(const QString &fileName);
+
+private:
+    CPyramidBuilder *builder;
+    bool compress;
+    QVector<quint64> chunkKeys;
+    QVector<CIndexedFileEntry> chunks;
+
+    bool writeLevel(QFile *file, int level);
+    void getZOrder(int width, int height, QVector<int> *order);
+};
+
+#endif // CCONTAINERWRITER_H
@@ -0,0 +1,341 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+#include <QDataStream>
+#include <QList>
+#include <QVector>
+#include <QThreadPool>
+#include <QTime>
+#include <QMutexLocker>
+#include <math.h>
+#include "CPyramidBuilder.h"
+#include "CPyramidTask.h"
+#include "CPyramidManifest.h"
+#include "CTileFileName.h"
+#include "CHgtFile.h"
+#include "CHeightRangeTable.h"
+
+CPyramidBuilder::CPyramidBuilder(const QString &srtmPath, const QString &outputPath, int maxTilesInMemory)
+{
+    srtmTileCache = new CSrtmTileCache(srtmPath, maxTilesInMemory);
+    pathOutput = outputPath;
+
+    levelSize[PYRAMID_LEVEL_L00_L03] = 65;
+    levelSize[PYRAMID_LEVEL_L04_L08] = 513;
+    levelSize[PYRAMID_LEVEL_L09_L13] = 4097;
+
+    levelDegreeSize[PYRAMID_LEVEL_L00_L03] = 60.00;
+    levelDegreeSize[PYRAMID_LEVEL_L04_L08] = 15.00;
+    levelDegreeSize[PYRAMID_LEVEL_L09_L13] = 3.75;
+
+    levelDir[PYRAMID_LEVEL_L00_L03] = "L00-L03/";
+    levelDir[PYRAMID_LEVEL_L04_L08] = "L04-L08/";
+    levelDir[PYRAMID_LEVEL_L09_L13] = "L09-L13/";
+
+    tasksCount = 0;
+    tasksDone = 0;
+    tasksFailed = 0;
+}
+
+CPyramidBuilder::~CPyramidBuilder()
+{
+    delete srtmTileCache;
+}
+
+int CPyramidBuilder::getFileIndex(int level, int x, int y)
+{
+    int width = (int)(360.0 / levelDegreeSize[level]);
+
+    return y*width + x;
+}
+
+void CPyramidBuilder::getFileLonLat(int level, int index, double *lon, double *lat)
+{
+    int width = (int)(360.0 / levelDegreeSize[level]);
+
+    (*lon) = (index % width) * levelDegreeSize[level];
+    (*lat) = 90.0 - (index / width) * levelDegreeSize[level];
+}
+
+QString CPyramidBuilder::getFilePath(int level, int index)
+{
+    double lon, lat;
+
+    getFileLonLat(level, index, &lon, &lat);
+
+    return pathOutput + levelDir[level] + CTileFileName::getName(lon, lat, "hgt");
+}
+
+QString CPyramidBuilder::getHeightRangePath(int index)
+{
+    double lon, lat;
+
+    // next to L09-L13 file - only ranges of rebuilt files are computed again
+    getFileLonLat(PYRAMID_LEVEL_L09_L13, index, &lon, &lat);
+
+    return pathOutput + levelDir[PYRAMID_LEVEL_L09_L13] + CTileFileName::getName(lon, lat, "hgr");
+}
+
+void CPyramidBuilder::addDependentFiles(int tileIndex, QSet<int> *files)
+{
+    int width  = (int)(360.0 / levelDegreeSize[PYRAMID_LEVEL_L09_L13]);
+    int height = (int)(180.0 / levelDegreeSize[PYRAMID_LEVEL_L09_L13]);
+    double margin = 2.0 / (SRTM_TILE_SIZE - 1);
+    int x, y, lon, lat;
+    int xMin, xMax, yMin, yMax;
+
+    CSrtmTileCache::getTileLonLat(tileIndex, &lon, &lat);
+
+    // L09-L13 files touched by SRTM tile, bicubic filter needs samples around tile too
+    xMin = (int)floor((lon - margin) / levelDegreeSize[PYRAMID_LEVEL_L09_L13]);
+    xMax = (int)floor((lon + 1.0 + margin) / levelDegreeSize[PYRAMID_LEVEL_L09_L13]);
+    yMin = (int)floor((90.0 - lat - margin) / levelDegreeSize[PYRAMID_LEVEL_L09_L13]);
+    yMax = (int)floor((90.0 - lat + 1.0 + margin) / levelDegreeSize[PYRAMID_LEVEL_L09_L13]);
+
+    for (y=yMin; y<=yMax; y++)
+        for (x=xMin; x<=xMax; x++) {
+            if (y<0 || y>=height) continue;
+            files->insert(getFileIndex(PYRAMID_LEVEL_L09_L13, (x + width) % width, y));
+        }
+}
+
+void CPyramidBuilder::build(bool fullRebuild)
+{
+    CPyramidManifest manifest;
+    QSet<int> changedTiles;
+    QSet<int> files;
+    QList<int> list;
+    int i, x, y, index, width;
+    QTime time;
+
+    time.start();
+    qDebug("SRTM files found: %d", srtmTileCache->availableFiles.size());
+
+    // only SRTM tiles changed since last build are rebuilt
+    if (fullRebuild || !manifest.load(pathOutput + PYRAMID_MANIFEST_FILE)) {
+        list = srtmTileCache->availableFiles.keys();
+        changedTiles = list.toSet();
+    } else {
+        changedTiles = manifest.getChangedTiles(srtmTileCache->availableFiles);
+    }
+    qDebug("SRTM files changed since last build: %d", changedTiles.size());
+    tasksFailed = 0;
+
+    list = changedTiles.toList();
+    for (i=0; i<list.size(); i++)
+        addDependentFiles(list.at(i), &files);
+    buildLevel(PYRAMID_LEVEL_L09_L13, files);
+    invalidateTileCache(files);
+
+    // coarser files are rebuilt from all their finer files when any of them was rebuilt
+    for (i=PYRAMID_LEVEL_L09_L13; i>PYRAMID_LEVEL_L00_L03; i--) {
+        list = files.toList();
+        width = (int)(360.0 / levelDegreeSize[i]);
+        files.clear();
+        for (index=0; index<list.size(); index++) {
+            x = list.at(index) % width;
+            y = list.at(index) / width;
+            files.insert(getFileIndex(i-1, x / PYRAMID_LEVEL_SPLIT, y / PYRAMID_LEVEL_SPLIT));
+        }
+        buildLevel(i-1, files);
+    }
+
+    if (!writeHeightRangeTable())
+        qWarning("Can't write %s", HEIGHT_RANGE_TABLE_FILE);
+
+    // failed files keep previous content - changed SRTM tiles must stay changed for next build
+    if (tasksFailed>0)
+        qWarning("%d files failed - %s not saved", tasksFailed, PYRAMID_MANIFEST_FILE);
+    else if (!manifest.save(pathOutput + PYRAMID_MANIFEST_FILE, srtmTileCache->availableFiles))
+        qWarning("Can't save %s", PYRAMID_MANIFEST_FILE);
+
+    qDebug("Pyramid built in %d s", time.elapsed() / 1000);
+}
+
+void CPyramidBuilder::invalidateTileCache(const QSet<int> &files)
+{
+    QFile file(pathOutput + PYRAMID_TILE_CACHE_INVALIDATE_FILE);
+    QTextStream stream(&file);
+    QList<int> list = files.toList();
+    double lon, lat, size;
+    int i;
+
+    QDir().mkpath(pathOutput + PYRAMID_TILE_CACHE_DIR);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning("Can't open %s - delete tile cache of viewer manually", PYRAMID_TILE_CACHE_INVALIDATE_FILE);
+        return;
+    }
+
+    // areas of rebuilt L09-L13 files contain all rebuilt data of coarser levels,
+    // viewer drops terrains from these areas next time it opens tile cache
+    size = levelDegreeSize[PYRAMID_LEVEL_L09_L13];
+    for (i=0; i<list.size(); i++) {
+        getFileLonLat(PYRAMID_LEVEL_L09_L13, list.at(i), &lon, &lat);
+        stream << lon << " " << (lat - size) << " " << (lon + size) << " " << lat << "\n";
+    }
+    stream.flush();
+    file.close();
+}
+
+bool CPyramidBuilder::writeHeightRangeTable()
+{
+    QFile file(pathOutput + HEIGHT_RANGE_TABLE_FILE + ".tmp");
+    QDataStream stream(&file);
+    QFile rangeFile;
+    CHgtFile hgtFile;
+    CHeightRange heightRange;
+    QVector<quint64> keys, offsets;
+    QByteArray bytes;
+    quint64 indexOffset;
+    int size = levelSize[PYRAMID_LEVEL_L09_L13];
+    int width = (int)(360.0 / levelDegreeSize[PYRAMID_LEVEL_L09_L13]);
+    int height = (int)(180.0 / levelDegreeSize[PYRAMID_LEVEL_L09_L13]);
+    int index, x, y;
+
+    if (size!=HEIGHT_RANGE_FILE_SAMPLES || width!=(int)(360.0 / HEIGHT_RANGE_FILE_DEGREE_SIZE))
+        qFatal("Pyramid builder - L09-L13 files don't match height range table");
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning("Pyramid builder - can't create %s", qPrintable(file.fileName()));
+        return false;
+    }
+
+    // entries in file index order - index is sorted without sorting
+    file.seek(HEIGHT_RANGE_TABLE_HEADER_SIZE);
+    for (index=0; index<width*height; index++) {
+        if (!QFile::exists(getFilePath(PYRAMID_LEVEL_L09_L13, index)))
+            continue;                                   // sea level
+
+        rangeFile.setFileName(getHeightRangePath(index));
+        bytes.clear();
+        if (rangeFile.open(QIODevice::ReadOnly)) {
+            bytes = rangeFile.readAll();
+            rangeFile.close();
+        }
+
+        // files built before height ranges were kept - range is computed from HGT file once
+        if (bytes.size()!=HEIGHT_RANGE_ENTRY_BYTES) {
+            hgtFile.loadFile(getFilePath(PYRAMID_LEVEL_L09_L13, index), size, size);
+            heightRange.clear();
+            for (y=0; y<size; y++)
+                for (x=0; x<size; x++)
+                    heightRange.addSample(x, y, hgtFile.getHeight(x, y));
+            bytes = heightRange.toBytes();
+            if (rangeFile.open(QIODevice::WriteOnly)) {
+                rangeFile.write(bytes);
+                rangeFile.close();
+            }
+        }
+
+        keys.append(CHeightRangeTable::getFileIndex(index % width, index / width));
+        offsets.append(file.pos());
+        if (file.write(bytes)!=bytes.size()) {
+            file.close();
+            QFile::remove(file.fileName());
+            return false;
+        }
+    }
+
+    indexOffset = file.pos();
+    for (index=0; index<keys.size(); index++)
+        stream << keys.at(index) << offsets.at(index);
+
+    file.seek(0);
+    stream << (quint32)HEIGHT_RANGE_TABLE_MAGIC << (quint32)HEIGHT_RANGE_TABLE_VERSION
+           << (quint32)HEIGHT_RANGE_FILE_SAMPLES << (quint32)HEIGHT_RANGE_CHUNK_INTERVALS;
+    stream << indexOffset << (quint64)keys.size();
+    file.close();
+    if (stream.status()!=QDataStream::Ok) {
+        QFile::remove(file.fileName());
+        return false;
+    }
+
+    // table is replaced only when new one is complete
+    QFile::remove(pathOutput + HEIGHT_RANGE_TABLE_FILE);
+    if (!QFile::rename(file.fileName(), pathOutput + HEIGHT_RANGE_TABLE_FILE))
+        return false;
+
+    qDebug("Height range table written: %d files", keys.size());
+
+    return true;
+}
+
+void CPyramidBuilder::buildLevel(int level, const QSet<int> &files)
+{
+    QList<int> list = files.toList();
+    int i, failedBefore;
+
+    QDir().mkpath(pathOutput + levelDir[level]);
+
+    mutex.lock();
+    filesWritten.clear();
+    tasksCount = list.size();
+    tasksDone = 0;
+    failedBefore = tasksFailed;
+    mutex.unlock();
+
+    // files in row order - neighbor tasks share most of SRTM tiles
+    qSort(list);
+    for (i=0; i<list.size(); i++)
+        QThreadPool::globalInstance()->start(new CPyramidTask(this, level, list.at(i)));
+    QThreadPool::globalInstance()->waitForDone();
+
+    failedBefore = tasksFailed - failedBefore;
+    qDebug("%s %d files written, %d without data, %d failed", qPrintable(levelDir[level]), filesWritten.size(), tasksCount - filesWritten.size() - failedBefore, failedBefore);
+}
+
+void CPyramidBuilder::taskDone(int level, int index, bool fileWritten, bool failed)
+{
+    QMutexLocker locker(&mutex);
+
+    if (fileWritten)
+        filesWritten.insert(index);
+    if (failed)
+        tasksFailed++;
+    tasksDone++;
+
+    if (tasksDone % 50 == 0)
+        qDebug("%s %d / %d", qPrintable(levelDir[level]), tasksDone, tasksCount);
+}
@@ -0,0 +1,95 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CPYRAMIDBUILDER_H
+#define CPYRAMIDBUILDER_H
+
+#include <QString>
+#include <QSet>
+#include <QMutex>
+#include "CSrtmTileCache.h"
+
+#define PYRAMID_LEVEL_L00_L03          0        // same order as HGT_SOURCE_xxx in CCacheManager
+#define PYRAMID_LEVEL_L04_L08          1
+#define PYRAMID_LEVEL_L09_L13          2
+#define PYRAMID_LEVELS                 3
+#define PYRAMID_LEVEL_STEP            32        // samples of finer level between two samples of coarser level
+#define PYRAMID_LEVEL_SPLIT            4        // files of finer level along one side of coarser level file
+#define PYRAMID_TILE_CACHE_DIR                 "TileCache/"                // same as CTileDiskCache of viewer
+#define PYRAMID_TILE_CACHE_INVALIDATE_FILE     "TileCache/tiles.inv"
+
+// builds L00-L03, L04-L08 and L09-L13 HGT files from SRTM dataset - each output
+// file is one task in QThreadPool, levels are built from the finest one and only
+// files depending on SRTM tiles changed since last build are rebuilt
+class CPyramidBuilder
+{
+public:
+    CPyramidBuilder(const QString &srtmPath, const QString &outputPath, int maxTilesInMemory);
+    ~CPyramidBuilder();
+
+    CSrtmTileCache *srtmTileCache;
+    int levelSize[PYRAMID_LEVELS];              // same as HGT_SOURCE_SIZE_xxx
+    double levelDegreeSize[PYRAMID_LEVELS];     // same as HGT_SOURCE_DEGREE_SIZE_xxx
+
+    void build(bool fullRebuild);
+    void taskDone(int level, int index, bool fileWritten, bool failed);
+    QString getFilePath(int level, int index);
+    QString getHeightRangePath(int index);
+    void getFileLonLat(int level, int index, double *lon, double *lat);
+    int getFileIndex(int level, int x, int y);
+
+private:
+    QMutex mutex;
+    QString pathOutput;
+    QString levelDir[PYRAMID_LEVELS];
+    QSet<int> filesWritten;                     // files written at currently built level
+    int tasksCount;
+    int tasksDone;
+    int tasksFailed;                            // write errors since build start - manifest is not saved
+
+    void addDependentFiles(int tileIndex, QSet<int> *files);
+    void buildLevel(int level, const QSet<int> &files);
+    void invalidateTileCache(const QSet<int> &files);
+    bool writeHeightRangeTable();
+};
+
+#endif // CPYRAMIDBUILDER_H
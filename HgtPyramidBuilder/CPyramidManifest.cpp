@@ -0,0 +1,128 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QFile>
+#include <QTextStream>
+#include <QStringList>
+#include <QDateTime>
+#include "CPyramidManifest.h"
+
+CPyramidManifest::CPyramidManifest()
+{
+}
+
+bool CPyramidManifest::load(const QString &fileName)
+{
+    QFile file(fileName);
+    QTextStream stream(&file);
+    CPyramidManifestEntry entry;
+    QStringList fields;
+    QString line;
+
+    entries.clear();
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    // one SRTM file per line: tile index, file name, size, modification time
+    while (!stream.atEnd()) {
+        line = stream.readLine();
+        fields = line.split(' ');
+        if (fields.size()!=4)
+            continue;
+
+        entry.name = fields.at(1);
+        entry.size = fields.at(2).toLongLong();
+        entry.lastModified = fields.at(3).toUInt();
+        entries.insert(fields.at(0).toInt(), entry);
+    }
+    file.close();
+
+    return true;
+}
+
+bool CPyramidManifest::save(const QString &fileName, const QHash<int, QFileInfo> &files)
+{
+    QFile file(fileName + ".tmp");
+    QTextStream stream(&file);
+    QHash<int, QFileInfo>::const_iterator i;
+
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    for (i=files.constBegin(); i!=files.constEnd(); ++i) {
+        stream << i.key() << " " << i.value().fileName() << " " << i.value().size() << " "
+               << i.value().lastModified().toTime_t() << "\n";
+    }
+    stream.flush();
+    file.close();
+
+    // manifest is replaced only when it is complete
+    QFile::remove(fileName);
+    return QFile::rename(fileName + ".tmp", fileName);
+}
+
+QSet<int> CPyramidManifest::getChangedTiles(const QHash<int, QFileInfo> &files)
+{
+    QSet<int> changed;
+    QHash<int, QFileInfo>::const_iterator i;
+    QHash<int, CPyramidManifestEntry>::const_iterator j;
+    CPyramidManifestEntry entry;
+
+    // new and modified files
+    for (i=files.constBegin(); i!=files.constEnd(); ++i) {
+        if (!entries.contains(i.key())) {
+            changed.insert(i.key());
+            continue;
+        }
+        entry = entries.value(i.key());
+        if (entry.size!=i.value().size() || entry.lastModified!=i.value().lastModified().toTime_t())
+            changed.insert(i.key());
+    }
+
+    // removed files - area becomes sea level
+    for (j=entries.constBegin(); j!=entries.constEnd(); ++j) {
+        if (!files.contains(j.key()))
+            changed.insert(j.key());
+    }
+
+    return changed;
+}
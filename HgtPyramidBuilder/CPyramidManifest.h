@@ -0,0 +1,76 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CPYRAMIDMANIFEST_H
+#define CPYRAMIDMANIFEST_H
+
+#include <QString>
+#include <QHash>
+#include <QSet>
+#include <QFileInfo>
+
+#define PYRAMID_MANIFEST_FILE      "pyramid.manifest"      // SRTM files used by last build
+
+class CPyramidManifestEntry
+{
+public:
+    QString name;
+    qint64 size;
+    unsigned int lastModified;
+};
+
+// SRTM files pyramid was built from - changed, new and removed files since
+// last build are found by comparing manifest with current dataset
+class CPyramidManifest
+{
+public:
+    CPyramidManifest();
+
+    bool load(const QString &fileName);
+    bool save(const QString &fileName, const QHash<int, QFileInfo> &files);
+    QSet<int> getChangedTiles(const QHash<int, QFileInfo> &files);
+
+private:
+    QHash<int, CPyramidManifestEntry> entries;
+};
+
+#endif // CPYRAMIDMANIFEST_H
@@ -0,0 +1,276 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QFile>
+#include <QByteArray>
+#include <math.h>
+#include "CPyramidTask.h"
+#include "CHgtFile.h"
+
+CPyramidTask::CPyramidTask(CPyramidBuilder *pyramidBuilder, int lvl, int fileIndex)
+{
+    builder = pyramidBuilder;
+    level = lvl;
+    index = fileIndex;
+}
+
+void CPyramidTask::run()
+{
+    QString fileName = builder->getFilePath(level, index);
+    QString tmpFileName = fileName + ".tmp";
+    bool fileWritten, fileComplete;
+
+    if (level==PYRAMID_LEVEL_L09_L13)
+        fileComplete = resampleSrtm(tmpFileName, &fileWritten);
+    else
+        fileComplete = decimateLevel(tmpFileName, &fileWritten);
+
+    // write error (full disk) - file from previous build is kept and task is retried by next build
+    if (!fileComplete) {
+        QFile::remove(tmpFileName);
+        builder->taskDone(level, index, false, true);
+        return;
+    }
+
+    // file from previous build is replaced only when new one is complete
+    QFile::remove(fileName);
+    if (fileWritten && !QFile::rename(tmpFileName, fileName)) {
+        qWarning("Pyramid task - can't rename %s", qPrintable(tmpFileName));
+        QFile::remove(tmpFileName);
+        builder->taskDone(level, index, false, true);
+        return;
+    }
+    QFile::remove(tmpFileName);
+
+    if (level==PYRAMID_LEVEL_L09_L13)
+        saveHeightRange(fileWritten);
+
+    builder->taskDone(level, index, fileWritten, false);
+}
+
+bool CPyramidTask::resampleSrtm(const QString &fileName, bool *notEmpty)
+{
+    QFile file(fileName);
+    QByteArray row;
+    double lon, lat, x0, y0, step;
+    int size = builder->levelSize[PYRAMID_LEVEL_L09_L13];
+    int i, j, x, y, hgt;
+    bool fileComplete;
+
+    builder->getFileLonLat(level, index, &lon, &lat);
+
+    // SRTM samples are 1/1200 deg, L09-L13 samples are 3.75/4096 deg (90m to 103m)
+    step = (builder->levelDegreeSize[level] / (size - 1)) * (SRTM_TILE_SIZE - 1);
+    x0 = lon * (SRTM_TILE_SIZE - 1);
+    y0 = (90.0 - lat) * (SRTM_TILE_SIZE - 1);
+
+    // tiles around file are pinned in cache until file is done
+    tilesX = ((int)floor(lon) - 1) * (SRTM_TILE_SIZE - 1);
+    tilesY = ((int)floor(90.0 - lat) - 1) * (SRTM_TILE_SIZE - 1);
+    for (j=0; j<PYRAMID_TASK_TILES; j++)
+        for (i=0; i<PYRAMID_TASK_TILES; i++)
+            tiles[j][i] = builder->srtmTileCache->acquire((int)floor(lon) - 1 + i, (int)ceil(lat) + 1 - j);
+
+    // output is streamed row by row - only one row in memory
+    (*notEmpty) = false;
+    fileComplete = false;
+    heightRange.clear();
+    row.resize(size*2);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning("Pyramid task - can't create %s", qPrintable(fileName));
+    } else {
+        fileComplete = true;
+        for (y=0; y<size && fileComplete; y++) {
+            for (x=0; x<size; x++) {
+                hgt = getBicubicHeight(x0 + x*step, y0 + y*step);
+                if (hgt!=0) (*notEmpty) = true;
+                heightRange.addSample(x, y, hgt);
+                row[2*x]     = (char)((hgt & 0xFF00) >> 8);
+                row[2*x + 1] = (char)(hgt & 0xFF);
+            }
+            if (file.write(row)!=row.size()) {
+                qWarning("Pyramid task - can't write %s", qPrintable(fileName));
+                fileComplete = false;
+            }
+        }
+        file.close();
+    }
+
+    for (j=0; j<PYRAMID_TASK_TILES; j++)
+        for (i=0; i<PYRAMID_TASK_TILES; i++)
+            builder->srtmTileCache->release(tiles[j][i]);
+
+    return fileComplete;
+}
+
+void CPyramidTask::saveHeightRange(bool fileWritten)
+{
+    QString fileName = builder->getHeightRangePath(index);
+    QFile file(fileName + ".tmp");
+
+    // range of file without data isn't kept - it is sea level in height range table
+    QFile::remove(fileName);
+    if (!fileWritten)
+        return;
+
+    if (!file.open(QIODevice::WriteOnly) || file.write(heightRange.toBytes())!=HEIGHT_RANGE_ENTRY_BYTES) {
+        qWarning("Pyramid task - can't write %s", qPrintable(file.fileName()));
+        file.close();
+        QFile::remove(file.fileName());
+        return;
+    }
+    file.close();
+
+    if (!QFile::rename(file.fileName(), fileName))
+        qWarning("Pyramid task - can't rename %s", qPrintable(file.fileName()));
+}
+
+bool CPyramidTask::decimateLevel(const QString &fileName, bool *notEmpty)
+{
+    CHgtFile output;
+    CHgtFile input;
+    QString inputName;
+    quint16 *buffer;
+    int size = builder->levelSize[level];
+    int inputSize = builder->levelSize[level+1];
+    int partSize = (inputSize - 1) / PYRAMID_LEVEL_STEP + 1;
+    int width = (int)(360.0 / builder->levelDegreeSize[level]);
+    int inputX = (index % width) * PYRAMID_LEVEL_SPLIT;
+    int inputY = (index / width) * PYRAMID_LEVEL_SPLIT;
+    int x, y;
+
+    output.init(size, size);
+    for (y=0; y<size; y++)
+        for (x=0; x<size; x++)
+            output.setHeight(x, y, 0);
+
+    // every 32-nd sample of finer level - same as HGT skipping inside one level,
+    // edge samples of neighbor parts are the same in both files
+    buffer = new quint16[partSize*partSize];
+    for (y=0; y<PYRAMID_LEVEL_SPLIT; y++)
+        for (x=0; x<PYRAMID_LEVEL_SPLIT; x++) {
+            inputName = builder->getFilePath(level+1, builder->getFileIndex(level+1, inputX + x, inputY + y));
+            if (!QFile::exists(inputName))
+                continue;                               // sea level
+
+            input.fileOpen(inputName, inputSize, inputSize);
+            input.fileGetHeightBlock(buffer, 0, 0, partSize, partSize, PYRAMID_LEVEL_STEP);
+            input.fileClose();
+            output.setHeightBlock(buffer, x*(partSize-1), y*(partSize-1), partSize, partSize, 1);
+        }
+    delete []buffer;
+
+    (*notEmpty) = false;
+    for (y=0; y<size && !(*notEmpty); y++)
+        for (x=0; x<size; x++)
+            if (output.getHeight(x, y)!=0) {
+                (*notEmpty) = true;
+                break;
+            }
+
+    if ((*notEmpty) && !output.saveFile(fileName)) {
+        qWarning("Pyramid task - can't write %s", qPrintable(fileName));
+        return false;
+    }
+
+    return true;
+}
+
+int CPyramidTask::getSrtmHeight(int x, int y)
+{
+    CSrtmTile *tile;
+    int tx, ty;
+
+    x -= tilesX;
+    y -= tilesY;
+    tx = x / (SRTM_TILE_SIZE - 1);
+    ty = y / (SRTM_TILE_SIZE - 1);
+    if (tx<0 || ty<0 || tx>=PYRAMID_TASK_TILES || ty>=PYRAMID_TASK_TILES)
+        qFatal("Pyramid task - SRTM sample outside of pinned tiles");
+
+    tile = tiles[ty][tx];
+    if (tile==0)
+        return 0;                                       // no SRTM file - sea level
+
+    return tile->height[(y % (SRTM_TILE_SIZE - 1))*SRTM_TILE_SIZE + (x % (SRTM_TILE_SIZE - 1))];
+}
+
+double CPyramidTask::getCubicWeight(double t)
+{
+    // Catmull-Rom spline kernel
+    t = fabs(t);
+    if (t<1.0) return 1.5*t*t*t - 2.5*t*t + 1.0;
+    if (t<2.0) return -0.5*t*t*t + 2.5*t*t - 4.0*t + 2.0;
+    return 0.0;
+}
+
+int CPyramidTask::getBicubicHeight(double x, double y)
+{
+    int ix = (int)floor(x);
+    int iy = (int)floor(y);
+    double wx[4], wy[4];
+    double sum;
+    int i, j, hgt, nearest;
+    bool voidFound;
+
+    for (i=0; i<4; i++) {
+        wx[i] = getCubicWeight(x - (ix - 1 + i));
+        wy[i] = getCubicWeight(y - (iy - 1 + i));
+    }
+
+    sum = 0.0;
+    voidFound = false;
+    for (j=0; j<4; j++)
+        for (i=0; i<4; i++) {
+            hgt = getSrtmHeight(ix - 1 + i, iy - 1 + j);
+            if (hgt==SRTM_TILE_VOID) voidFound = true;
+            sum += wx[i] * wy[j] * hgt;
+        }
+
+    // no data near sample - nearest sample is used when it has data
+    if (voidFound) {
+        nearest = getSrtmHeight((int)floor(x + 0.5), (int)floor(y + 0.5));
+        return (nearest==SRTM_TILE_VOID) ? 0 : nearest;
+    }
+
+    return (int)floor(sum + 0.5);
+}
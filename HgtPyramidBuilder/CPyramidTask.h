@@ -0,0 +1,78 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CPYRAMIDTASK_H
+#define CPYRAMIDTASK_H
+
+#include <QRunnable>
+#include "CPyramidBuilder.h"
+#include "CSrtmTileCache.h"
+#include "CHeightRangeTable.h"
+
+#define PYRAMID_TASK_TILES           7          // SRTM tiles along one side of L09-L13 file with bicubic margin
+
+// builds one HGT file of pyramid - L09-L13 from SRTM tiles, coarser levels from finer level files
+class CPyramidTask : public QRunnable
+{
+public:
+    CPyramidTask(CPyramidBuilder *pyramidBuilder, int lvl, int fileIndex);
+
+    void run();
+
+private:
+    CPyramidBuilder *builder;
+    int level;
+    int index;
+    CSrtmTile *tiles[PYRAMID_TASK_TILES][PYRAMID_TASK_TILES];
+    int tilesX;                                 // top left corner of tiles table in SRTM samples
+    int tilesY;
+    CHeightRange heightRange;                   // of L09-L13 file - collected while rows are written
+
+    bool resampleSrtm(const QString &fileName, bool *notEmpty);
+    bool decimateLevel(const QString &fileName, bool *notEmpty);
+    void saveHeightRange(bool fileWritten);
+    int getSrtmHeight(int x, int y);
+    int getBicubicHeight(double x, double y);
+    static double getCubicWeight(double t);
+};
+
+#endif // CPYRAMIDTASK_H
@@ -0,0 +1,211 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfoList>
+#include <QMutexLocker>
+#include "CSrtmTileCache.h"
+
+CSrtmTile::CSrtmTile()
+{
+    lon = 0;
+    lat = 0;
+    height = 0;
+    pinCount = 0;
+    lastUse = 0;
+}
+
+CSrtmTile::~CSrtmTile()
+{
+    if (height!=0)
+        delete []height;
+}
+
+CSrtmTileCache::CSrtmTileCache(const QString &path, int maxTilesInMemory)
+{
+    QDir dir;
+    QFileInfo fileInfo;
+    QFileInfoList list;
+    QString name;
+    int i, lon, lat, index;
+
+    pathSRTM = path;
+    maxTiles = maxTilesInMemory;
+    useCounter = 0;
+
+    // SRTM file name is lower left corner, for example N50E016.hgt
+    dir.setPath(pathSRTM);
+    dir.setFilter(QDir::Files | QDir::NoSymLinks);
+    dir.setSorting(QDir::Name);
+    list = dir.entryInfoList();
+
+    for (i=0; i<list.size(); i++) {
+        fileInfo = list.at(i);
+        name = fileInfo.fileName().toUpper();
+        if (fileInfo.size()!=SRTM_TILE_SIZE*SRTM_TILE_SIZE*2 || fileInfo.suffix().toLower()!="hgt" || name.length()!=11)
+            continue;
+
+        lat = name.mid(1, 2).toInt();
+        lon = name.mid(4, 3).toInt();
+        if (name.at(0)==QChar('S')) lat *= -1;
+        if (name.at(3)==QChar('W')) lon = 360 - lon;
+        lat = lat + 1;
+
+        index = getTileIndex(lon, lat);
+        availableFiles.insert(index, fileInfo);
+    }
+}
+
+CSrtmTileCache::~CSrtmTileCache()
+{
+    QHash<int, CSrtmTile *>::iterator i;
+
+    for (i=tiles.begin(); i!=tiles.end(); ++i)
+        delete i.value();
+}
+
+int CSrtmTileCache::getTileIndex(int lon, int lat)
+{
+    return (90 - lat)*360 + lon;
+}
+
+void CSrtmTileCache::getTileLonLat(int index, int *lon, int *lat)
+{
+    (*lon) = index % 360;
+    (*lat) = 90 - index / 360;
+}
+
+CSrtmTile *CSrtmTileCache::acquire(int lon, int lat)
+{
+    CSrtmTile *tile;
+    int index;
+
+    // longitude of tiles behind 360.0 comes from the beginning
+    lon = lon % 360;
+    if (lon<0) lon += 360;
+    if (lat>90 || lat<=-90)
+        return 0;
+    index = getTileIndex(lon, lat);
+
+    mutex.lock();
+    if (!availableFiles.contains(index)) {
+        mutex.unlock();
+        return 0;                           // no SRTM file - sea level
+    }
+
+    tile = tiles.value(index, 0);
+    if (tile==0) {
+        tile = new CSrtmTile();
+        tile->lon = lon;
+        tile->lat = lat;
+        tiles.insert(index, tile);
+    }
+    tile->pinCount++;
+    tile->lastUse = ++useCounter;
+    removeNotPinned();
+    mutex.unlock();
+
+    // other tiles can be found while this one is read from disk
+    tile->mutex.lock();
+    if (tile->height==0)
+        readTile(tile);
+    tile->mutex.unlock();
+
+    return tile;
+}
+
+void CSrtmTileCache::release(CSrtmTile *tile)
+{
+    QMutexLocker locker(&mutex);
+
+    if (tile==0)
+        return;
+    if (tile->pinCount<=0)
+        qFatal("SRTM tile cache - release of not pinned tile");
+    tile->pinCount--;
+    removeNotPinned();
+}
+
+void CSrtmTileCache::readTile(CSrtmTile *tile)
+{
+    QFile file(availableFiles.value(getTileIndex(tile->lon, tile->lat)).filePath());
+    unsigned char *bytes;
+    int i;
+
+    tile->height = new qint16[SRTM_TILE_SIZE*SRTM_TILE_SIZE];
+    bytes = (unsigned char *)tile->height;
+
+    if (!file.open(QIODevice::ReadOnly) || file.read((char *)bytes, SRTM_TILE_SIZE*SRTM_TILE_SIZE*2)!=SRTM_TILE_SIZE*SRTM_TILE_SIZE*2) {
+        qWarning("SRTM tile cache - can't read %s, used as sea level", qPrintable(file.fileName()));
+        for (i=0; i<SRTM_TILE_SIZE*SRTM_TILE_SIZE; i++)
+            tile->height[i] = 0;
+        return;
+    }
+
+    // SRTM files are big endian
+    for (i=0; i<SRTM_TILE_SIZE*SRTM_TILE_SIZE; i++)
+        tile->height[i] = (qint16)((bytes[2*i] << 8) + bytes[2*i + 1]);
+}
+
+void CSrtmTileCache::removeNotPinned()
+{
+    QHash<int, CSrtmTile *>::iterator i, oldest;
+    bool found;
+
+    while (tiles.size()>maxTiles) {
+        found = false;
+        for (i=tiles.begin(); i!=tiles.end(); ++i) {
+            if (i.value()->pinCount>0)
+                continue;
+            if (!found || i.value()->lastUse < oldest.value()->lastUse) {
+                oldest = i;
+                found = true;
+            }
+        }
+        if (!found)
+            return;                         // all tiles in use - limit is exceeded until some are released
+
+        delete oldest.value();
+        tiles.erase(oldest);
+    }
+}
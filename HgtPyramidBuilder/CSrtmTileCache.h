@@ -0,0 +1,95 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CSRTMTILECACHE_H
+#define CSRTMTILECACHE_H
+
+#include <QString>
+#include <QHash>
+#include <QMutex>
+#include <QFileInfo>
+
+#define SRTM_TILE_SIZE              1201        // samples along one side of SRTM file
+#define SRTM_TILE_VOID            -32768        // no data sample in SRTM file
+
+class CSrtmTile
+{
+public:
+    CSrtmTile();
+    ~CSrtmTile();
+
+    QMutex mutex;               // locked while tile is read from disk
+    int lon;                    // top left corner
+    int lat;
+    qint16 *height;             // 0 until tile is read
+    int pinCount;               // tasks using this tile - pinned tiles are never removed
+    unsigned int lastUse;
+};
+
+// SRTM tiles read by pyramid tasks - least recently used unpinned tiles are
+// removed when there are more than maxTiles tiles in memory
+class CSrtmTileCache
+{
+public:
+    CSrtmTileCache(const QString &path, int maxTilesInMemory);
+    ~CSrtmTileCache();
+
+    QHash<int, QFileInfo> availableFiles;       // SRTM files found in dataset by tile index
+
+    CSrtmTile *acquire(int lon, int lat);
+    void release(CSrtmTile *tile);
+
+    static int getTileIndex(int lon, int lat);
+    static void getTileLonLat(int index, int *lon, int *lat);
+
+private:
+    QMutex mutex;
+    QString pathSRTM;
+    QHash<int, CSrtmTile *> tiles;
+    int maxTiles;
+    unsigned int useCounter;
+
+    void readTile(CSrtmTile *tile);
+    void removeNotPinned();
+};
+
+#endif // CSRTMTILECACHE_H
@@ -0,0 +1,299 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QDataStream>
+#include <QFileInfo>
+#include <QDateTime>
+#include <math.h>
+#include <string.h>
+#include "CTextureTileWriter.h"
+#include "CPyramidBuilder.h"
+#include "CBc1Codec.h"
+#include "CTileFileName.h"
+
+CTextureTileWriter::CTextureTileWriter(const QString &texturesPath, bool compressTiles)
+{
+    int i;
+
+    pathTextures = texturesPath;
+    compress = compressTiles;
+    currentSource = -1;
+
+    sourceDir[0] = "L00_L02/";
+    sourceDir[1] = "L03_L05/";
+    sourceDir[2] = "L06_L08/";
+    sourceDir[3] = "L09_L10/";
+    sourcePxSize[0] = 96;
+    sourcePxSize[1] = 768;
+    sourcePxSize[2] = 6144;
+    sourcePxSize[3] = 24576;
+
+    for (i=0; i<=2; i++)  sourceLookUp[i] = 0;
+    for (i=3; i<=5; i++)  sourceLookUp[i] = 1;
+    for (i=6; i<=8; i++)  sourceLookUp[i] = 2;
+    for (i=9; i<=10; i++) sourceLookUp[i] = 3;
+
+    for (i=0; i<=2; i++)  skippingLookUp[i] = (int)pow(2.0, 2-i);
+    for (i=3; i<=5; i++)  skippingLookUp[i] = (int)pow(2.0, 5-i);
+    for (i=6; i<=8; i++)  skippingLookUp[i] = (int)pow(2.0, 8-i);
+    skippingLookUp[9]  = 2;
+    skippingLookUp[10] = 1;
+
+    for (i=0; i<TEXTURE_SOURCE_FILES; i++) {
+        available[i] = false;
+        tiled[i] = false;
+    }
+}
+
+void CTextureTileWriter::openSource(int source)
+{
+    QString name;
+    QFileInfo fileInfo, rawFileInfo;
+    qint64 rawBytes = 3*((qint64)sourcePxSize[source])*sourcePxSize[source];
+    int i;
+
+    if (source==currentSource)
+        return;
+    closeSource();
+
+    // .rawt file is used instead of .raw file when it isn't older like in CCacheManager::setTextureAvailable
+    for (i=0; i<TEXTURE_SOURCE_FILES; i++) {
+        name = pathTextures + sourceDir[source] +
+               CTileFileName::getBaseName((i % 8)*TEXTURE_DEGREE_SIZE, 90.0 - (i / 8)*TEXTURE_DEGREE_SIZE);
+
+        fileInfo.setFile(name + "." + RAW_TILED_SUFFIX);
+        rawFileInfo.setFile(name + ".raw");
+        if (fileInfo.exists() && fileInfo.size()==rawBytes + RAW_TILED_HEADER_SIZE &&
+            (!rawFileInfo.exists() || fileInfo.lastModified().toTime_t()>=rawFileInfo.lastModified().toTime_t())) {
+            available[i] = tiledFiles[i].fileOpen(fileInfo.filePath(), sourcePxSize[source]);
+            tiled[i] = available[i];
+            if (available[i])
+                continue;
+        }
+        fileInfo = rawFileInfo;
+        if (fileInfo.exists() && fileInfo.size()==rawBytes) {
+            rawFiles[i].fileOpen(fileInfo.filePath(), sourcePxSize[source], sourcePxSize[source]);
+            available[i] = true;
+        }
+    }
+
+    currentSource = source;
+}
+
+void CTextureTileWriter::closeSource()
+{
+    int i;
+
+    for (i=0; i<TEXTURE_SOURCE_FILES; i++) {
+        if (available[i]) {
+            if (tiled[i])
+                tiledFiles[i].fileClose(); else
+                rawFiles[i].fileClose();
+        }
+        available[i] = false;
+        tiled[i] = false;
+    }
+
+    currentSource = -1;
+}
+
+bool CTextureTileWriter::buildTile(int lod, int tx, int ty, uchar *rgb)
+{
+    CRawPixel window[TEXTURE_TILE_SIZE*TEXTURE_TILE_SIZE];
+    CRawPixel empty(TEXTURE_EMPTY_COLOR);
+    double degreeSize = 60.0 / pow(2.0, lod);
+    int pxSize = sourcePxSize[sourceLookUp[lod]];
+    int skip = skippingLookUp[lod];
+    int fileIndex[4];
+    int cellX, cellY, offLon, offLat;
+    int stopLon, stopLat;
+    int qx, qy, sx, sy, x0, y0, dx, dy, x, y, i;
+    bool hasAtLeastOneRawFile;
+
+    // RAW file with top left corner of terrain and pixel offset inside it, same as CCacheManager::findRawFiles
+    cellX = (int)floor(tx*degreeSize / TEXTURE_DEGREE_SIZE);
+    cellY = (int)floor(ty*degreeSize / TEXTURE_DEGREE_SIZE);
+    offLon = (int)( ((tx*degreeSize - cellX*TEXTURE_DEGREE_SIZE)/TEXTURE_DEGREE_SIZE) * ((double)pxSize) + 0.5 );
+    offLat = (int)( ((ty*degreeSize - cellY*TEXTURE_DEGREE_SIZE)/TEXTURE_DEGREE_SIZE) * ((double)pxSize) + 0.5 );
+
+    hasAtLeastOneRawFile = false;
+    for (i=0; i<4; i++) {
+        qx = i % 2;
+        qy = i / 2;
+        fileIndex[i] = -1;
+        if (cellY + qy < TEXTURE_SOURCE_FILES/8)
+            fileIndex[i] = (cellY + qy)*8 + (cellX + qx) % 8;
+        if (fileIndex[i]!=-1 && !available[fileIndex[i]])
+            fileIndex[i] = -1;
+        if (fileIndex[i]!=-1)
+            hasAtLeastOneRawFile = true;
+    }
+    if (!hasAtLeastOneRawFile)
+        return false;
+
+    // 32x32 window split between base RAW file and its right, bottom & right-bottom neighbors
+    stopLon = qMin((pxSize - offLon) / skip, TEXTURE_TILE_SIZE);
+    stopLat = qMin((pxSize - offLat) / skip, TEXTURE_TILE_SIZE);
+
+    for (i=0; i<4; i++) {
+        qx = i % 2;
+        qy = i / 2;
+        x0 = qx ? 0 : offLon;
+        y0 = qy ? 0 : offLat;
+        sx = qx ? TEXTURE_TILE_SIZE - stopLon : stopLon;
+        sy = qy ? TEXTURE_TILE_SIZE - stopLat : stopLat;
+        dx = qx ? stopLon : 0;
+        dy = qy ? stopLat : 0;
+        if (sx<=0 || sy<=0)
+            continue;
+
+        for (x=0; x<sx*sy; x++)
+            window[x] = empty;
+        if (fileIndex[i]!=-1) {
+            if (tiled[fileIndex[i]])
+                tiledFiles[fileIndex[i]].fileGetPixelBlock(window, x0, y0, sx, sy, skip); else
+                rawFiles[fileIndex[i]].fileGetPixelBlock(window, x0, y0, sx, sy, skip);
+        }
+
+        for (y=0; y<sy; y++)
+            memcpy(rgb + 3*((dy + y)*TEXTURE_TILE_SIZE + dx), window + y*sx, 3*sx);
+    }
+
+    return true;
+}
+
+bool CTextureTileWriter::writeLod(QFile *file, int lod)
+{
+    QByteArray tile;
+    uchar rgb[3*TEXTURE_TILE_SIZE*TEXTURE_TILE_SIZE];
+    double degreeSize = 60.0 / pow(2.0, lod);
+    int width = (int)(360.0 / degreeSize + 0.5);
+    int height = (int)(180.0 / degreeSize + 0.5);
+    int bits, i, x, y, count;
+    quint64 code, codes;
+
+    openSource(sourceLookUp[lod]);
+    tile.resize(CTextureTiles::getTileBytes(compress ? TEXTURE_TILES_FORMAT_BC1 : TEXTURE_TILES_FORMAT_RGB, TEXTURE_TILE_SIZE));
+
+    // Morton codes are visited in order so index is sorted by key without sorting
+    bits = 0;
+    while ((1 << bits) < qMax(width, height))
+        bits++;
+    codes = ((quint64)1) << (2*bits);
+
+    count = 0;
+    for (code=0; code<codes; code++) {
+        x = 0;
+        y = 0;
+        for (i=0; i<bits; i++) {
+            x |= (int)((code >> (2*i)) & 1) << i;
+            y |= (int)((code >> (2*i + 1)) & 1) << i;
+        }
+        if (x>=width || y>=height)
+            continue;
+        if (!buildTile(lod, x, y, rgb))
+            continue;                               // no RAW file - runtime uses shared empty texture
+
+        if (compress)
+            CBc1Codec::encodeMipmaps(rgb, TEXTURE_TILE_SIZE, (uchar *)tile.data()); else
+            memcpy(tile.data(), rgb, tile.size());
+
+        tileKeys.append(CTextureTiles::getTileKey(lod, x, y));
+        tileOffsets.append(file->pos());
+        if (file->write(tile)!=tile.size())
+            return false;
+        count++;
+    }
+
+    qDebug("LOD %d: %d texture tiles", lod, count);
+
+    return true;
+}
+
+bool CTextureTileWriter::write(const QString &fileName)
+{
+    QFile file(fileName + ".tmp");
+    QDataStream stream(&file);
+    quint64 indexOffset;
+    int lod, i;
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning("Texture tile writer - can't create %s", qPrintable(file.fileName()));
+        return false;
+    }
+
+    tileKeys.clear();
+    tileOffsets.clear();
+
+    // header is written again with index offset when tiles are done
+    file.seek(TEXTURE_TILES_HEADER_SIZE);
+    for (lod=0; lod<=TEXTURE_TILES_MAX_LOD; lod++) {
+        if (!writeLod(&file, lod)) {
+            closeSource();
+            file.close();
+            QFile::remove(file.fileName());
+            return false;
+        }
+    }
+    closeSource();
+
+    indexOffset = file.pos();
+    for (i=0; i<tileKeys.size(); i++)
+        stream << tileKeys.at(i) << tileOffsets.at(i);
+
+    file.seek(0);
+    stream << (quint32)TEXTURE_TILES_MAGIC << (quint32)TEXTURE_TILES_VERSION << (quint32)TEXTURE_TILE_SIZE
+           << (quint32)(compress ? TEXTURE_TILES_FORMAT_BC1 : TEXTURE_TILES_FORMAT_RGB);
+    stream << indexOffset << (quint64)tileKeys.size();
+    file.close();
+
+    // tiles file is replaced only when new one is complete
+    QFile::remove(fileName);
+    if (!QFile::rename(file.fileName(), fileName)) {
+        qWarning("Texture tile writer - can't rename %s", qPrintable(file.fileName()));
+        return false;
+    }
+
+    qDebug("Texture tiles written: %d tiles, %lld MB", tileKeys.size(), QFile(fileName).size() / (1024*1024));
+
+    return true;
+}
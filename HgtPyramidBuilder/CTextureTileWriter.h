@@ -0,0 +1,90 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CTEXTURETILEWRITER_H
+#define CTEXTURETILEWRITER_H
+
+#include <QString>
+#include <QFile>
+#include <QVector>
+#include "CRawFile.h"
+#include "CRawTiledFile.h"
+#include "CTextureTiles.h"
+
+#define TEXTURE_SOURCES                4        // same as TEX_SOURCE_xxx in CCacheManager
+#define TEXTURE_SOURCE_FILES          32        // 8 x 4 RAW files of 45 degrees
+#define TEXTURE_DEGREE_SIZE           45.00     // same as TEX_DEGREE_SIZE
+#define TEXTURE_TILE_SIZE             32        // same as TEX_TERRAIN_SIZE
+#define TEXTURE_EMPTY_COLOR     0xEEFFEE        // same as TEX_EMPTY_COLOR
+
+// resamples RAW texture files to one texture per terrain (LOD 0 - TEXTURE_TILES_MAX_LOD)
+// exactly like CCacheManager::buildTextureFromRawFiles does at runtime and writes them
+// to CTextureTiles file, tiles are optionally coded with CBc1Codec (BC1 with mipmaps)
+class CTextureTileWriter
+{
+public:
+    CTextureTileWriter(const QString &texturesPath, bool compressTiles);
+
+    bool write(const QString &fileName);
+
+private:
+    QString pathTextures;
+    bool compress;
+    QString sourceDir[TEXTURE_SOURCES];
+    int sourcePxSize[TEXTURE_SOURCES];                  // same as TEX_SOURCE_PX_SIZE_xxx
+    int sourceLookUp[TEXTURE_TILES_MAX_LOD + 1];        // same as CCacheManager::TEXsourceLookUp
+    int skippingLookUp[TEXTURE_TILES_MAX_LOD + 1];      // same as CCacheManager::TEXsourceSkippingLookUp
+    int currentSource;
+    CRawFile rawFiles[TEXTURE_SOURCE_FILES];            // RAW files of current source - all open at once
+    CRawTiledFile tiledFiles[TEXTURE_SOURCE_FILES];
+    bool available[TEXTURE_SOURCE_FILES];
+    bool tiled[TEXTURE_SOURCE_FILES];
+    QVector<quint64> tileKeys;
+    QVector<quint64> tileOffsets;
+
+    void openSource(int source);
+    void closeSource();
+    bool writeLod(QFile *file, int lod);
+    bool buildTile(int lod, int tx, int ty, uchar *rgb);
+};
+
+#endif // CTEXTURETILEWRITER_H
@@ -0,0 +1,52 @@
+#-------------------------------------------------
+#
+# Offline builder of L00-L03, L04-L08 and L09-L13
+# HGT files from NASA SRTM dataset and texture
+# of each terrain from RAW files
+#
+#-------------------------------------------------
+
+QT       += core
+QT       -= gui
+
+TARGET = HgtPyramidBuilder
+CONFIG   += console
+CONFIG   -= app_bundle
+TEMPLATE = app
+
+INCLUDEPATH += ../HgtReader
+
+SOURCES += main.cpp \
+    CPyramidBuilder.cpp \
+    CPyramidTask.cpp \
+    CSrtmTileCache.cpp \
+    CPyramidManifest.cpp \
+    CContainerWriter.cpp \
+    CTextureTileWriter.cpp \
+    ../HgtReader/CHgtFile.cpp \
+    ../HgtReader/CTerrainContainer.cpp \
+    ../HgtReader/CIndexedFile.cpp \
+    ../HgtReader/CHeightRangeTable.cpp \
+    ../HgtReader/CElevationCodec.cpp \
+    ../HgtReader/CRawFile.cpp \
+    ../HgtReader/CRawTiledFile.cpp \
+    ../HgtReader/CBc1Codec.cpp \
+    ../HgtReader/CTextureTiles.cpp
+
+HEADERS += CPyramidBuilder.h \
+    CPyramidTask.h \
+    CSrtmTileCache.h \
+    CPyramidManifest.h \
+    CContainerWriter.h \
+    CTextureTileWriter.h \
+    ../HgtReader/CHgtFile.h \
+    ../HgtReader/CTerrainContainer.h \
+    ../HgtReader/CIndexedFile.h \
+    ../HgtReader/CHeightRangeTable.h \
+    ../HgtReader/CElevationCodec.h \
+    ../HgtReader/CRawFile.h \
+    ../HgtReader/CRawTiledFile.h \
+    ../HgtReader/CBc1Codec.h \
+    ../HgtReader/CTextureTiles.h \
+    ../HgtReader/CIoCounters.h \
+    ../HgtReader/CTileFileName.h
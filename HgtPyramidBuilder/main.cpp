@@ -0,0 +1,111 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <QThreadPool>
+#include <QDebug>
+#include "CPyramidBuilder.h"
+#include "CContainerWriter.h"
+#include "CTextureTileWriter.h"
+
+#define PYRAMID_DEFAULT_TILES_IN_MEMORY    128      // about 370 MB of SRTM tiles
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QStringList args = a.arguments();
+    CPyramidBuilder *builder;
+    QString srtmPath, outputPath;
+    CContainerWriter *containerWriter;
+    CTextureTileWriter *textureTileWriter;
+    int tilesInMemory;
+    bool fullRebuild, container, compress, textures, bc1;
+
+    // -full rebuilds whole pyramid even when manifest of previous build exists,
+    // -container packs all levels to one file, -compress codes its chunks with CElevationCodec,
+    // -textures resamples RAW files from <output dir>/Textures to texture of each terrain, -bc1 codes them with CBc1Codec
+    fullRebuild = args.contains("-full");
+    container = args.contains("-container");
+    compress = args.contains("-compress");
+    textures = args.contains("-textures");
+    bc1 = args.contains("-bc1");
+    args.removeAll("-full");
+    args.removeAll("-container");
+    args.removeAll("-compress");
+    args.removeAll("-textures");
+    args.removeAll("-bc1");
+
+    if (args.size()<3) {
+        qDebug("usage: HgtPyramidBuilder [-full] [-container [-compress]] [-textures [-bc1]] <SRTM dir> <output dir> [threads] [SRTM tiles in memory]");
+        return 1;
+    }
+
+    srtmPath = args.at(1);
+    outputPath = args.at(2);
+    if (!srtmPath.endsWith("/") && !srtmPath.endsWith("\\")) srtmPath += "/";
+    if (!outputPath.endsWith("/") && !outputPath.endsWith("\\")) outputPath += "/";
+
+    if (args.size()>3 && args.at(3).toInt()>0)
+        QThreadPool::globalInstance()->setMaxThreadCount(args.at(3).toInt());
+    tilesInMemory = PYRAMID_DEFAULT_TILES_IN_MEMORY;
+    if (args.size()>4 && args.at(4).toInt()>0)
+        tilesInMemory = args.at(4).toInt();
+
+    qDebug("Threads: %d, SRTM tiles in memory: %d", QThreadPool::globalInstance()->maxThreadCount(), tilesInMemory);
+
+    builder = new CPyramidBuilder(srtmPath, outputPath, tilesInMemory);
+    builder->build(fullRebuild);
+    if (container) {
+        containerWriter = new CContainerWriter(builder, compress);
+        containerWriter->write(outputPath + TERRAIN_CONTAINER_FILE);
+        delete containerWriter;
+    }
+    if (textures) {
+        textureTileWriter = new CTextureTileWriter(outputPath + "Textures/", bc1);
+        textureTileWriter->write(outputPath + TEXTURE_TILES_FILE);
+        delete textureTileWriter;
+    }
+    delete builder;
+
+    return 0;
+}
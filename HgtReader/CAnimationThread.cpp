@@ -49,6 +49,11 @@ CAnimationThread::CAnimationThread(COpenGl *openGlPointer) : QThread(openGlPoint
     doTerminate = false;
     doAnimate = false;
     doBenchmark = false;
+    doRecordPath = false;
+    doReplayPath = false;
+    replayTick = 0;
+    cameraMoving = false;
+    cameraMoveNs = 0;
 
     benchmarkLon[0] = 20.088333; benchmarkLat[0] = 49.179444; benchmarkAlt[0] = CONST_EARTH_RADIUS + 2503.000;
     benchmarkLon[1] = 21.101202; benchmarkLat[1] = 47.123456; benchmarkAlt[1] = CONST_EARTH_RADIUS + 1500.0;
@@ -140,9 +145,100 @@ void CAnimationThread::manageBenchmark()
                                 benchmarkLon[posAnim+1], benchmarkLat[posAnim+1], benchmarkAlt[posAnim+1]);
 }
 
+void CAnimationThread::SLOTtoggleCameraPathRecording()
+{
+    bool recording;
+
+    doMutex.lock();
+    if (doReplayPath) {                  // replayed path would be recorded again
+        doMutex.unlock();
+        return;
+    }
+    doRecordPath = doRecordPath ? false : true;
+    recording = doRecordPath;
+    if (recording)
+        cameraPath.clear();
+    else
+        cameraPath.save(openGl->cacheManager.pathBase + CAMERA_PATH_FILE);
+    doMutex.unlock();
+
+    if (recording)
+        openGl->performance.addEventToHistory("[PATH RECORD START]");
+    else
+        openGl->performance.addEventToHistory(QString("[PATH RECORD STOP] ticks: ") + QString::number(cameraPath.getTicks()));
+}
+
+void CAnimationThread::SLOTstartCameraPathReplay()
+{
+    doMutex.lock();
+    if (doRecordPath || !cameraPath.load(openGl->cacheManager.pathBase + CAMERA_PATH_FILE)) {
+        doMutex.unlock();
+        return;
+    }
+    doAnimate = false;
+    doBenchmark = false;
+    doReplayPath = true;
+    replayTick = 0;
+    doMutex.unlock();
+
+    openGl->performance.resetHistory();
+    openGl->performance.enableSavingToHistory();
+    openGl->performance.addEventToHistory(QString("[PATH REPLAY START] ticks: ") + QString::number(cameraPath.getTicks()));
+}
+
+void CAnimationThread::manageCameraPath()
+{
+    CCameraPathSample sample;
+    bool replayFinished = false;
+
+    doMutex.lock();
+    if (doRecordPath)
+        cameraPath.record(&dss);
+    if (doReplayPath) {
+        // one recorded tick per animation tick - same camera states in same order as in recorded session
+        if (cameraPath.getSample(replayTick, &sample)) {
+            openGl->drawingState.setCameraPathSample(sample);
+            replayTick++;
+        } else {
+            doReplayPath = false;
+            replayFinished = true;
+        }
+    }
+    doMutex.unlock();
+
+    if (replayFinished) {
+        openGl->drawingState.stopCameraPathReplay();
+        openGl->performance.addEventToHistory("[PATH REPLAY STOP]");
+        openGl->performance.disableSavingToHistory();
+    }
+}
+
+void CAnimationThread::manageConvergence()
+{
+    bool moving;
+
+    moving = (dss.camPosition!=lastCamPosition || dss.camLookingDirectionNormal!=lastCamLookingDirectionNormal) ? true : false;
+    lastCamPosition = dss.camPosition;
+    lastCamLookingDirectionNormal = dss.camLookingDirectionNormal;
+
+    // camera stopped (user interaction, [ANIM STOP], end of path replay) - wait for full detail,
+    // next movement means that terrains loaded so far were not enough
+    if (moving) {
+        if (!cameraMoving)
+            openGl->performance.cancelConvergence();
+        cameraMoving = true;
+        cameraMoveNs = openGl->performance.getTimeNs();
+    } else if (cameraMoving) {
+        cameraMoving = false;
+        openGl->performance.startConvergence(cameraMoveNs);
+    }
+}
+
 void CAnimationThread::run()
 {
     openGl->drawingState.getDrawingStateSnapshot(&dss);      // get current scene state
+    lastCamPosition = dss.camPosition;
+    lastCamLookingDirectionNormal = dss.camLookingDirectionNormal;
 
     while (true) {
 
@@ -158,6 +254,8 @@ void CAnimationThread::run()
         openGl->drawingState.getCamera()->checkInteractKeys();       // interact keys
         animateEarthPoint();
         manageBenchmark();
+        manageCameraPath();
+        manageConvergence();
 
         msleep(ANIMATION_SPEED_MS);
         openGl->drawingState.getDrawingStateSnapshot(&dss);  // get current scene state
@@ -45,6 +45,7 @@
 
 #include <QThread>
 #include "COpenGl.h"
+#include "CCameraPath.h"
 
 
 #define BENCHMARK_LOCATIONS 6
@@ -66,6 +67,8 @@ public slots:
                                  double currEarthPointAlt, double animEarthPointLon,
                                  double animEarthPointLat, double animEarthPointAlt);
     void SLOTstartBenchmark();
+    void SLOTtoggleCameraPathRecording();
+    void SLOTstartCameraPathReplay();
 
 protected:
     void run();
@@ -92,8 +95,18 @@ private:
     double benchmarkAlt[BENCHMARK_LOCATIONS];
     int benchmarkPos;
     bool doBenchmark;
+    CCameraPath cameraPath;
+    bool doRecordPath;
+    bool doReplayPath;
+    int replayTick;
+    QVector3D lastCamPosition;              // camera in previous tick
+    QVector3D lastCamLookingDirectionNormal;
+    bool cameraMoving;
+    qint64 cameraMoveNs;                    // last tick when camera moved
 
     void manageBenchmark();
+    void manageCameraPath();
+    void manageConvergence();
     void animateEarthPoint();
 };
 
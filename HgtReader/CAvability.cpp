@@ -47,6 +47,8 @@ CAvability::CAvability()
 {
     available = false;
     name = 0;
+    lastModified = 0;
+    tiled = false;
 }
 
 CAvability::~CAvability()
@@ -55,11 +57,13 @@ CAvability::~CAvability()
         delete name;
 }
 
-void CAvability::setAvailable(const QString &n)
+void CAvability::setAvailable(const QString &n, unsigned int modified)
 {
     if (name==0)
         name = new QString(n); else
         (*name) = n;
 
+    lastModified = modified;
+    tiled = false;
     available = true;
 }
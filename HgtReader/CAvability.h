@@ -50,10 +50,12 @@ class CAvability
 public:
     bool available;
     QString *name;
+    unsigned int lastModified;          // file modification time (seconds since epoch)
+    bool tiled;                         // texture in CRawTiledFile layout
 
     CAvability();
     ~CAvability();
-    void setAvailable(const QString &n);
+    void setAvailable(const QString &n, unsigned int modified);
 };
 
 #endif // CAVABILITY_H
@@ -0,0 +1,256 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <string.h>
+#include <math.h>
+#include "CBc1Codec.h"
+
+int CBc1Codec::getImageBytes(int size)
+{
+    int blocks = (size + BC1_BLOCK_SIZE - 1) / BC1_BLOCK_SIZE;
+
+    return blocks*blocks*BC1_BLOCK_BYTES;
+}
+
+int CBc1Codec::getMipmapBytes(int size)
+{
+    int bytes = 0;
+
+    for (; size>=1; size/=2)
+        bytes += getImageBytes(size);
+
+    return bytes;
+}
+
+void CBc1Codec::getPalette(quint16 color0, quint16 color1, int *palette)
+{
+    int c;
+
+    // RGB565 to RGB888 with highest bits copied to lowest ones
+    palette[0] = ((color0 >> 11) << 3) | ((color0 >> 11) >> 2);
+    palette[1] = (((color0 >> 5) & 63) << 2) | (((color0 >> 5) & 63) >> 4);
+    palette[2] = ((color0 & 31) << 3) | ((color0 & 31) >> 2);
+    palette[3] = ((color1 >> 11) << 3) | ((color1 >> 11) >> 2);
+    palette[4] = (((color1 >> 5) & 63) << 2) | (((color1 >> 5) & 63) >> 4);
+    palette[5] = ((color1 & 31) << 3) | ((color1 & 31) >> 2);
+
+    for (c=0; c<3; c++) {
+        if (color0>color1) {
+            palette[6 + c] = (2*palette[c] + palette[3 + c]) / 3;
+            palette[9 + c] = (palette[c] + 2*palette[3 + c]) / 3;
+        } else {
+            palette[6 + c] = (palette[c] + palette[3 + c]) / 2;
+            palette[9 + c] = 0;
+        }
+    }
+}
+
+void CBc1Codec::encodeBlock(const uchar *rgb, int size, int bx, int by, uchar *block)
+{
+    int pixels[16*3];
+    int palette[4*3];
+    double mean[3], cov[6], axis[3], v[3];
+    double t, tMin, tMax, inset, length, end[6];
+    quint16 color0, color1, tmp;
+    quint32 indices;
+    int i, j, c, x, y, best, dist, bestDist, q[6];
+
+    // pixels of block, small mipmap levels (2x2, 1x1) are repeated to fill whole block
+    for (i=0; i<16; i++) {
+        x = qMin(bx*BC1_BLOCK_SIZE + i%4, size - 1);
+        y = qMin(by*BC1_BLOCK_SIZE + i/4, size - 1);
+        for (c=0; c<3; c++)
+            pixels[3*i + c] = rgb[3*(y*size + x) + c];
+    }
+
+    for (c=0; c<3; c++) {
+        mean[c] = 0.0;
+        for (i=0; i<16; i++)
+            mean[c] += pixels[3*i + c];
+        mean[c] /= 16.0;
+    }
+
+    // covariance matrix (rr, rg, rb, gg, gb, bb) and its principal axis by power iteration
+    for (j=0; j<6; j++) cov[j] = 0.0;
+    for (i=0; i<16; i++) {
+        v[0] = pixels[3*i + 0] - mean[0];
+        v[1] = pixels[3*i + 1] - mean[1];
+        v[2] = pixels[3*i + 2] - mean[2];
+        cov[0] += v[0]*v[0]; cov[1] += v[0]*v[1]; cov[2] += v[0]*v[2];
+        cov[3] += v[1]*v[1]; cov[4] += v[1]*v[2]; cov[5] += v[2]*v[2];
+    }
+    axis[0] = 1.0; axis[1] = 1.0; axis[2] = 1.0;
+    for (j=0; j<8; j++) {
+        v[0] = cov[0]*axis[0] + cov[1]*axis[1] + cov[2]*axis[2];
+        v[1] = cov[1]*axis[0] + cov[3]*axis[1] + cov[4]*axis[2];
+        v[2] = cov[2]*axis[0] + cov[4]*axis[1] + cov[5]*axis[2];
+        length = sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+        if (length<1e-9)
+            break;                              // one color block
+        for (c=0; c<3; c++) axis[c] = v[c] / length;
+    }
+
+    // end colors - extreme projections on axis moved a bit inside to reduce error of middle colors
+    tMin = 0.0;
+    tMax = 0.0;
+    for (i=0; i<16; i++) {
+        t = (pixels[3*i + 0] - mean[0])*axis[0] + (pixels[3*i + 1] - mean[1])*axis[1] + (pixels[3*i + 2] - mean[2])*axis[2];
+        if (t<tMin) tMin = t;
+        if (t>tMax) tMax = t;
+    }
+    inset = (tMax - tMin) / 16.0;
+    tMin += inset;
+    tMax -= inset;
+    for (c=0; c<3; c++) {
+        end[c]     = mean[c] + tMax*axis[c];
+        end[3 + c] = mean[c] + tMin*axis[c];
+    }
+
+    for (j=0; j<2; j++) {
+        q[3*j + 0] = qBound(0, (int)(end[3*j + 0]*31.0/255.0 + 0.5), 31);
+        q[3*j + 1] = qBound(0, (int)(end[3*j + 1]*63.0/255.0 + 0.5), 63);
+        q[3*j + 2] = qBound(0, (int)(end[3*j + 2]*31.0/255.0 + 0.5), 31);
+    }
+    color0 = (quint16)((q[0] << 11) | (q[1] << 5) | q[2]);
+    color1 = (quint16)((q[3] << 11) | (q[4] << 5) | q[5]);
+
+    // 4 color mode needs color0 > color1, same colors - all pixels use color0
+    if (color0<color1) {
+        tmp = color0;
+        color0 = color1;
+        color1 = tmp;
+    }
+    indices = 0;
+    if (color0!=color1) {
+        getPalette(color0, color1, palette);
+        for (i=0; i<16; i++) {
+            best = 0;
+            bestDist = 0x7FFFFFFF;
+            for (j=0; j<4; j++) {
+                dist = 0;
+                for (c=0; c<3; c++)
+                    dist += (pixels[3*i + c] - palette[3*j + c]) * (pixels[3*i + c] - palette[3*j + c]);
+                if (dist<bestDist) {
+                    bestDist = dist;
+                    best = j;
+                }
+            }
+            indices |= ((quint32)best) << (2*i);
+        }
+    }
+
+    // little endian like in DDS files
+    block[0] = (uchar)(color0 & 0xFF);
+    block[1] = (uchar)(color0 >> 8);
+    block[2] = (uchar)(color1 & 0xFF);
+    block[3] = (uchar)(color1 >> 8);
+    for (i=0; i<4; i++)
+        block[4 + i] = (uchar)((indices >> (8*i)) & 0xFF);
+}
+
+void CBc1Codec::decodeBlock(const uchar *block, int size, int bx, int by, uchar *rgb)
+{
+    int palette[4*3];
+    quint16 color0, color1;
+    quint32 indices;
+    int i, c, x, y, index;
+
+    color0 = (quint16)(block[0] | (block[1] << 8));
+    color1 = (quint16)(block[2] | (block[3] << 8));
+    indices = block[4] | (block[5] << 8) | (block[6] << 16) | ((quint32)block[7] << 24);
+    getPalette(color0, color1, palette);
+
+    for (i=0; i<16; i++) {
+        x = bx*BC1_BLOCK_SIZE + i%4;
+        y = by*BC1_BLOCK_SIZE + i/4;
+        if (x>=size || y>=size)
+            continue;
+        index = (indices >> (2*i)) & 3;
+        for (c=0; c<3; c++)
+            rgb[3*(y*size + x) + c] = (uchar)palette[3*index + c];
+    }
+}
+
+void CBc1Codec::encodeMipmaps(const uchar *rgb, int size, uchar *data)
+{
+    uchar *level, *next;
+    int blocks, bx, by, x, y, c, s;
+
+    level = new uchar[3*size*size];
+    memcpy(level, rgb, 3*size*size);
+
+    for (s=size; s>=1; s/=2) {
+        blocks = (s + BC1_BLOCK_SIZE - 1) / BC1_BLOCK_SIZE;
+        for (by=0; by<blocks; by++)
+            for (bx=0; bx<blocks; bx++) {
+                encodeBlock(level, s, bx, by, data);
+                data += BC1_BLOCK_BYTES;
+            }
+        if (s==1)
+            break;
+
+        // next mipmap level - average of 2x2 pixels like gluBuild2DMipmaps
+        next = new uchar[3*(s/2)*(s/2)];
+        for (y=0; y<s/2; y++)
+            for (x=0; x<s/2; x++)
+                for (c=0; c<3; c++)
+                    next[3*(y*(s/2) + x) + c] = (uchar)((level[3*((2*y)*s + 2*x) + c] + level[3*((2*y)*s + 2*x + 1) + c] +
+                                                         level[3*((2*y + 1)*s + 2*x) + c] + level[3*((2*y + 1)*s + 2*x + 1) + c] + 2) / 4);
+        delete []level;
+        level = next;
+    }
+
+    delete []level;
+}
+
+void CBc1Codec::decodeImage(const uchar *data, int size, uchar *rgb)
+{
+    int blocks = (size + BC1_BLOCK_SIZE - 1) / BC1_BLOCK_SIZE;
+    int bx, by;
+
+    // first mipmap level only
+    for (by=0; by<blocks; by++)
+        for (bx=0; bx<blocks; bx++) {
+            decodeBlock(data, size, bx, by, rgb);
+            data += BC1_BLOCK_BYTES;
+        }
+}
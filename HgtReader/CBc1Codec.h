@@ -0,0 +1,70 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CBC1CODEC_H
+#define CBC1CODEC_H
+
+#include <QtGlobal>
+
+#define BC1_BLOCK_SIZE           4          // block of 4x4 pixels
+#define BC1_BLOCK_BYTES          8          // two RGB565 end colors and 16 2-bit indices
+
+// software BC1 (DXT1) coder of RGB textures - image is coded with all its mipmap
+// levels (size x size ... 1x1) one after another, same layout as expected by
+// glCompressedTexImage2D for each level, so texture is uploaded without any conversion:
+//   - end colors of block are taken from principal axis of block colors
+//   - only 4 color mode is used (no transparency)
+class CBc1Codec
+{
+public:
+    static int getImageBytes(int size);
+    static int getMipmapBytes(int size);
+    static void encodeMipmaps(const uchar *rgb, int size, uchar *data);
+    static void decodeImage(const uchar *data, int size, uchar *rgb);
+
+private:
+    static void encodeBlock(const uchar *rgb, int size, int bx, int by, uchar *block);
+    static void decodeBlock(const uchar *block, int size, int bx, int by, uchar *rgb);
+    static void getPalette(quint16 color0, quint16 color1, int *palette);
+};
+
+#endif // CBC1CODEC_H
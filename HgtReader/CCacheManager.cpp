@@ -44,14 +44,29 @@
 #include <QDir>
 #include <QFileInfoList>
 #include <QFileInfo>
-#include <QImage>
+#include <QDateTime>
 #include <QDebug>
 #include <math.h>
+#include <string.h>
 #include "CCacheManager.h"
 #include "CCommons.h"
 #include "CHgtFile.h"
+#include "CRawTiledFile.h"
+#include "CBc1Codec.h"
+#include "CTraceZone.h"
+#include "CPerformance.h"
 
 
+CMemoryCounters::CMemoryCounters()
+{
+    quadtreeBytes = 0;
+    terrainDataBytes = 0;
+    pendingTextureBytes = 0;
+    vramBytes = 0;
+    tablesBytes = 0;
+    performanceHistoryBytes = 0;
+}
+
 CCacheManager *CCacheManager::instance;
 
 CCacheManager::CCacheManager()
@@ -60,6 +75,8 @@ CCacheManager::CCacheManager()
 
     // something like singleton :)
     instance = this;
+    earthBufferA = 0;               // set by setEarthBuffers
+    earthBufferB = 0;
 
     pathBase = ""; // "E:\\HgtReader_data\\";
     pathL00_L03 = pathBase + "L00-L03\\";
@@ -74,6 +91,10 @@ CCacheManager::CCacheManager()
     pathL04_L08_index = pathBase + "L04-L08_index\\";
     pathL09_L13_index = pathBase + "L09-L13_index\\";
     pathSRTM_index = pathBase + "NASA_SRTM_index\\";
+    pathTileCache = pathBase + "TileCache\\";
+    pathTerrainContainer = pathBase + TERRAIN_CONTAINER_FILE;
+    pathTextureTiles = pathBase + TEXTURE_TILES_FILE;
+    pathHeightRangeTable = pathBase + HEIGHT_RANGE_TABLE_FILE;
 
     // generate degree size of tile in each LOD
     LODdegreeSizeLookUp[0] = 60.0;
@@ -134,6 +155,34 @@ CCacheManager::CCacheManager()
 
     // setup strip index
     setupStripIndex();
+
+    // setup data shared by many terrains (ocean, no data areas)
+    setupSharedTerrainData();
+
+    // all HGT levels in one file are used instead of HGT directories when available
+    terrainContainer = new CTerrainContainer();
+    if (terrainContainer->open(pathTerrainContainer))
+        qDebug("Terrain container %s opened", qPrintable(pathTerrainContainer));
+
+    // pre-built textures are used instead of resampling RAW files when available
+    textureTiles = new CTextureTiles();
+    if (textureTiles->open(pathTextureTiles, TEX_TERRAIN_SIZE))
+        qDebug("Texture tiles %s opened%s", qPrintable(pathTextureTiles), textureTiles->isCompressed() ? " (BC1)" : "");
+
+    // height ranges of finest source for flat terrain check - terrains are split without it
+    heightRangeTable = new CHeightRangeTable();
+    if (heightRangeTable->open(pathHeightRangeTable))
+        qDebug("Height range table %s opened", qPrintable(pathHeightRangeTable));
+
+    // open terrains generated in previous runs
+    tileDiskCache = new CTileDiskCache(pathTileCache);
+
+    // cache operations are logged only when trace is started
+    cacheTrace = new CCacheTrace();
+    tablesBytes = getTablesBytes();
+
+    // counters of file reads are shown in UI and benchmark report
+    ioStats = new CIoStats();
 }
 
 CCacheManager::~CCacheManager()
@@ -157,6 +206,17 @@ CCacheManager::~CCacheManager()
     delete []cachedTerrainDataGroup_L04_L08;
     delete []cachedTerrainDataGroup_L09_L13;
 
+    delete []emptyTexture;
+    delete []seaLevelColors;
+    delete []terrainUv;
+
+    delete tileDiskCache;
+    delete terrainContainer;
+    delete textureTiles;
+    delete heightRangeTable;
+    delete cacheTrace;
+    delete ioStats;
+
     instance = 0;
 }
 
@@ -203,14 +263,50 @@ void CCacheManager::setupStripIndex()
         stripIndexListSE[i] = stripIndexListSEtmp[i];
 }
 
+void CCacheManager::setupSharedTerrainData()
+{
+    CRawFile texture;
+    int i, x, y;
+
+    // same texture as built by getTerrainPoints when there is no RAW file
+    emptyTexture = new unsigned char[3*TEX_TERRAIN_SIZE*TEX_TERRAIN_SIZE];
+    emptyTextureID = 0;
+    textureCompressionSupport = -1;
+    compressedTexImage2D = 0;
+    texture.setPixelsPointer(TEX_TERRAIN_SIZE, TEX_TERRAIN_SIZE, (CRawPixel *)emptyTexture);
+    for (y=0; y<TEX_TERRAIN_SIZE; y++)
+        for (x=0; x<TEX_TERRAIN_SIZE; x++) {
+            texture.setPixel(x, y, CRawPixel(TEX_EMPTY_COLOR));
+        }
+
+    seaLevelColors = new QColor[81];
+    for (i=0; i<81; i++) {
+        seaLevelColors[i].setRedF(0.2784);
+        seaLevelColors[i].setGreenF(0.6431);
+        seaLevelColors[i].setBlueF(0.7216);
+    }
+
+    terrainUv = new QVector2D[81];
+    i = 0;
+    for (y=0; y<9; y++)
+        for (x=0; x<9; x++) {
+            terrainUv[i].setX( (((double)x)/8.0)*0.973 + 0.0135 );   // (...)*0.973 + 0.0135 to avoid Qt texture border :/
+            terrainUv[i].setY( (((double)y)/8.0)*0.973 + 0.0135 );   // (...)*0.973 + 0.0135 to avoid Qt texture border :/
+            i++;
+        }
+}
+
 void CCacheManager::getTerrainPoints(double lon, double lat, int lod,
                                      int *points, int *pointNW, int *pointNE, int *pointSW, int *pointSE,
-                                     int *pointsN, int *pointsE, int *pointsS, int *pointsW, unsigned char *texture,
+                                     int *pointsN, int *pointsE, int *pointsS, int *pointsW,
+                                     unsigned char *texture, unsigned char *textureCompressed,
                                      bool dontUseDiskHgt, bool dontUseDiskRaw)
 {
+    CTraceZone zone("CCacheManager::getTerrainPoints");
     QString filePath;
     CRawFile terrainTexture;
     CHgtFile hgtFile;
+    CIoCounters io;
     double lodDegreeSize;
     double neighborLon, neighborLat;
     int i, x, y, hgtSkipping, hgtSize;
@@ -224,6 +320,8 @@ void CCacheManager::getTerrainPoints(double lon, double lat, int lod,
             for (x=0; x<TEX_TERRAIN_SIZE; x++) {
                 terrainTexture.setPixel(x, y, CRawPixel(TEX_EMPTY_COLOR));
             }
+    } else if (textureTiles->isOpen()) {
+        getTextureTile(lon, lat, lod, texture, textureCompressed);   // pre-built texture data
     } else {
         buildTextureFromRawFiles(lon, lat, lod, &terrainTexture);    // get texture data
     }
@@ -240,6 +338,11 @@ void CCacheManager::getTerrainPoints(double lon, double lat, int lod,
         for (i=0; i<9; i++) pointsS[i] = HGT_DONT_USE_DISK_HEIGHT;
         for (i=0; i<9; i++) pointsW[i] = HGT_DONT_USE_DISK_HEIGHT;
 
+    } else if (terrainContainer->isOpen()) {
+
+        getContainerTerrainPoints(lon, lat, lod, points, pointNW, pointNE, pointSW, pointSE,
+                                  pointsN, pointsE, pointsS, pointsW);
+
     } else {
 
         lodDegreeSize = LODdegreeSizeLookUp[lod];
@@ -385,7 +488,167 @@ void CCacheManager::getTerrainPoints(double lon, double lat, int lod,
             for (i=0; i<9; i++) pointsW[i] = 0;
         }
 
+        io = hgtFile.takeIoCounters();
+        io.tiles = 1;
+        ioStats->add(getHgtIoSource(lod), io);
+    }
+}
+
+void CCacheManager::getContainerTerrainPoints(const double &lon, const double &lat, const int &lod,
+                                              int *points, int *pointNW, int *pointNE, int *pointSW, int *pointSE,
+                                              int *pointsN, int *pointsE, int *pointsS, int *pointsW)
+{
+    CIoCounters io;
+    int apron[11*11];
+    int i, x, y, hgtSkipping;
+
+    // terrain with all neighbor points is one 11x11 block in level grid
+    findContainerXY(lon, lat, lod, &x, &y);
+    hgtSkipping = HGTsourceSkippingLookUp[lod];
+    terrainContainer->getHeightBlock(apron, HGTsourceLookUp[lod], x - hgtSkipping, y - hgtSkipping, 11, 11, hgtSkipping, &io);
+    io.tiles = 1;
+    ioStats->add(IO_SOURCE_CONTAINER, io);
+
+    for (y=0; y<9; y++)
+        for (x=0; x<9; x++)
+            points[y*9 + x] = apron[(y+1)*11 + (x+1)];
+
+    (*pointNW) = apron[0*11 + 0];
+    (*pointNE) = apron[0*11 + 10];
+    (*pointSW) = apron[10*11 + 0];
+    (*pointSE) = apron[10*11 + 10];
+    for (i=0; i<9; i++) {
+        pointsN[i] = apron[0*11 + (i+1)];
+        pointsE[i] = apron[(i+1)*11 + 10];
+        pointsS[i] = apron[10*11 + (i+1)];
+        pointsW[i] = apron[(i+1)*11 + 0];
+    }
+}
+
+void CCacheManager::findContainerXY(const double &lon, const double &lat, const int &lod, int *x, int *y)
+{
+    double tlLon, tlLat;
+    double samplesPerDegree = (HGTsourceSizeLookUp[lod] - 1) / HGTsourceDegreeSizeLookUp[lod];
+
+    // position of terrain top left corner in global grid of container level
+    CCommons::findTopLeftCorner(lon, lat, LODdegreeSizeLookUp[lod], &tlLon, &tlLat);
+    (*x) = (int)(tlLon*samplesPerDegree + 0.5);
+    (*y) = (int)((90.0 - tlLat)*samplesPerDegree + 0.5);
+}
+
+int CCacheManager::getChildrenHeightRange(const double &tlLon, const double &tlLat, const int &lod)
+{
+    CIoCounters io;
+    int range;
+
+    // every sample used by all descendants comes from finest source - coarser sources keep only
+    // every n-th sample so small island would be missed, ranges are pre-built by HgtPyramidBuilder
+    range = heightRangeTable->getHeightRange(tlLon, tlLat, LODdegreeSizeLookUp[lod], &io);
+    if (io.reads>0)
+        ioStats->add(IO_SOURCE_HEIGHT_RANGE, io);  // part of parent terrain - no tile of its own
+
+    return range;
+}
+
+unsigned int CCacheManager::getSourceStamp(const double &tlLon, const double &tlLat, const int &lod)
+{
+    CAvability *avability;
+    CAvability *texAvability = 0;
+    unsigned int stamp;
+    double lodDegreeSize = LODdegreeSizeLookUp[lod];
+    double lon, lat;
+    int RAWfilesIndex[4];
+    int pixOffsetLon, pixOffsetLat;
+    int i, x, y;
+
+    stamp = 0;
+
+    if (terrainContainer->isOpen()) {
+
+        // all HGT data in one file
+        stamp = terrainContainer->lastModified;
+
+    } else {
+
+        // HGT files of terrain and neighbors
+        for (y=-1; y<=1; y++)
+            for (x=-1; x<=1; x++) {
+                lon = tlLon + x*lodDegreeSize;
+                lat = tlLat - y*lodDegreeSize;
+                if (lon<0.0) lon += 360.0;
+                if (lon>=360.0) lon -= 360.0;
+                if (lat>90.0 || lat<=-90.0)
+                    continue;
+
+                avability = findHgtAvability(lon, lat, lod);
+                if (avability!=0 && avability->available && avability->lastModified>stamp)
+                    stamp = avability->lastModified;
+            }
+
+    }
+
+    // height ranges of finest source (flat terrain check)
+    if (heightRangeTable->isOpen() && heightRangeTable->lastModified>stamp)
+        stamp = heightRangeTable->lastModified;
+
+    // pre-built texture tiles or RAW files of texture
+    if (textureTiles->isOpen()) {
+        if (textureTiles->lastModified>stamp)
+            stamp = textureTiles->lastModified;
+        return stamp;
+    }
+    switch (TEXsourceLookUp[lod]) {
+        case TEX_SOURCE_L00_L02: texAvability = avabilityTex_L00_L02; break;
+        case TEX_SOURCE_L03_L05: texAvability = avabilityTex_L03_L05; break;
+        case TEX_SOURCE_L06_L08: texAvability = avabilityTex_L06_L08; break;
+        case TEX_SOURCE_L09_L10: texAvability = avabilityTex_L09_L10; break;
+    }
+    findRawFiles(tlLon, tlLat, lod, RAWfilesIndex, &pixOffsetLon, &pixOffsetLat);
+    for (i=0; i<4; i++) {
+        if (RAWfilesIndex[i]!=-1 && texAvability[RAWfilesIndex[i]].lastModified>stamp)
+            stamp = texAvability[RAWfilesIndex[i]].lastModified;
+    }
+
+    return stamp;
+}
+
+CAvability *CCacheManager::findHgtAvability(const double &lon, const double &lat, const int &lod)
+{
+    double tlLon, tlLat;
+    int index;
+
+    CCommons::findTopLeftCornerOfHgtFile(lon, lat, lod, &tlLon, &tlLat);
+    CCommons::convertTopLeft2AvabilityIndex(tlLon, tlLat, HGTsourceDegreeSizeLookUp[lod], &index);
+
+    switch (HGTsourceLookUp[lod]) {
+        case HGT_SOURCE_L00_L03: return &avability_L00_L03[index];
+        case HGT_SOURCE_L04_L08: return &avability_L04_L08[index];
+        case HGT_SOURCE_L09_L13: return &avability_L09_L13[index];
+    }
+
+    return 0;
+}
+
+int CCacheManager::getHgtIoSource(const int &lod)
+{
+    switch (HGTsourceLookUp[lod]) {
+        case HGT_SOURCE_L00_L03: return IO_SOURCE_L00_L03;
+        case HGT_SOURCE_L04_L08: return IO_SOURCE_L04_L08;
+        case HGT_SOURCE_L09_L13: return IO_SOURCE_L09_L13;
+    }
+
+    return IO_SOURCE_SRTM;
+}
+
+int CCacheManager::getTexIoSource(const int &lod)
+{
+    switch (TEXsourceLookUp[lod]) {
+        case TEX_SOURCE_L00_L02: return IO_SOURCE_TEX_L00_L02;
+        case TEX_SOURCE_L03_L05: return IO_SOURCE_TEX_L03_L05;
+        case TEX_SOURCE_L06_L08: return IO_SOURCE_TEX_L06_L08;
     }
+
+    return IO_SOURCE_TEX_L09_L10;
 }
 
 void CCacheManager::findHgtFileName(const double &lon, const double &lat, const int &lod,
@@ -481,14 +744,66 @@ bool CCacheManager::findRawFiles(const double &tlLon, const double &tlLat, const
     return hasAtLeastOneRAWFile;
 }
 
+bool CCacheManager::getTextureTile(const double &tlLon, const double &tlLat, const int &lod, unsigned char *texture, unsigned char *textureCompressed)
+{
+    CRawFile terrainTexture;
+    CIoCounters io;
+    QByteArray bytes;
+    double tileLon, tileLat;
+    int texLod, index, width;
+    bool tileRead;
+
+    // above TEX_SOURCE_MAX_LOD terrains use fragment of TEX_SOURCE_MAX_LOD texture (same as findRawFiles)
+    texLod = lod<=TEX_SOURCE_MAX_LOD ? lod : TEX_SOURCE_MAX_LOD;
+    CCommons::findTopLeftCorner(tlLon, tlLat, LODdegreeSizeLookUp[texLod], &tileLon, &tileLat);
+    CCommons::convertTopLeft2AvabilityIndex(tileLon, tileLat, LODdegreeSizeLookUp[texLod], &index);
+    width = (int)( (360.0 / LODdegreeSizeLookUp[texLod]) + 0.5 );
+
+    // tiles without any RAW file are not stored - terrain is counted only when tile was read
+    tileRead = textureTiles->readTile(texLod, index % width, index / width, &bytes, &io);
+    if (io.reads>0) {
+        io.tiles = 1;
+        ioStats->add(IO_SOURCE_TEXTURE_TILES, io);
+    }
+
+    // tile is missing when there is no RAW file under terrain or when it is corrupted -
+    // texture is built from RAW files like without tiles file (empty texture without RAW files)
+    if (!tileRead) {
+        if (texture!=0) {
+            terrainTexture.setPixelsPointer(TEX_TERRAIN_SIZE, TEX_TERRAIN_SIZE, (CRawPixel *)texture);
+            buildTextureFromRawFiles(tlLon, tlLat, lod, &terrainTexture);
+            if (textureCompressed!=0)
+                CBc1Codec::encodeMipmaps(texture, TEX_TERRAIN_SIZE, textureCompressed);
+        }
+        return false;
+    }
+
+    // compressed tiles are uploaded to VRAM as they are, decoded texture is used only by flat terrain check & cache
+    if (textureTiles->isCompressed()) {
+        if (texture!=0)
+            CBc1Codec::decodeImage((const uchar *)bytes.constData(), TEX_TERRAIN_SIZE, texture);
+        if (textureCompressed!=0)
+            memcpy(textureCompressed, bytes.constData(), bytes.size());
+    } else {
+        if (texture!=0)
+            memcpy(texture, bytes.constData(), bytes.size());
+    }
+
+    return true;
+}
+
 void CCacheManager::buildTextureFromRawFiles(const double &tlLon, const double &tlLat, const int &lod, CRawFile *terrainTexture)
 {
-    QImage texture(TEX_TERRAIN_SIZE, TEX_TERRAIN_SIZE, QImage::Format_RGB32);
+    CTraceZone zone("CCacheManager::buildTextureFromRawFiles");
     QString fileName;
     int index;
     CRawFile rawFile;
+    CRawTiledFile tiledFile;
     CRawPixel pixel;
-    int x, y;
+    CRawPixel window[TEX_TERRAIN_SIZE*TEX_TERRAIN_SIZE];
+    CRawPixel *texture;
+    CAvability *texAvability = 0;
+    int i, x, y;
     int pixInBaseTileLon;
     int pixInBaseTileLat;
     int pixInBaseStopLon;
@@ -496,36 +811,38 @@ void CCacheManager::buildTextureFromRawFiles(const double &tlLon, const double &
     int pixInNeighborStopLon;
     int pixInNeighborStopLat;
     int TEXskipping, TEXpxSize;
-    double TEXmult;
     int pixOffsetLon, pixOffsetLat;
+    int quadrant, startLon, startLat, sizeLon, sizeLat, destLon, destLat;
+    CIoCounters io;
     bool hasAtLeastOneRawFile;
     int RAWfilesIndex[4];
 
+    texture = (CRawPixel *)terrainTexture->getPixelsPointer();
     hasAtLeastOneRawFile = findRawFiles(tlLon, tlLat, lod, RAWfilesIndex, &pixOffsetLon, &pixOffsetLat);
     if ( ! hasAtLeastOneRawFile) {
-        for (y=0; y<TEX_TERRAIN_SIZE; y++)
-            for (x=0; x<TEX_TERRAIN_SIZE; x++) {
-                terrainTexture->setPixel(x, y, CRawPixel(TEX_EMPTY_COLOR));
-            }
+        for (i=0; i<TEX_TERRAIN_SIZE*TEX_TERRAIN_SIZE; i++)
+            texture[i] = CRawPixel(TEX_EMPTY_COLOR);
         return;
     }
 
+    // above TEX_SOURCE_MAX_LOD terrains use fragment of the same texture (no magnification)
     TEXskipping = TEXsourceSkippingLookUp[lod];
+    if (TEXskipping<1)
+        TEXskipping = 1;
     TEXpxSize = TEXsourcePxSizeLookUp[lod];
-
-    TEXmult = TEXskipping;
-    if (TEXmult<0.0) {
-        TEXmult = 1.0;
-//        TEXmult *= -1;
-//        TEXmult = 1.0/TEXmult;
+    switch (TEXsourceLookUp[lod]) {
+        case TEX_SOURCE_L00_L02: texAvability = avabilityTex_L00_L02; break;
+        case TEX_SOURCE_L03_L05: texAvability = avabilityTex_L03_L05; break;
+        case TEX_SOURCE_L06_L08: texAvability = avabilityTex_L06_L08; break;
+        case TEX_SOURCE_L09_L10: texAvability = avabilityTex_L09_L10; break;
     }
 
     // texture 32x32 window in base tile if:
     //    pixOffsetLon + TEXskipping*x  < TEXpxSize
     //    TEXskipping*x  < TEXpxSize - pixOffsetLon
     //    x < (TEXpxSize - pixOffsetLon) / TEXskipping
-    pixInBaseTileLon = (TEXpxSize - pixOffsetLon) / (TEXskipping<0 ? 1 : TEXskipping);
-    pixInBaseTileLat = (TEXpxSize - pixOffsetLat) / (TEXskipping<0 ? 1 : TEXskipping);
+    pixInBaseTileLon = (TEXpxSize - pixOffsetLon) / TEXskipping;
+    pixInBaseTileLat = (TEXpxSize - pixOffsetLat) / TEXskipping;
 
     if (pixInBaseTileLon>=TEX_TERRAIN_SIZE) {    // all in base
         pixInBaseStopLon = TEX_TERRAIN_SIZE;
@@ -542,114 +859,55 @@ void CCacheManager::buildTextureFromRawFiles(const double &tlLon, const double &
         pixInNeighborStopLat = TEX_TERRAIN_SIZE - pixInBaseTileLat;
     }
 
-    // copy from base tile
-    index = RAWfilesIndex[0 + 2*0];
-    pixel = CRawPixel(TEX_EMPTY_COLOR);
-    fileName = "";
-    if (index!=-1) {
-        switch (TEXsourceLookUp[lod]) {
-            case TEX_SOURCE_L00_L02:fileName = pathTexL00_L02 + (*avabilityTex_L00_L02[index].name); break;
-            case TEX_SOURCE_L03_L05:fileName = pathTexL03_L05 + (*avabilityTex_L03_L05[index].name); break;
-            case TEX_SOURCE_L06_L08:fileName = pathTexL06_L08 + (*avabilityTex_L06_L08[index].name); break;
-            case TEX_SOURCE_L09_L10:fileName = pathTexL09_L10 + (*avabilityTex_L09_L10[index].name); break;
+    // copy from base, right, left-bottom & right-bottom tile - each window is read by row spans
+    // (strided spans when skipping) and its rows are copied straight to terrain texture
+    for (quadrant=0; quadrant<4; quadrant++) {
+        startLon = (quadrant % 2) ? 0 : pixOffsetLon;
+        startLat = (quadrant / 2) ? 0 : pixOffsetLat;
+        sizeLon  = (quadrant % 2) ? pixInNeighborStopLon : pixInBaseStopLon;
+        sizeLat  = (quadrant / 2) ? pixInNeighborStopLat : pixInBaseStopLat;
+        destLon  = (quadrant % 2) ? pixInBaseStopLon : 0;
+        destLat  = (quadrant / 2) ? pixInBaseStopLat : 0;
+        if (sizeLon<=0 || sizeLat<=0)
+            continue;
+
+        index = RAWfilesIndex[quadrant];
+        if (index==-1) {
+            pixel = CRawPixel(TEX_EMPTY_COLOR);
+            for (y=0; y<sizeLat; y++)
+                for (x=0; x<sizeLon; x++)
+                    texture[(destLat + y)*TEX_TERRAIN_SIZE + destLon + x] = pixel;
+            continue;
         }
-        rawFile.fileOpen(fileName, TEXpxSize, TEXpxSize);
-    }
-    for (y=0; y<pixInBaseStopLat; y++)
-        for (x=0; x<pixInBaseStopLon; x++) {
-            if (index!=-1)
-                pixel = rawFile.fileGetPixel(pixOffsetLon + (int)(x*TEXmult), pixOffsetLat + (int)(y*TEXmult));
 
-            texture.setPixel(x, y, qRgb(pixel.r, pixel.g, pixel.b));
-            //terrainTexture->setPixel(x, y, pixel);
-        }
-    if (index!=-1)
-        rawFile.fileClose();
-
-    // copy from right tile
-    index = RAWfilesIndex[1 + 2*0];
-    pixel = CRawPixel(TEX_EMPTY_COLOR);
-    fileName = "";
-    if (index!=-1) {
         switch (TEXsourceLookUp[lod]) {
             case TEX_SOURCE_L00_L02:fileName = pathTexL00_L02 + (*avabilityTex_L00_L02[index].name); break;
             case TEX_SOURCE_L03_L05:fileName = pathTexL03_L05 + (*avabilityTex_L03_L05[index].name); break;
             case TEX_SOURCE_L06_L08:fileName = pathTexL06_L08 + (*avabilityTex_L06_L08[index].name); break;
             case TEX_SOURCE_L09_L10:fileName = pathTexL09_L10 + (*avabilityTex_L09_L10[index].name); break;
         }
-        rawFile.fileOpen(fileName, TEXpxSize, TEXpxSize);
-    }
-    for (y=0; y<pixInBaseStopLat; y++)
-        for (x=0; x<pixInNeighborStopLon; x++) {
-            if (index!=-1)
-                pixel = rawFile.fileGetPixel(0 + (int)(x*TEXmult), pixOffsetLat + (int)(y*TEXmult));
 
-            texture.setPixel(pixInBaseStopLon + x, y, qRgb(pixel.r, pixel.g, pixel.b));
-            //terrainTexture->setPixel(pixInBaseStopLon + x, y, pixel);
-        }
-    if (index!=-1)
-        rawFile.fileClose();
-
-    // copy from left-bottom tile
-    index = RAWfilesIndex[0 + 2*1];
-    pixel = CRawPixel(TEX_EMPTY_COLOR);
-    fileName = "";
-    if (index!=-1) {
-        switch (TEXsourceLookUp[lod]) {
-            case TEX_SOURCE_L00_L02:fileName = pathTexL00_L02 + (*avabilityTex_L00_L02[index].name); break;
-            case TEX_SOURCE_L03_L05:fileName = pathTexL03_L05 + (*avabilityTex_L03_L05[index].name); break;
-            case TEX_SOURCE_L06_L08:fileName = pathTexL06_L08 + (*avabilityTex_L06_L08[index].name); break;
-            case TEX_SOURCE_L09_L10:fileName = pathTexL09_L10 + (*avabilityTex_L09_L10[index].name); break;
+        pixel = CRawPixel(TEX_EMPTY_COLOR);
+        for (i=0; i<sizeLon*sizeLat; i++)
+            window[i] = pixel;
+        if (texAvability[index].tiled) {
+            tiledFile.fileOpen(fileName, TEXpxSize);
+            tiledFile.fileGetPixelBlock(window, startLon, startLat, sizeLon, sizeLat, TEXskipping);
+            tiledFile.fileClose();
+        } else {
+            rawFile.fileOpen(fileName, TEXpxSize, TEXpxSize);
+            rawFile.fileGetPixelBlock(window, startLon, startLat, sizeLon, sizeLat, TEXskipping);
+            rawFile.fileClose();
         }
-        rawFile.fileOpen(fileName, TEXpxSize, TEXpxSize);
-    }
-    for (y=0; y<pixInNeighborStopLat; y++)
-        for (x=0; x<pixInBaseStopLon; x++) {
-            if (index!=-1)
-                pixel = rawFile.fileGetPixel(pixOffsetLon + (int)(x*TEXmult), 0 + (int)(y*TEXmult));
 
-            texture.setPixel(0 + x, pixInBaseStopLat + y, qRgb(pixel.r, pixel.g, pixel.b));
-            //terrainTexture->setPixel(0 + x, pixInBaseStopLat + y, pixel);
-        }
-    if (index!=-1)
-        rawFile.fileClose();
-
-    // copy from right-bottom tile
-    index = RAWfilesIndex[1 + 2*1];
-    pixel = CRawPixel(TEX_EMPTY_COLOR);
-    fileName = "";
-    if (index!=-1) {
-        switch (TEXsourceLookUp[lod]) {
-            case TEX_SOURCE_L00_L02:fileName = pathTexL00_L02 + (*avabilityTex_L00_L02[index].name); break;
-            case TEX_SOURCE_L03_L05:fileName = pathTexL03_L05 + (*avabilityTex_L03_L05[index].name); break;
-            case TEX_SOURCE_L06_L08:fileName = pathTexL06_L08 + (*avabilityTex_L06_L08[index].name); break;
-            case TEX_SOURCE_L09_L10:fileName = pathTexL09_L10 + (*avabilityTex_L09_L10[index].name); break;
-        }
-        rawFile.fileOpen(fileName, TEXpxSize, TEXpxSize);
+        for (y=0; y<sizeLat; y++)
+            memcpy(texture + (destLat + y)*TEX_TERRAIN_SIZE + destLon, window + y*sizeLon, sizeLon*sizeof(CRawPixel));
     }
-    for (y=0; y<pixInNeighborStopLat; y++)
-        for (x=0; x<pixInNeighborStopLon; x++) {
-            if (index!=-1)
-                pixel = rawFile.fileGetPixel(0 + (int)(x*TEXmult), 0 + (int)(y*TEXmult));
-
-            texture.setPixel(pixInBaseStopLon + x, pixInBaseStopLat + y, qRgb(pixel.r, pixel.g, pixel.b));
-            //terrainTexture->setPixel(pixInBaseStopLon + x, pixInBaseStopLat + y, pixel);
-        }
-    if (index!=-1)
-        rawFile.fileClose();
-
-
-    // smooth texture - now filtered by graphic card (faster)
-//    if (TEXskipping!=1) {
-//        texture = texture.scaledToWidth(40, Qt::SmoothTransformation);
-//        texture = texture.scaledToWidth(TEX_TERRAIN_SIZE, Qt::SmoothTransformation);
-//    }
 
-    // copy terrain texture
-    for (y=0; y<TEX_TERRAIN_SIZE; y++)
-        for (x=0; x<TEX_TERRAIN_SIZE; x++) {
-            terrainTexture->setPixel(x, y, CRawPixel(texture.pixel(x, y)));
-        }
+    io = rawFile.takeIoCounters();
+    io.add(tiledFile.takeIoCounters());
+    io.tiles = 1;
+    ioStats->add(getTexIoSource(lod), io);
 }
 
 void CCacheManager::setEarthBuffers(CEarth *eBuffA, CEarth *eBuffB)
@@ -680,6 +938,9 @@ bool CCacheManager::cacheTerrainDataFind(const double lon, const double lat, con
                                 break;
     }
 
+    if (cacheTrace->isRecording())
+        cacheTrace->record(CACHE_TRACE_FIND, earth==earthBufferA ? CACHE_TRACE_EARTH_A : CACHE_TRACE_EARTH_B, tlLon, tlLat, lod, result);
+
     return result;
 }
 
@@ -693,6 +954,10 @@ void CCacheManager::cacheTerrainDataRegister(const CEarth *earth, CTerrainData *
                                          (*terrainData)->LOD, &tlLonSource, &tlLatSource);
     CCommons::convertTopLeft2AvabilityIndex(tlLonSource, tlLatSource, HGTsourceDegreeSizeLookUp[(*terrainData)->LOD], &index);
 
+    if (cacheTrace->isRecording())
+        cacheTrace->record(CACHE_TRACE_REGISTER, earth==earthBufferA ? CACHE_TRACE_EARTH_A : CACHE_TRACE_EARTH_B,
+                           (*terrainData)->topLeftLon, (*terrainData)->topLeftLat, (*terrainData)->LOD, false);
+
     // regiter terrain in cache region
     switch (HGTsourceLookUp[(*terrainData)->LOD]) {
         case HGT_SOURCE_L00_L03:cachedTerrainDataGroup_L00_L03[index].cachedTerrainDataListRegister(earth, terrainData);
@@ -713,6 +978,11 @@ void CCacheManager::cacheTerrainDataFree(const CEarth *earth, CTerrainData **ter
     CCommons::findTopLeftCornerOfHgtFile((*terrainData)->topLeftLon, (*terrainData)->topLeftLat, (*terrainData)->LOD, &tlLonSource, &tlLatSource);
     CCommons::convertTopLeft2AvabilityIndex(tlLonSource, tlLatSource, HGTsourceDegreeSizeLookUp[(*terrainData)->LOD], &index);
 
+    // terrain data can be deleted by free - key is logged first
+    if (cacheTrace->isRecording())
+        cacheTrace->record(CACHE_TRACE_FREE, earth==earthBufferA ? CACHE_TRACE_EARTH_A : CACHE_TRACE_EARTH_B,
+                           (*terrainData)->topLeftLon, (*terrainData)->topLeftLat, (*terrainData)->LOD, false);
+
     // free terrain in cache region
     switch (HGTsourceLookUp[(*terrainData)->LOD]) {
         case HGT_SOURCE_L00_L03:cachedTerrainDataGroup_L00_L03[index].cachedTerrainDataListFree(earth, terrainData, dontSaveJustDelete);
@@ -733,13 +1003,15 @@ void CCacheManager::cacheInfo(int *cTDCount, int *cTDInUseCount, int *cTDNotInUs
     int L09_L13_width  = (int)(360.0 / HGT_SOURCE_DEGREE_SIZE_L09_L13);
     int L09_L13_height = (int)(180.0 / HGT_SOURCE_DEGREE_SIZE_L09_L13);
     int i;
-    int tmpCount, tmpInUseCount, tmpNotInUseCount, tmpEmptyEntryCount;
+    int tmpCount, tmpInUseCount, tmpNotInUseCount, tmpEmptyEntryCount, tmpCompactCount;
 
     cachedTerrainDataCount = 0;
     cachedTerrainDataInUseCount = 0;
     cachedTerrainDataNotInUseCount = 0;
     cachedTerrainDataEmptyEntryCount = 0;
     cacheMinNotInUseTime = 25*3600*1000;
+    cachedTerrainDataCompactCount = 0;
+    cacheMinCompactTime = 25*3600*1000;
 
     // L00-L03
     for (i=0; i<L00_L03_width*L00_L03_height; i++) {
@@ -747,12 +1019,15 @@ void CCacheManager::cacheInfo(int *cTDCount, int *cTDInUseCount, int *cTDNotInUs
         tmpInUseCount = 0;
         tmpNotInUseCount = 0;
         tmpEmptyEntryCount = 0;
-        cachedTerrainDataGroup_L00_L03[i].cachedTerrainDataInfo(&tmpCount, &tmpInUseCount, &tmpNotInUseCount, &tmpEmptyEntryCount, &cacheMinNotInUseTime);
+        tmpCompactCount = 0;
+        cachedTerrainDataGroup_L00_L03[i].cachedTerrainDataInfo(&tmpCount, &tmpInUseCount, &tmpNotInUseCount, &tmpEmptyEntryCount, &cacheMinNotInUseTime,
+                                                            &tmpCompactCount, &cacheMinCompactTime);
 
         cachedTerrainDataCount += tmpCount;
         cachedTerrainDataInUseCount += tmpInUseCount;
         cachedTerrainDataNotInUseCount += tmpNotInUseCount;
         cachedTerrainDataEmptyEntryCount += tmpEmptyEntryCount;
+        cachedTerrainDataCompactCount += tmpCompactCount;
     }
 
     // L04-L08
@@ -761,12 +1036,15 @@ void CCacheManager::cacheInfo(int *cTDCount, int *cTDInUseCount, int *cTDNotInUs
         tmpInUseCount = 0;
         tmpNotInUseCount = 0;
         tmpEmptyEntryCount = 0;
-        cachedTerrainDataGroup_L04_L08[i].cachedTerrainDataInfo(&tmpCount, &tmpInUseCount, &tmpNotInUseCount, &tmpEmptyEntryCount, &cacheMinNotInUseTime);
+        tmpCompactCount = 0;
+        cachedTerrainDataGroup_L04_L08[i].cachedTerrainDataInfo(&tmpCount, &tmpInUseCount, &tmpNotInUseCount, &tmpEmptyEntryCount, &cacheMinNotInUseTime,
+                                                            &tmpCompactCount, &cacheMinCompactTime);
 
         cachedTerrainDataCount += tmpCount;
         cachedTerrainDataInUseCount += tmpInUseCount;
         cachedTerrainDataNotInUseCount += tmpNotInUseCount;
         cachedTerrainDataEmptyEntryCount += tmpEmptyEntryCount;
+        cachedTerrainDataCompactCount += tmpCompactCount;
     }
 
     // L09-L13
@@ -775,12 +1053,15 @@ void CCacheManager::cacheInfo(int *cTDCount, int *cTDInUseCount, int *cTDNotInUs
         tmpInUseCount = 0;
         tmpNotInUseCount = 0;
         tmpEmptyEntryCount = 0;
-        cachedTerrainDataGroup_L09_L13[i].cachedTerrainDataInfo(&tmpCount, &tmpInUseCount, &tmpNotInUseCount, &tmpEmptyEntryCount, &cacheMinNotInUseTime);
+        tmpCompactCount = 0;
+        cachedTerrainDataGroup_L09_L13[i].cachedTerrainDataInfo(&tmpCount, &tmpInUseCount, &tmpNotInUseCount, &tmpEmptyEntryCount, &cacheMinNotInUseTime,
+                                                            &tmpCompactCount, &cacheMinCompactTime);
 
         cachedTerrainDataCount += tmpCount;
         cachedTerrainDataInUseCount += tmpInUseCount;
         cachedTerrainDataNotInUseCount += tmpNotInUseCount;
         cachedTerrainDataEmptyEntryCount += tmpEmptyEntryCount;
+        cachedTerrainDataCompactCount += tmpCompactCount;
     }
 
     (*cTDCount) = cachedTerrainDataCount;
@@ -790,6 +1071,76 @@ void CCacheManager::cacheInfo(int *cTDCount, int *cTDInUseCount, int *cTDNotInUs
     (*cMinNotInUseTime) = cacheMinNotInUseTime;
 }
 
+void CCacheManager::memoryInfo(CMemoryCounters *counters)
+{
+    CPerformance *performance = CPerformance::getInstance();
+    int L00_L03_count = (int)(360.0 / HGT_SOURCE_DEGREE_SIZE_L00_L03) * (int)(180.0 / HGT_SOURCE_DEGREE_SIZE_L00_L03);
+    int L04_L08_count = (int)(360.0 / HGT_SOURCE_DEGREE_SIZE_L04_L08) * (int)(180.0 / HGT_SOURCE_DEGREE_SIZE_L04_L08);
+    int L09_L13_count = (int)(360.0 / HGT_SOURCE_DEGREE_SIZE_L09_L13) * (int)(180.0 / HGT_SOURCE_DEGREE_SIZE_L09_L13);
+    int i, size;
+
+    (*counters) = CMemoryCounters();
+
+    // both earths are updated only by terrain loader thread
+    if (earthBufferA!=0) counters->quadtreeBytes += (qint64)earthBufferA->terrainsInTree*sizeof(CTerrain);
+    if (earthBufferB!=0) counters->quadtreeBytes += (qint64)earthBufferB->terrainsInTree*sizeof(CTerrain);
+
+    // terrain data is shared by both earths - each cached entry is counted once
+    for (i=0; i<L00_L03_count; i++)
+        cachedTerrainDataGroup_L00_L03[i].cachedTerrainDataMemoryInfo(&counters->terrainDataBytes, &counters->pendingTextureBytes, &counters->vramBytes);
+    for (i=0; i<L04_L08_count; i++)
+        cachedTerrainDataGroup_L04_L08[i].cachedTerrainDataMemoryInfo(&counters->terrainDataBytes, &counters->pendingTextureBytes, &counters->vramBytes);
+    for (i=0; i<L09_L13_count; i++)
+        cachedTerrainDataGroup_L09_L13[i].cachedTerrainDataMemoryInfo(&counters->terrainDataBytes, &counters->pendingTextureBytes, &counters->vramBytes);
+
+    // shared empty texture is in VRAM once
+    if (emptyTextureID!=0)
+        for (size=TEX_TERRAIN_SIZE; size>=1; size/=2)
+            counters->vramBytes += size*size*3;
+
+    counters->tablesBytes = tablesBytes;
+    if (performance!=0)
+        counters->performanceHistoryBytes = performance->getHistoryMemoryBytes();
+}
+
+qint64 CCacheManager::getTablesBytes()
+{
+    int L00_L03_count = (int)(360.0 / HGT_SOURCE_DEGREE_SIZE_L00_L03) * (int)(180.0 / HGT_SOURCE_DEGREE_SIZE_L00_L03);
+    int L04_L08_count = (int)(360.0 / HGT_SOURCE_DEGREE_SIZE_L04_L08) * (int)(180.0 / HGT_SOURCE_DEGREE_SIZE_L04_L08);
+    int L09_L13_count = (int)(360.0 / HGT_SOURCE_DEGREE_SIZE_L09_L13) * (int)(180.0 / HGT_SOURCE_DEGREE_SIZE_L09_L13);
+    int SRTM_count    = (int)(360.0 / HGT_SOURCE_DEGREE_SIZE_SRTM) * (int)(180.0 / HGT_SOURCE_DEGREE_SIZE_SRTM);
+    int TEX_count     = (int)(360.0 / TEX_DEGREE_SIZE) * (int)(180.0 / TEX_DEGREE_SIZE);
+    qint64 bytes = 0;
+
+    bytes += getAvabilityBytes(avability_L00_L03, L00_L03_count);
+    bytes += getAvabilityBytes(avability_L04_L08, L04_L08_count);
+    bytes += getAvabilityBytes(avability_L09_L13, L09_L13_count);
+    bytes += getAvabilityBytes(avability_SRTM, SRTM_count);
+    bytes += getAvabilityBytes(avabilityTex_L00_L02, TEX_count);
+    bytes += getAvabilityBytes(avabilityTex_L03_L05, TEX_count);
+    bytes += getAvabilityBytes(avabilityTex_L06_L08, TEX_count);
+    bytes += getAvabilityBytes(avabilityTex_L09_L10, TEX_count);
+    bytes += (qint64)(L00_L03_count + L04_L08_count + L09_L13_count)*sizeof(CCachedTerrainDataGroup);
+
+    // data shared by terrains without own texture, colors or uv
+    bytes += 3*TEX_TERRAIN_SIZE*TEX_TERRAIN_SIZE + 81*sizeof(QColor) + 81*sizeof(QVector2D);
+
+    return bytes;
+}
+
+qint64 CCacheManager::getAvabilityBytes(const CAvability *avability, int count)
+{
+    qint64 bytes;
+    int i;
+
+    bytes = (qint64)count*sizeof(CAvability);
+    for (i=0; i<count; i++)
+        if (avability[i].name!=0)
+            bytes += sizeof(QString) + avability[i].name->size()*sizeof(QChar);
+
+    return bytes;
+}
+
 void CCacheManager::cacheClear(CEarth *earth)
 {
     int L00_L03_width  = (int)(360.0 / HGT_SOURCE_DEGREE_SIZE_L00_L03);
@@ -818,6 +1169,7 @@ void CCacheManager::cacheClear(CEarth *earth)
 
 void CCacheManager::cacheKeepSize(CEarth *earth)
 {
+    CTraceZone zone("CCacheManager::cacheKeepSize");
     int L00_L03_width  = (int)(360.0 / HGT_SOURCE_DEGREE_SIZE_L00_L03);
     int L00_L03_height = (int)(180.0 / HGT_SOURCE_DEGREE_SIZE_L00_L03);
     int L04_L08_width  = (int)(360.0 / HGT_SOURCE_DEGREE_SIZE_L04_L08);
@@ -826,23 +1178,42 @@ void CCacheManager::cacheKeepSize(CEarth *earth)
     int L09_L13_height = (int)(180.0 / HGT_SOURCE_DEGREE_SIZE_L09_L13);
     int i;
 
-    if (cacheMinNotInUseTime>24*3600*1000)
-        return;
+    if (cacheTrace->isRecording())
+        cacheTrace->record(CACHE_TRACE_KEEP_SIZE, earth==earthBufferA ? CACHE_TRACE_EARTH_A : CACHE_TRACE_EARTH_B, 0.0, 0.0, 0, false);
+
+    // hot tier - the oldest terrain data not in use is packed to compact form
+    if (cachedTerrainDataNotInUseCount>CACHE_MAX_UNUSED_TERRAIN_DATA && cacheMinNotInUseTime<=24*3600*1000) {
+        // L00-L03
+        for (i=0; i<L00_L03_width*L00_L03_height; i++) {
+            cachedTerrainDataGroup_L00_L03[i].compactNotInUse(earth, cacheMinNotInUseTime + 5000);
+        }
+
+        // L04-L08
+        for (i=0; i<L04_L08_width*L04_L08_height; i++) {
+            cachedTerrainDataGroup_L04_L08[i].compactNotInUse(earth, cacheMinNotInUseTime + 5000);
+        }
+
+        // L09-L13
+        for (i=0; i<L09_L13_width*L09_L13_height; i++) {
+            cachedTerrainDataGroup_L09_L13[i].compactNotInUse(earth, cacheMinNotInUseTime + 5000);
+        }
+    }
 
-    if (cachedTerrainDataNotInUseCount>CACHE_MAX_UNUSED_TERRAIN_DATA) {
+    // cold tier - the oldest compact terrain data is dropped
+    if (cachedTerrainDataCompactCount>CACHE_MAX_COMPACT_TERRAIN_DATA && cacheMinCompactTime<=24*3600*1000) {
         // L00-L03
         for (i=0; i<L00_L03_width*L00_L03_height; i++) {
-            cachedTerrainDataGroup_L00_L03[i].deleteNotInUse(earth, cacheMinNotInUseTime + 5000);
+            cachedTerrainDataGroup_L00_L03[i].deleteNotInUse(earth, cacheMinCompactTime + 5000);
         }
 
         // L04-L08
         for (i=0; i<L04_L08_width*L04_L08_height; i++) {
-            cachedTerrainDataGroup_L04_L08[i].deleteNotInUse(earth, cacheMinNotInUseTime + 5000);
+            cachedTerrainDataGroup_L04_L08[i].deleteNotInUse(earth, cacheMinCompactTime + 5000);
         }
 
         // L09-L13
         for (i=0; i<L09_L13_width*L09_L13_height; i++) {
-            cachedTerrainDataGroup_L09_L13[i].deleteNotInUse(earth, cacheMinNotInUseTime + 5000);
+            cachedTerrainDataGroup_L09_L13[i].deleteNotInUse(earth, cacheMinCompactTime + 5000);
         }
     }
 }
@@ -893,7 +1264,7 @@ void CCacheManager::setupAvabilityTables()
         if (fileInfo.size()==8450 && fileInfo.suffix()=="hgt") {
             CCommons::convertFileNameToLonLat(fileInfo.fileName(), &tlLon, &tlLat);
             CCommons::convertTopLeft2AvabilityIndex(tlLon, tlLat, HGT_SOURCE_DEGREE_SIZE_L00_L03, &index);
-            avability_L00_L03[index].setAvailable(fileInfo.fileName());
+            avability_L00_L03[index].setAvailable(fileInfo.fileName(), fileInfo.lastModified().toTime_t());
         }
     }
 
@@ -908,7 +1279,7 @@ void CCacheManager::setupAvabilityTables()
         if (fileInfo.size()==526338 && fileInfo.suffix()=="hgt") {
             CCommons::convertFileNameToLonLat(fileInfo.fileName(), &tlLon, &tlLat);
             CCommons::convertTopLeft2AvabilityIndex(tlLon, tlLat, HGT_SOURCE_DEGREE_SIZE_L04_L08, &index);
-            avability_L04_L08[index].setAvailable(fileInfo.fileName());
+            avability_L04_L08[index].setAvailable(fileInfo.fileName(), fileInfo.lastModified().toTime_t());
         }
     }
 
@@ -923,7 +1294,7 @@ void CCacheManager::setupAvabilityTables()
         if (fileInfo.size()==33570818 && fileInfo.suffix()=="hgt") {
             CCommons::convertFileNameToLonLat(fileInfo.fileName(), &tlLon, &tlLat);
             CCommons::convertTopLeft2AvabilityIndex(tlLon, tlLat, HGT_SOURCE_DEGREE_SIZE_L09_L13, &index);
-            avability_L09_L13[index].setAvailable(fileInfo.fileName());
+            avability_L09_L13[index].setAvailable(fileInfo.fileName(), fileInfo.lastModified().toTime_t());
         }
     }
 
@@ -938,18 +1309,16 @@ void CCacheManager::setupAvabilityTables()
         if (fileInfo.size()==2884802 && fileInfo.suffix()=="hgt") {
             CCommons::convertSRTMfileNameToLonLat(fileInfo.fileName(), &tlLon, &tlLat);
             CCommons::convertTopLeft2AvabilityIndex(tlLon, tlLat, HGT_SOURCE_DEGREE_SIZE_SRTM, &index);
-            avability_SRTM[index].setAvailable(fileInfo.fileName());
+            avability_SRTM[index].setAvailable(fileInfo.fileName(), fileInfo.lastModified().toTime_t());
         }
     }
 }
 
 void CCacheManager::setupTextureAvalibityTables()
 {
-    int i, index;
-    double tlLon, tlLat;
     QDir dir;
-    QFileInfo fileInfo;
     QFileInfoList list;
+    int i;
     int TEX_width   = (int)(360.0 / TEX_DEGREE_SIZE);
     int TEX_height  = (int)(180.0 / TEX_DEGREE_SIZE);
 
@@ -963,56 +1332,62 @@ void CCacheManager::setupTextureAvalibityTables()
     dir.setFilter(QDir::Files | QDir::NoSymLinks);
     dir.setSorting(QDir::Name);
     list = dir.entryInfoList();
-    for (i=0; i<list.size(); i++) {
-        fileInfo = list.at(i);
-        if (fileInfo.size()==27648 && fileInfo.suffix()=="raw") {
-            CCommons::convertFileNameToLonLat(fileInfo.fileName(), &tlLon, &tlLat);
-            CCommons::convertTopLeft2AvabilityIndex(tlLon, tlLat, TEX_DEGREE_SIZE, &index);
-            avabilityTex_L00_L02[index].setAvailable(fileInfo.fileName());
-        }
-    }
+    for (i=0; i<list.size(); i++)
+        setTextureAvailable(avabilityTex_L00_L02, list.at(i), 27648);
 
     // L03-L05 levels
     dir.setPath(pathTexL03_L05);
     dir.setFilter(QDir::Files | QDir::NoSymLinks);
     dir.setSorting(QDir::Name);
     list = dir.entryInfoList();
-    for (i=0; i<list.size(); i++) {
-        fileInfo = list.at(i);
-        if (fileInfo.size()==1769472 && fileInfo.suffix()=="raw") {
-            CCommons::convertFileNameToLonLat(fileInfo.fileName(), &tlLon, &tlLat);
-            CCommons::convertTopLeft2AvabilityIndex(tlLon, tlLat, TEX_DEGREE_SIZE, &index);
-            avabilityTex_L03_L05[index].setAvailable(fileInfo.fileName());
-        }
-    }
+    for (i=0; i<list.size(); i++)
+        setTextureAvailable(avabilityTex_L03_L05, list.at(i), 1769472);
 
     // L06-L08 levels
     dir.setPath(pathTexL06_L08);
     dir.setFilter(QDir::Files | QDir::NoSymLinks);
     dir.setSorting(QDir::Name);
     list = dir.entryInfoList();
-    for (i=0; i<list.size(); i++) {
-        fileInfo = list.at(i);
-        if (fileInfo.size()==113246208 && fileInfo.suffix()=="raw") {
-            CCommons::convertFileNameToLonLat(fileInfo.fileName(), &tlLon, &tlLat);
-            CCommons::convertTopLeft2AvabilityIndex(tlLon, tlLat, TEX_DEGREE_SIZE, &index);
-            avabilityTex_L06_L08[index].setAvailable(fileInfo.fileName());
-        }
-    }
+    for (i=0; i<list.size(); i++)
+        setTextureAvailable(avabilityTex_L06_L08, list.at(i), 113246208);
 
     // L09-L10 levels
     dir.setPath(pathTexL09_L10);
     dir.setFilter(QDir::Files | QDir::NoSymLinks);
     dir.setSorting(QDir::Name);
     list = dir.entryInfoList();
-    for (i=0; i<list.size(); i++) {
-        fileInfo = list.at(i);
-        if (fileInfo.size()==1811939328 && fileInfo.suffix()=="raw") {
-            CCommons::convertFileNameToLonLat(fileInfo.fileName(), &tlLon, &tlLat);
-            CCommons::convertTopLeft2AvabilityIndex(tlLon, tlLat, TEX_DEGREE_SIZE, &index);
-            avabilityTex_L09_L10[index].setAvailable(fileInfo.fileName());
-        }
+    for (i=0; i<list.size(); i++)
+        setTextureAvailable(avabilityTex_L09_L10, list.at(i), 1811939328);
+}
+
+void CCacheManager::setTextureAvailable(CAvability *texAvability, const QFileInfo &fileInfo, qint64 rawBytes)
+{
+    double tlLon, tlLat;
+    unsigned int lastModified;
+    int index;
+    bool tiled;
+
+    if (fileInfo.size()==rawBytes && fileInfo.suffix()=="raw")
+        tiled = false;
+    else if (fileInfo.size()==rawBytes+RAW_TILED_HEADER_SIZE && fileInfo.suffix()==RAW_TILED_SUFFIX)
+        tiled = true;
+    else
+        return;
+
+    lastModified = fileInfo.lastModified().toTime_t();
+    CCommons::convertFileNameToLonLat(fileInfo.completeBaseName() + ".raw", &tlLon, &tlLat);
+    CCommons::convertTopLeft2AvabilityIndex(tlLon, tlLat, TEX_DEGREE_SIZE, &index);
+
+    // blocked file is used instead of .raw file only when it isn't older than .raw file it was converted from
+    if (texAvability[index].available) {
+        if (tiled && lastModified<texAvability[index].lastModified)
+            return;
+        if (!tiled && texAvability[index].tiled && texAvability[index].lastModified>=lastModified)
+            return;
     }
+
+    texAvability[index].setAvailable(fileInfo.fileName(), lastModified);
+    texAvability[index].tiled = tiled;
 }
 
 
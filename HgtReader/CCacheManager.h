@@ -45,10 +45,19 @@
 
 #include <QString>
 #include <QTime>
+#include <QColor>
+#include <QVector2D>
+#include <QFileInfo>
 #include "CEarth.h"
 #include "CCachedTerrainDataGroup.h"
 #include "CAvability.h"
 #include "CRawFile.h"
+#include "CTileDiskCache.h"
+#include "CTerrainContainer.h"
+#include "CTextureTiles.h"
+#include "CHeightRangeTable.h"
+#include "CCacheTrace.h"
+#include "CIoStats.h"
 
 #define HGT_SOURCE_L00_L03                 0
 #define HGT_SOURCE_L04_L08                 1
@@ -75,7 +84,22 @@
 #define TEX_DEGREE_SIZE                   45.00
 #define TEX_EMPTY_COLOR             0xEEFFEE
 #define TEX_TERRAIN_SIZE                  32
-#define CACHE_MAX_UNUSED_TERRAIN_DATA  50000
+#define CACHE_MAX_UNUSED_TERRAIN_DATA   5000      // expanded terrain data not in use (hot tier)
+#define CACHE_MAX_COMPACT_TERRAIN_DATA 500000      // compact terrain data (cold tier)
+
+// bytes held by each part of program - sent to UI with cache info
+class CMemoryCounters
+{
+public:
+    CMemoryCounters();
+
+    qint64 quadtreeBytes;                   // CTerrain nodes of both earth buffers
+    qint64 terrainDataBytes;                // cached terrain data - expanded, compact and cache entries
+    qint64 pendingTextureBytes;             // part of terrainDataBytes - textures not uploaded to VRAM yet
+    qint64 vramBytes;                       // estimated GL texture memory
+    qint64 tablesBytes;                     // avability tables, cache groups and data shared by terrains
+    qint64 performanceHistoryBytes;         // CPerformance rings and events
+};
 
 class CCacheManager
 {
@@ -97,6 +121,10 @@ public:
     QString pathL04_L08_index;
     QString pathL09_L13_index;
     QString pathSRTM_index;
+    QString pathTileCache;
+    QString pathTerrainContainer;
+    QString pathTextureTiles;
+    QString pathHeightRangeTable;
     CAvability *avability_L00_L03;       // tile size = 60.00 deg
     CAvability *avability_L04_L08;       // tile size = 15.00 deg
     CAvability *avability_L09_L13;       // tile size =  3.75 deg
@@ -123,16 +151,33 @@ public:
     CCachedTerrainDataGroup *cachedTerrainDataGroup_L04_L08;      // cached terrain data database
     CCachedTerrainDataGroup *cachedTerrainDataGroup_L09_L13;      // cached terrain data database
     QTime cacheTime;
+    CTileDiskCache *tileDiskCache;        // generated terrains from previous runs
+    CTerrainContainer *terrainContainer;  // all HGT levels in one file - HGT directories are not used when open
+    CTextureTiles *textureTiles;          // pre-built texture of each terrain - RAW files are not used when open
+    CHeightRangeTable *heightRangeTable;  // pre-built height ranges of finest source for flat terrain check
+    CCacheTrace *cacheTrace;              // optional log of find/register/free/keep size for offline replay
+    CIoStats *ioStats;                    // reads from HGT and RAW directories
+    unsigned char *emptyTexture;          // TEX_EMPTY_COLOR texture shared by all terrains without RAW files
+    unsigned int emptyTextureID;          // VRAM copy of emptyTexture - uploaded once by OpenGL thread
+    int textureCompressionSupport;        // S3TC support of graphic card, -1 until checked by OpenGL thread
+    void *compressedTexImage2D;           // glCompressedTexImage2D entry point resolved by OpenGL thread
+    QColor *seaLevelColors;               // colors shared by all terrains with heights at sea level
+    QVector2D *terrainUv;                 // texture coordinates shared by all terrains up to TEX_SOURCE_MAX_LOD
 
     void getTerrainPoints(double lon, double lat, int lod,
                           int *points, int *pointNW, int *pointNE, int *pointSW, int *pointSE,
-                          int *pointsN, int *pointsE, int *pointsS, int *pointsW, unsigned char *texture,
+                          int *pointsN, int *pointsE, int *pointsS, int *pointsW,
+                          unsigned char *texture, unsigned char *textureCompressed,
                           bool dontUseDiskHgt, bool dontUseDiskRaw);
+    bool getTextureTile(const double &tlLon, const double &tlLat, const int &lod, unsigned char *texture, unsigned char *textureCompressed);
+    int getChildrenHeightRange(const double &tlLon, const double &tlLat, const int &lod);
+    unsigned int getSourceStamp(const double &tlLon, const double &tlLat, const int &lod);
     void setEarthBuffers(CEarth *eBuffA, CEarth *eBuffB);
     bool cacheTerrainDataFind(const double lon, const double lat, const int lod, const CEarth *earth, CTerrainData **terrainData);
     void cacheTerrainDataRegister(const CEarth *earth, CTerrainData **terrainData);
     void cacheTerrainDataFree(const CEarth *earth, CTerrainData **terrainData, const bool &dontSaveJustDelete);
     void cacheInfo(int *cTDCount, int *cTDInUseCount, int *cTDNotInUseCount, int *cTDEmptyEntryCount, unsigned int *cMinNotInUseTime);
+    void memoryInfo(CMemoryCounters *counters);
     void cacheClear(CEarth *earth);
     void cacheKeepSize(CEarth *earth);
 
@@ -143,14 +188,28 @@ public:
     int cachedTerrainDataNotInUseCount;
     int cachedTerrainDataEmptyEntryCount;
     unsigned int cacheMinNotInUseTime;
+    int cachedTerrainDataCompactCount;
+    unsigned int cacheMinCompactTime;
+    qint64 tablesBytes;                   // tables don't change after start - counted once
 
     bool findRawFiles(const double &tlLon, const double &tlLat, const int &lod, int *RAWfilesIndex, int *pixOffsetLon, int *pixOffsetLat);
     void buildTextureFromRawFiles(const double &tlLon, const double &tlLat, const int &lod, CRawFile *terrainTexture);
+    void getContainerTerrainPoints(const double &lon, const double &lat, const int &lod,
+                                   int *points, int *pointNW, int *pointNE, int *pointSW, int *pointSE,
+                                   int *pointsN, int *pointsE, int *pointsS, int *pointsW);
+    void findContainerXY(const double &lon, const double &lat, const int &lod, int *x, int *y);
     void findHgtFileName(const double &lon, const double &lat, const int &lod, QString *filePath, bool *fileFound, int *x, int *y, int *hgtSkipping, int *hgtSize);
+    CAvability *findHgtAvability(const double &lon, const double &lat, const int &lod);
+    int getHgtIoSource(const int &lod);
+    int getTexIoSource(const int &lod);
     void setupAvabilityTables();
     void setupCachedTerrainDataTables();
     void setupTextureAvalibityTables();
+    void setTextureAvailable(CAvability *texAvability, const QFileInfo &fileInfo, qint64 rawBytes);
     void setupStripIndex();
+    void setupSharedTerrainData();
+    qint64 getTablesBytes();
+    static qint64 getAvabilityBytes(const CAvability *avability, int count);
 };
 
 #endif // CCACHEMANAGER_H
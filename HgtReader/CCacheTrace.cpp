@@ -0,0 +1,222 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QMutexLocker>
+#include <QDebug>
+#include "CCacheTrace.h"
+
+CCacheTraceRecord::CCacheTraceRecord()
+{
+    time = 0;
+    operation = CACHE_TRACE_FIND;
+    earth = CACHE_TRACE_EARTH_A;
+    lod = 0;
+    found = 0;
+    topLeftLon = 0.0;
+    topLeftLat = 0.0;
+}
+
+void CCacheTraceRecord::save(QDataStream &stream) const
+{
+    stream << time << operation << earth << lod << found;
+    stream << topLeftLon << topLeftLat;
+}
+
+bool CCacheTraceRecord::load(QDataStream &stream)
+{
+    stream >> time >> operation >> earth >> lod >> found;
+    stream >> topLeftLon >> topLeftLat;
+
+    if (stream.status()!=QDataStream::Ok)
+        return false;
+    if (operation>CACHE_TRACE_KEEP_SIZE || earth>CACHE_TRACE_EARTH_B || lod>13)
+        return false;
+
+    return true;
+}
+
+CCacheTrace::CCacheTrace()
+{
+    recording = false;
+    recordCount = 0;
+    buffer.reserve(CACHE_TRACE_BUFFER);
+}
+
+CCacheTrace::~CCacheTrace()
+{
+    stop();
+}
+
+bool CCacheTrace::start(const QString &fileName)
+{
+    QMutexLocker locker(&mutex);
+    QMutexLocker fileLocker(&fileMutex);
+
+    if (recording)
+        return false;
+
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning("Cache trace - could not write %s", qPrintable(fileName));
+        return false;
+    }
+
+    stream.setDevice(&file);
+    stream << (quint32)CACHE_TRACE_MAGIC << (quint32)CACHE_TRACE_VERSION;
+    buffer.clear();
+    recordCount = 0;
+    timer.start();
+    recording = true;
+
+    return true;
+}
+
+void CCacheTrace::stop()
+{
+    QVector<CCacheTraceRecord> pending;
+
+    mutex.lock();
+    if (!recording) {
+        mutex.unlock();
+        return;
+    }
+    recording = false;
+    pending = buffer;                   // implicitly shared - no copy
+    buffer.clear();
+    fileMutex.lock();
+    mutex.unlock();
+
+    flush(&pending);
+    stream.setDevice(0);
+    file.close();
+    fileMutex.unlock();
+}
+
+int CCacheTrace::getRecordCount()
+{
+    QMutexLocker locker(&mutex);
+
+    return recordCount;
+}
+
+void CCacheTrace::record(int operation, int earth, double topLeftLon, double topLeftLat, int lod, bool found)
+{
+    CCacheTraceRecord r;
+    QVector<CCacheTraceRecord> pending;
+
+    mutex.lock();
+
+    // trace could be stopped between isRecording() and lock
+    if (!recording) {
+        mutex.unlock();
+        return;
+    }
+
+    r.time = (quint32)timer.elapsed();
+    r.operation = (quint8)operation;
+    r.earth = (quint8)earth;
+    r.lod = (quint8)lod;
+    r.found = found ? 1 : 0;
+    r.topLeftLon = topLeftLon;
+    r.topLeftLat = topLeftLat;
+    buffer.append(r);
+    recordCount++;
+
+    if (buffer.size()<CACHE_TRACE_BUFFER) {
+        mutex.unlock();
+        return;
+    }
+
+    // full buffer is taken out and written after unlock - other threads keep recording meanwhile
+    pending = buffer;
+    buffer.clear();
+    buffer.reserve(CACHE_TRACE_BUFFER);
+    fileMutex.lock();
+    mutex.unlock();
+
+    flush(&pending);
+    fileMutex.unlock();
+}
+
+// fileMutex has to be locked
+void CCacheTrace::flush(QVector<CCacheTraceRecord> *pending)
+{
+    int i;
+
+    for (i=0; i<pending->size(); i++)
+        pending->at(i).save(stream);
+
+    if (stream.status()!=QDataStream::Ok)
+        qWarning("Cache trace - could not write %s", qPrintable(file.fileName()));
+}
+
+bool CCacheTrace::load(const QString &fileName, QVector<CCacheTraceRecord> *records)
+{
+    QFile traceFile(fileName);
+    CCacheTraceRecord r;
+    quint32 magic, version;
+
+    records->clear();
+    if (!traceFile.open(QIODevice::ReadOnly)) {
+        qWarning("Cache trace - could not open %s", qPrintable(fileName));
+        return false;
+    }
+
+    QDataStream traceStream(&traceFile);
+    traceStream >> magic >> version;
+    if (traceStream.status()!=QDataStream::Ok || magic!=CACHE_TRACE_MAGIC || version!=CACHE_TRACE_VERSION) {
+        qWarning("Cache trace - %s is not cache trace file", qPrintable(fileName));
+        return false;
+    }
+
+    // records are written until trace is stopped - no count in header
+    while (!traceStream.atEnd()) {
+        if (!r.load(traceStream)) {
+            qWarning("Cache trace - %s is damaged", qPrintable(fileName));
+            records->clear();
+            return false;
+        }
+        records->append(r);
+    }
+
+    return true;
+}
@@ -0,0 +1,111 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CCACHETRACE_H
+#define CCACHETRACE_H
+
+#include <QString>
+#include <QVector>
+#include <QFile>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QMutex>
+
+#define CACHE_TRACE_FILE        "cachetrace.hct"
+#define CACHE_TRACE_MAGIC       0x48435443      // "HCTC"
+#define CACHE_TRACE_VERSION     1
+#define CACHE_TRACE_BUFFER      4096            // records kept in memory before they are written
+
+#define CACHE_TRACE_FIND           0
+#define CACHE_TRACE_REGISTER       1
+#define CACHE_TRACE_FREE           2
+#define CACHE_TRACE_KEEP_SIZE      3
+
+#define CACHE_TRACE_EARTH_A        0
+#define CACHE_TRACE_EARTH_B        1
+
+// one cache operation - key of terrain (top left corner and LOD), earth buffer and time
+class CCacheTraceRecord
+{
+public:
+    CCacheTraceRecord();
+
+    quint32 time;                       // ms since trace start
+    quint8 operation;
+    quint8 earth;
+    quint8 lod;                         // not used by CACHE_TRACE_KEEP_SIZE
+    quint8 found;                       // result of CACHE_TRACE_FIND
+    double topLeftLon;
+    double topLeftLat;
+
+    void save(QDataStream &stream) const;
+    bool load(QDataStream &stream);
+};
+
+// logs cache operations of CCacheManager to binary file - replayed offline by HgtCacheReplay
+class CCacheTrace
+{
+public:
+    CCacheTrace();
+    ~CCacheTrace();
+
+    bool start(const QString &fileName);
+    void stop();
+    bool isRecording() const { return recording; }
+    int getRecordCount();
+    void record(int operation, int earth, double topLeftLon, double topLeftLat, int lod, bool found);
+    static bool load(const QString &fileName, QVector<CCacheTraceRecord> *records);
+
+private:
+    QMutex mutex;                       // guards buffer, recording and recordCount
+    QMutex fileMutex;                   // guards file and stream - locked after mutex so buffers are written in order
+    QFile file;
+    QDataStream stream;
+    QElapsedTimer timer;
+    QVector<CCacheTraceRecord> buffer;
+    volatile bool recording;            // checked without mutex - cache operations are not slowed down when trace is off
+    int recordCount;
+
+    void flush(QVector<CCacheTraceRecord> *pending);
+};
+
+#endif // CCACHETRACE_H
@@ -45,6 +45,7 @@
 CCachedTerrainData::CCachedTerrainData()
 {
     terrainData = 0;
+    compactTerrainData = 0;
     terrainAinUse = false;
     terrainBinUse = false;
     time = 0;
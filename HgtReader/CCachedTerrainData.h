@@ -44,6 +44,7 @@
 #define CCACHEDTERRAINDATA_H
 
 #include "CTerrainData.h"
+#include "CCompactTerrainData.h"
 
 
 class CCachedTerrainData
@@ -51,7 +52,8 @@ class CCachedTerrainData
 public:
     CCachedTerrainData();
 
-    CTerrainData *terrainData;
+    CTerrainData *terrainData;                  // hot - expanded terrain data ready for drawing
+    CCompactTerrainData *compactTerrainData;    // cold - terrain data not in use packed to save memory
     bool terrainAinUse;
     bool terrainBinUse;
     unsigned int time;
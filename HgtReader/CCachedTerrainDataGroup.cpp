@@ -42,6 +42,7 @@
 
 #include <QDebug>
 #include <QTime>
+#include <QMutexLocker>
 #include "CCachedTerrainDataGroup.h"
 #include "CCacheManager.h"
 
@@ -53,20 +54,27 @@ CCachedTerrainDataGroup::CCachedTerrainDataGroup()
 
 void CCachedTerrainDataGroup::deleteNotInUse(CEarth *earth, unsigned int olderThan)
 {
+    CCacheManager *cacheManager = CCacheManager::getInstance();
     QList<CCachedTerrainData>::iterator i;
+    QMutexLocker locker(&mutex);
 
     for (i=cachedTerrainDataList.begin(); i!=cachedTerrainDataList.end(); i++) {
         if (!i->terrainAinUse && !i->terrainBinUse && i->time<olderThan) {
             if (i->terrainData!=0) {
 
-                // add textureID to removeFromVRAM list
-                if (earth!=0 && i->terrainData->getTextureID()!=0) {
+                // add textureID to removeFromVRAM list (shared texture stays in VRAM)
+                if (earth!=0 && i->terrainData->getTextureID()!=0 &&
+                    i->terrainData->getTextureID()!=cacheManager->emptyTextureID) {
                     earth->textureIDListToRemoveFromVRAM.append( i->terrainData->getTextureID() );
                 }
 
                 delete i->terrainData;
                 i->terrainData = 0;
             }
+            if (i->compactTerrainData!=0) {
+                delete i->compactTerrainData;
+                i->compactTerrainData = 0;
+            }
             //cachedTerrainDataList.erase(i);
             //continue;
         }
@@ -74,12 +82,56 @@ void CCachedTerrainDataGroup::deleteNotInUse(CEarth *earth, unsigned int olderTh
     }
 }
 
+void CCachedTerrainDataGroup::cachedTerrainDataMemoryInfo(qint64 *terrainDataBytes, qint64 *pendingTextureBytes, qint64 *vramBytes)
+{
+    const CCachedTerrainData *ctd;
+    int i;
+    QMutexLocker locker(&mutex);
+
+    (*terrainDataBytes) += cachedTerrainDataList.size()*sizeof(CCachedTerrainData);
+    for (i=0; i<cachedTerrainDataList.size(); i++) {
+        ctd = &cachedTerrainDataList.at(i);
+
+        if (ctd->terrainData!=0) {
+            (*terrainDataBytes) += ctd->terrainData->getMemoryBytes();
+            (*pendingTextureBytes) += ctd->terrainData->getPendingTextureBytes();
+            (*vramBytes) += ctd->terrainData->getVramBytes();
+        }
+        if (ctd->compactTerrainData!=0)
+            (*terrainDataBytes) += ctd->compactTerrainData->getMemoryBytes();
+    }
+}
+
+void CCachedTerrainDataGroup::compactNotInUse(CEarth *earth, unsigned int olderThan)
+{
+    CCacheManager *cacheManager = CCacheManager::getInstance();
+    QList<CCachedTerrainData>::iterator i;
+    QMutexLocker locker(&mutex);
+
+    for (i=cachedTerrainDataList.begin(); i!=cachedTerrainDataList.end(); i++) {
+        if (!i->terrainAinUse && !i->terrainBinUse && i->time<olderThan && i->terrainData!=0) {
+
+            // add textureID to removeFromVRAM list (shared texture stays in VRAM)
+            if (earth!=0 && i->terrainData->getTextureID()!=0 &&
+                i->terrainData->getTextureID()!=cacheManager->emptyTextureID) {
+                earth->textureIDListToRemoveFromVRAM.append( i->terrainData->getTextureID() );
+            }
+
+            // time is not changed - compacted terrains are still ordered by last use
+            i->compactTerrainData = new CCompactTerrainData(i->terrainData);
+            delete i->terrainData;
+            i->terrainData = 0;
+        }
+    }
+}
+
 bool CCachedTerrainDataGroup::cachedTerrainDataListFind(const double tlLon, const double tlLat, const int lod, const CEarth *earth, CTerrainData **terrainData)
 {
     CCacheManager *cacheManager = CCacheManager::getInstance();
     QList<CCachedTerrainData>::iterator i;
     bool found = false;
     int match;
+    QMutexLocker locker(&mutex);
 
     // check integrity
     if (earth!=cacheManager->earthBufferA && earth!=cacheManager->earthBufferB) {
@@ -89,18 +141,31 @@ bool CCachedTerrainDataGroup::cachedTerrainDataListFind(const double tlLon, cons
     // search existing entry
     for (i=cachedTerrainDataList.begin(); i!=cachedTerrainDataList.end(); i++) {
         match = 0;
-        if (i->terrainData==0) {
+        if (i->terrainData==0 && i->compactTerrainData==0) {
             if (CACHE_SHOW_DEBUG_INFO) qDebug("FIND - empty cache entry");
             continue;
+        } else if (i->terrainData==0) {
+            if (i->compactTerrainData->topLeftLon == tlLon) match++;
+            if (i->compactTerrainData->topLeftLat == tlLat) match++;
+            if (i->compactTerrainData->LOD == lod) match++;
         } else {
             if (i->terrainData->topLeftLon == tlLon) match++;
             if (i->terrainData->topLeftLat == tlLat) match++;
             if (i->terrainData->LOD == lod) match++;
-            if (match==3) {
-                found = true;
-                break;
-            }
         }
+        if (match==3) {
+            found = true;
+            break;
+        }
+    }
+
+    // compacted terrain data is expanded again - no disk access
+    if (found && i->terrainData==0) {
+        if (CACHE_SHOW_DEBUG_INFO) qDebug("FIND - expanding compact terrain data");
+        i->terrainData = new CTerrainData();
+        i->terrainData->initTerrainData(i->compactTerrainData);
+        delete i->compactTerrainData;
+        i->compactTerrainData = 0;
     }
 
     // register pointer
@@ -124,6 +189,7 @@ void CCachedTerrainDataGroup::cachedTerrainDataListRegister(const CEarth *earth,
     CCachedTerrainData cTDNew;
     bool found = false;
     int match;
+    QMutexLocker locker(&mutex);
 
     // check integrity
     if (earth!=cacheManager->earthBufferA && earth!=cacheManager->earthBufferB) {
@@ -133,20 +199,37 @@ void CCachedTerrainDataGroup::cachedTerrainDataListRegister(const CEarth *earth,
     // search existing entry
     for (i=cachedTerrainDataList.begin(); i!=cachedTerrainDataList.end(); i++) {
         match = 0;
-        if (i->terrainData==0) {
+        if (i->terrainData==0 && i->compactTerrainData==0) {
             if (CACHE_SHOW_DEBUG_INFO) qDebug("REGISTER - empty cache entry");
             continue;
+        } else if (i->terrainData==0) {
+            if (i->compactTerrainData->topLeftLon == (*terrainData)->topLeftLon) match++;
+            if (i->compactTerrainData->topLeftLat == (*terrainData)->topLeftLat) match++;
+            if (i->compactTerrainData->LOD == (*terrainData)->LOD) match++;
         } else {
             if (i->terrainData->topLeftLon == (*terrainData)->topLeftLon) match++;
             if (i->terrainData->topLeftLat == (*terrainData)->topLeftLat) match++;
             if (i->terrainData->LOD == (*terrainData)->LOD) match++;
-            if (match==3) {
-                found = true;
-                break;
-            }
+        }
+        if (match==3) {
+            found = true;
+            break;
         }
     }
 
+    // compacted copy of the same terrain - new terrain data replaces it
+    if (found && i->terrainData==0) {
+        if (CACHE_SHOW_DEBUG_INFO) qDebug("REGISTER - found compact TerrainData when register new");
+        delete i->compactTerrainData;
+        i->compactTerrainData = 0;
+        i->terrainData = (*terrainData);
+        if (earth==cacheManager->earthBufferA)
+            i->terrainAinUse = true; else
+            i->terrainBinUse = true;
+        i->time = cacheManager->cacheTime.elapsed();
+        return;
+    }
+
     // register pointer
     if (found) {
         if (CACHE_SHOW_DEBUG_INFO) qDebug("REGISTER - found existing TerrainData when register new");
@@ -174,6 +257,7 @@ void CCachedTerrainDataGroup::cachedTerrainDataListFree(const CEarth *earth, CTe
     QList<CCachedTerrainData>::iterator i;
     bool found = false;
     int match;
+    QMutexLocker locker(&mutex);
 
     // check integrity
     if (earth!=cacheManager->earthBufferA && earth!=cacheManager->earthBufferB) {
@@ -211,18 +295,26 @@ void CCachedTerrainDataGroup::cachedTerrainDataListFree(const CEarth *earth, CTe
 
 void CCachedTerrainDataGroup::cachedTerrainDataInfo(int *cachedTerrainCount, int *cachedTerrainInUseCount,
                                                     int *cachedTerrainNotInUseCount, int *cachedTerrainEmptyEntryCount,
-                                                    unsigned int *cacheMinNotInUseTime)
+                                                    unsigned int *cacheMinNotInUseTime,
+                                                    int *cachedTerrainCompactCount, unsigned int *cacheMinCompactTime)
 {
     const CCachedTerrainData *ctd;
     int i;
+    QMutexLocker locker(&mutex);
 
     (*cachedTerrainCount) = cachedTerrainDataList.size();
     for (i=0; i<cachedTerrainDataList.size(); i++) {
         ctd = &cachedTerrainDataList.at(i);
 
-        if (ctd->terrainData==0)
+        if (ctd->terrainData==0 && ctd->compactTerrainData==0)
             (*cachedTerrainEmptyEntryCount)++;
 
+        if (ctd->compactTerrainData!=0) {
+            (*cachedTerrainCompactCount)++;
+            if (ctd->time<(*cacheMinCompactTime))
+                (*cacheMinCompactTime) = ctd->time;
+        }
+
         if (ctd->terrainAinUse || ctd->terrainBinUse)
             (*cachedTerrainInUseCount)++;
 
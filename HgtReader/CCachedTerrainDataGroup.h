@@ -43,6 +43,7 @@
 #ifndef CCACHEDTERRAINDATAGROUP_H
 #define CCACHEDTERRAINDATAGROUP_H
 
+#include <QMutex>
 #include "CCachedTerrainData.h"
 #include "CEarth.h"
 
@@ -57,10 +58,14 @@ public:
     void cachedTerrainDataListFree(const CEarth *earth, CTerrainData **terrainData, const bool &dontSaveJustDelete);
     void cachedTerrainDataInfo(int *cachedTerrainCount, int *cachedTerrainInUseCount,
                                int *cachedTerrainNotInUseCount, int *cachedTerrainEmptyEntryCount,
-                               unsigned int *cacheMinNotInUseTime);
+                               unsigned int *cacheMinNotInUseTime,
+                               int *cachedTerrainCompactCount, unsigned int *cacheMinCompactTime);
+    void cachedTerrainDataMemoryInfo(qint64 *terrainDataBytes, qint64 *pendingTextureBytes, qint64 *vramBytes);
+    void compactNotInUse(CEarth *earth, unsigned int olderThan);
     void deleteNotInUse(CEarth *earth, unsigned int olderThan);
 
 private:
+    QMutex mutex;                       // one lock per group - tree is updated by many threads
     QList<CCachedTerrainData> cachedTerrainDataList;
 };
 
@@ -0,0 +1,274 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QFile>
+#include <QtAlgorithms>
+#include <QDebug>
+#include "CCameraPath.h"
+
+CCameraPathSample::CCameraPathSample()
+{
+    camPositionX = 0.0;
+    camPositionY = 0.0;
+    camPositionZ = 0.0;
+    camLookingDirectionX = 0.0;
+    camLookingDirectionY = 0.0;
+    camLookingDirectionZ = 0.0;
+    camClippingAngleCosine = 0.0;
+    camLinkage = 0;
+    camPerspectiveX = 0.0;
+    camPerspectiveY = 0.0;
+    camPerspectiveZ = 0.0;
+    camPerspectiveLookAtX = 0.0;
+    camPerspectiveLookAtY = 0.0;
+    camPerspectiveLookAtZ = 0.0;
+    earthPointLon = 0.0;
+    earthPointLat = 0.0;
+    earthPointX = 0.0;
+    earthPointY = 0.0;
+    earthPointZ = 0.0;
+    camDistanceToEarthPoint = 0.0;
+    camAltGround = 0.0;
+    camFOV = 0.0;
+    camViewportHeight = 0.0;
+    lodMultiplier = 0.0;
+}
+
+void CCameraPathSample::setFromSnapshot(const CDrawingStateSnapshot *dss)
+{
+    camPositionX = dss->camPosition.x();
+    camPositionY = dss->camPosition.y();
+    camPositionZ = dss->camPosition.z();
+    camLookingDirectionX = dss->camLookingDirectionNormal.x();
+    camLookingDirectionY = dss->camLookingDirectionNormal.y();
+    camLookingDirectionZ = dss->camLookingDirectionNormal.z();
+    camClippingAngleCosine = dss->camClippingAngleCosine;
+    camLinkage = dss->camLinkage;
+    camPerspectiveX = dss->camPerspectiveX;
+    camPerspectiveY = dss->camPerspectiveY;
+    camPerspectiveZ = dss->camPerspectiveZ;
+    camPerspectiveLookAtX = dss->camPerspectiveLookAtX;
+    camPerspectiveLookAtY = dss->camPerspectiveLookAtY;
+    camPerspectiveLookAtZ = dss->camPerspectiveLookAtZ;
+    earthPointLon = dss->earthPointLon;
+    earthPointLat = dss->earthPointLat;
+    earthPointX = dss->earthPointX;
+    earthPointY = dss->earthPointY;
+    earthPointZ = dss->earthPointZ;
+    camDistanceToEarthPoint = dss->camDistanceToEarthPoint;
+    camAltGround = dss->camAltGround;
+    camFOV = dss->camFOV;
+    camViewportHeight = dss->camViewportHeight;
+    lodMultiplier = dss->lodMultiplier;
+}
+
+void CCameraPathSample::applyToSnapshot(CDrawingStateSnapshot *dss) const
+{
+    dss->camPosition.setX(camPositionX);
+    dss->camPosition.setY(camPositionY);
+    dss->camPosition.setZ(camPositionZ);
+    dss->camLookingDirectionNormal.setX(camLookingDirectionX);
+    dss->camLookingDirectionNormal.setY(camLookingDirectionY);
+    dss->camLookingDirectionNormal.setZ(camLookingDirectionZ);
+    dss->camClippingAngleCosine = camClippingAngleCosine;
+    dss->camLinkage = camLinkage;
+    dss->camPerspectiveX = camPerspectiveX;
+    dss->camPerspectiveY = camPerspectiveY;
+    dss->camPerspectiveZ = camPerspectiveZ;
+    dss->camPerspectiveLookAtX = camPerspectiveLookAtX;
+    dss->camPerspectiveLookAtY = camPerspectiveLookAtY;
+    dss->camPerspectiveLookAtZ = camPerspectiveLookAtZ;
+    dss->earthPointLon = earthPointLon;
+    dss->earthPointLat = earthPointLat;
+    dss->earthPointX = earthPointX;
+    dss->earthPointY = earthPointY;
+    dss->earthPointZ = earthPointZ;
+    dss->camDistanceToEarthPoint = camDistanceToEarthPoint;
+    dss->camAltGround = camAltGround;
+    dss->camFOV = camFOV;
+    dss->camViewportHeight = camViewportHeight;
+    dss->lodMultiplier = lodMultiplier;
+}
+
+bool CCameraPathSample::operator==(const CCameraPathSample &sample) const
+{
+    return camPositionX==sample.camPositionX && camPositionY==sample.camPositionY && camPositionZ==sample.camPositionZ &&
+           camLookingDirectionX==sample.camLookingDirectionX && camLookingDirectionY==sample.camLookingDirectionY &&
+           camLookingDirectionZ==sample.camLookingDirectionZ && camClippingAngleCosine==sample.camClippingAngleCosine &&
+           camLinkage==sample.camLinkage &&
+           camPerspectiveX==sample.camPerspectiveX && camPerspectiveY==sample.camPerspectiveY && camPerspectiveZ==sample.camPerspectiveZ &&
+           camPerspectiveLookAtX==sample.camPerspectiveLookAtX && camPerspectiveLookAtY==sample.camPerspectiveLookAtY &&
+           camPerspectiveLookAtZ==sample.camPerspectiveLookAtZ &&
+           earthPointLon==sample.earthPointLon && earthPointLat==sample.earthPointLat &&
+           earthPointX==sample.earthPointX && earthPointY==sample.earthPointY && earthPointZ==sample.earthPointZ &&
+           camDistanceToEarthPoint==sample.camDistanceToEarthPoint && camAltGround==sample.camAltGround &&
+           camFOV==sample.camFOV && camViewportHeight==sample.camViewportHeight && lodMultiplier==sample.lodMultiplier;
+}
+
+void CCameraPathSample::save(QDataStream &stream) const
+{
+    stream << camPositionX << camPositionY << camPositionZ;
+    stream << camLookingDirectionX << camLookingDirectionY << camLookingDirectionZ << camClippingAngleCosine;
+    stream << (qint8)camLinkage;
+    stream << camPerspectiveX << camPerspectiveY << camPerspectiveZ;
+    stream << camPerspectiveLookAtX << camPerspectiveLookAtY << camPerspectiveLookAtZ;
+    stream << earthPointLon << earthPointLat << earthPointX << earthPointY << earthPointZ;
+    stream << camDistanceToEarthPoint << camAltGround;
+    stream << camFOV << camViewportHeight << lodMultiplier;
+}
+
+bool CCameraPathSample::load(QDataStream &stream)
+{
+    qint8 linkage;
+
+    stream >> camPositionX >> camPositionY >> camPositionZ;
+    stream >> camLookingDirectionX >> camLookingDirectionY >> camLookingDirectionZ >> camClippingAngleCosine;
+    stream >> linkage;
+    stream >> camPerspectiveX >> camPerspectiveY >> camPerspectiveZ;
+    stream >> camPerspectiveLookAtX >> camPerspectiveLookAtY >> camPerspectiveLookAtZ;
+    stream >> earthPointLon >> earthPointLat >> earthPointX >> earthPointY >> earthPointZ;
+    stream >> camDistanceToEarthPoint >> camAltGround;
+    stream >> camFOV >> camViewportHeight >> lodMultiplier;
+    camLinkage = (char)linkage;
+
+    return (stream.status()==QDataStream::Ok) ? true : false;
+}
+
+CCameraPath::CCameraPath()
+{
+    ticks = 0;
+}
+
+void CCameraPath::clear()
+{
+    sampleTicks.clear();
+    samples.clear();
+    ticks = 0;
+}
+
+void CCameraPath::record(const CDrawingStateSnapshot *dss)
+{
+    CCameraPathSample sample;
+
+    // still camera does not grow the path - last sample lasts until next one
+    sample.setFromSnapshot(dss);
+    if (samples.isEmpty() || !(samples.last()==sample)) {
+        sampleTicks.append(ticks);
+        samples.append(sample);
+    }
+    ticks++;
+}
+
+int CCameraPath::getTicks() const
+{
+    return ticks;
+}
+
+bool CCameraPath::getSample(int tick, CCameraPathSample *sample) const
+{
+    QList<quint32>::const_iterator it;
+
+    if (tick<0 || tick>=ticks)
+        return false;
+
+    it = qUpperBound(sampleTicks.begin(), sampleTicks.end(), (quint32)tick);
+    (*sample) = samples.at((it - sampleTicks.begin()) - 1);
+
+    return true;
+}
+
+bool CCameraPath::save(const QString &fileName) const
+{
+    QFile file(fileName);
+    int i;
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning("Camera path - could not write %s", qPrintable(fileName));
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream << (quint32)CAMERA_PATH_MAGIC << (quint32)CAMERA_PATH_VERSION;
+    stream << (quint32)ticks << (quint32)samples.size();
+    for (i=0; i<samples.size(); i++) {
+        stream << sampleTicks.at(i);
+        samples.at(i).save(stream);
+    }
+
+    return (stream.status()==QDataStream::Ok) ? true : false;
+}
+
+bool CCameraPath::load(const QString &fileName)
+{
+    QFile file(fileName);
+    CCameraPathSample sample;
+    quint32 magic, version, pathTicks, count, tick;
+    quint32 i;
+
+    clear();
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning("Camera path - could not open %s", qPrintable(fileName));
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream >> magic >> version >> pathTicks >> count;
+    if (stream.status()!=QDataStream::Ok || magic!=CAMERA_PATH_MAGIC || version!=CAMERA_PATH_VERSION) {
+        qWarning("Camera path - %s is not camera path file", qPrintable(fileName));
+        return false;
+    }
+
+    for (i=0; i<count; i++) {
+        stream >> tick;
+        // first sample starts path and ticks only grow - otherwise getSample() would not find them
+        if (!sample.load(stream) || tick>=pathTicks || (i==0 && tick!=0) || (i>0 && tick<=sampleTicks.last())) {
+            qWarning("Camera path - %s is damaged", qPrintable(fileName));
+            clear();
+            return false;
+        }
+        sampleTicks.append(tick);
+        samples.append(sample);
+    }
+    ticks = pathTicks;
+
+    return true;
+}
@@ -0,0 +1,112 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CCAMERAPATH_H
+#define CCAMERAPATH_H
+
+#include <QString>
+#include <QList>
+#include <QDataStream>
+#include "CDrawingStateSnapshot.h"
+
+#define CAMERA_PATH_FILE        "camerapath.hcp"
+#define CAMERA_PATH_MAGIC       0x48435054      // "HCPT"
+#define CAMERA_PATH_VERSION     1
+
+// camera part of CDrawingStateSnapshot - everything that tree updating and drawing read about camera
+class CCameraPathSample
+{
+public:
+    CCameraPathSample();
+
+    double camPositionX;
+    double camPositionY;
+    double camPositionZ;
+    double camLookingDirectionX;
+    double camLookingDirectionY;
+    double camLookingDirectionZ;
+    double camClippingAngleCosine;
+    char camLinkage;
+    double camPerspectiveX;
+    double camPerspectiveY;
+    double camPerspectiveZ;
+    double camPerspectiveLookAtX;
+    double camPerspectiveLookAtY;
+    double camPerspectiveLookAtZ;
+    double earthPointLon;
+    double earthPointLat;
+    double earthPointX;
+    double earthPointY;
+    double earthPointZ;
+    double camDistanceToEarthPoint;
+    double camAltGround;
+    double camFOV;
+    double camViewportHeight;
+    double lodMultiplier;
+
+    void setFromSnapshot(const CDrawingStateSnapshot *dss);
+    void applyToSnapshot(CDrawingStateSnapshot *dss) const;
+    bool operator==(const CCameraPathSample &sample) const;
+    void save(QDataStream &stream) const;
+    bool load(QDataStream &stream);
+};
+
+// camera state of each animation tick - tick is stored only when camera changed since previous one
+class CCameraPath
+{
+public:
+    CCameraPath();
+
+    void clear();
+    void record(const CDrawingStateSnapshot *dss);
+    int getTicks() const;
+    bool getSample(int tick, CCameraPathSample *sample) const;
+    bool save(const QString &fileName) const;
+    bool load(const QString &fileName);
+
+private:
+    QList<quint32> sampleTicks;
+    QList<CCameraPathSample> samples;
+    int ticks;
+};
+
+#endif // CCAMERAPATH_H
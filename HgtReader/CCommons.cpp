@@ -44,6 +44,7 @@
 #include <math.h>
 #include "CCommons.h"
 #include "CCacheManager.h"
+#include "CTileFileName.h"
 
 
 CCommons::CCommons()
@@ -249,32 +250,7 @@ void CCommons::convertFileNameToLonLat(const QString &name, double *lon, double
 
 void CCommons::convertLonLatToFileName(const double &lon, const double &lat, QString *name)
 {
-    double tmpLon, tmpLat;
-    QChar fnLonSide, fnLatSide;
-    QString fnLon, fnLat;
-
-    if (lon>=180.0) {
-        tmpLon = 360.0 - lon;
-        fnLonSide = 'W';
-    } else {
-        tmpLon = lon;
-        fnLonSide = 'E';
-    }
-
-    if (lat>=0.0) {
-        tmpLat = lat;
-        fnLatSide = 'N';
-    } else {
-        tmpLat = -1.0 * lat;
-        fnLatSide = 'S';
-    }
-
-    fnLon = QString::number(tmpLon, 'f', 2).rightJustified(6, QChar('0'));
-    fnLat = QString::number(tmpLat, 'f', 2).rightJustified(5, QChar('0'));
-
-    (*name) = fnLatSide + fnLat + '_' + fnLonSide + fnLon + ".hgt";
-    (*name)[3] = ',';
-    (*name)[11] = ',';
+    (*name) = CTileFileName::getName(lon, lat, "hgt");
 }
 
 void CCommons::convertLonLatToCartesian(const double &lon, const double &lat, double *lonX, double *latY)
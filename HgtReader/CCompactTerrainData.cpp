@@ -0,0 +1,95 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include "CCompactTerrainData.h"
+
+CCompactTerrainData::CCompactTerrainData()
+{
+    int i;
+
+    topLeftLon = 0.0;
+    topLeftLat = 0.0;
+    LOD = -1;
+    childrenHeightRange = -1;
+    for (i=0; i<TERRAIN_HEIGHTS_COUNT; i++)
+        heights[i] = 0;
+}
+
+CCompactTerrainData::CCompactTerrainData(const CTerrainData *terrainData)
+{
+    int i;
+
+    topLeftLon = terrainData->topLeftLon;
+    topLeftLat = terrainData->topLeftLat;
+    LOD = terrainData->LOD;
+    childrenHeightRange = terrainData->childrenHeightRange;
+    for (i=0; i<TERRAIN_HEIGHTS_COUNT; i++)
+        heights[i] = terrainData->heights[i];
+
+    if (!terrainData->textureShared)
+        texture = qCompress((const uchar *)terrainData->texture, 3*32*32);
+}
+
+void CCompactTerrainData::save(QDataStream &stream) const
+{
+    int i;
+
+    stream << topLeftLon << topLeftLat << (qint32)LOD << (qint32)childrenHeightRange;
+    for (i=0; i<TERRAIN_HEIGHTS_COUNT; i++)
+        stream << heights[i];
+    stream << texture;
+}
+
+bool CCompactTerrainData::load(QDataStream &stream)
+{
+    qint32 lod, range;
+    int i;
+
+    stream >> topLeftLon >> topLeftLat >> lod >> range;
+    for (i=0; i<TERRAIN_HEIGHTS_COUNT; i++)
+        stream >> heights[i];
+    stream >> texture;
+    LOD = lod;
+    childrenHeightRange = range;
+
+    return (stream.status()==QDataStream::Ok) ? true : false;
+}
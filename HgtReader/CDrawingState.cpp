@@ -67,11 +67,13 @@ CDrawingState::CDrawingState()
     drawAxes = true;
     sunEnabled = true;
     treeUpdating = true;
+    treeUpdatingBudget = 40;
 
     lodMultiplier = 1.74;
     dontUseCache = false;
     dontUseDiskHgt = false;
     dontUseDiskRaw = false;
+    cameraPathReplaying = false;
 }
 
 void CDrawingState::getDrawingStateSnapshot(CDrawingStateSnapshot *dss)
@@ -100,6 +102,7 @@ void CDrawingState::getDrawingStateSnapshot(CDrawingStateSnapshot *dss)
     dss->drawAxes = drawAxes;
     dss->sunEnabled = sunEnabled;
     dss->treeUpdating = treeUpdating;
+    dss->treeUpdatingBudget = treeUpdatingBudget;
 
     dss->camPosition = camera.camPosition;
     dss->camLookingDirectionNormal = camera.camLookingDirectionNormal;
@@ -120,6 +123,7 @@ void CDrawingState::getDrawingStateSnapshot(CDrawingStateSnapshot *dss)
     dss->camDistanceToEarthPoint = camera.camDistanceToEarthPoint;
     dss->camAltGround = camera.camAltGround;
     dss->camFOV = camera.camFOV;
+    dss->camViewportHeight = camera.windowHeight;
 
     dss->sunPositionGlobe = camera.sunPositionGlobe;
     dss->sunPositionTerrain = camera.sunPositionTerrain;
@@ -129,6 +133,22 @@ void CDrawingState::getDrawingStateSnapshot(CDrawingStateSnapshot *dss)
     dss->dontUseCache = dontUseCache;
     dss->dontUseDiskHgt = dontUseDiskHgt;
     dss->dontUseDiskRaw = dontUseDiskRaw;
+
+    if (cameraPathReplaying)
+        cameraPathSample.applyToSnapshot(dss);
+}
+
+void CDrawingState::setCameraPathSample(const CCameraPathSample &sample)
+{
+    QMutexLocker locker(drawingStateMutex);
+    cameraPathSample = sample;
+    cameraPathReplaying = true;
+}
+
+void CDrawingState::stopCameraPathReplay()
+{
+    QMutexLocker locker(drawingStateMutex);
+    cameraPathReplaying = false;
 }
 
 void CDrawingState::setDrawingStateMutex(QMutex *m)
@@ -334,3 +354,16 @@ void CDrawingState::SLOTlodMultiplierIndexChanged(int index)
         case 9:lodMultiplier = 1.74 * 2.8;  break;
     }
 }
+
+void CDrawingState::SLOTtreeUpdatingBudgetIndexChanged(int index)
+{
+    QMutexLocker locker(drawingStateMutex);
+
+    switch (index) {
+        case 0:treeUpdatingBudget = 0;   break;
+        case 1:treeUpdatingBudget = 10;  break;
+        case 2:treeUpdatingBudget = 20;  break;
+        case 3:treeUpdatingBudget = 40;  break;
+        case 4:treeUpdatingBudget = 80;  break;
+    }
+}
@@ -47,6 +47,7 @@
 #include <QMutex>
 #include "CCamera.h"
 #include "CDrawingStateSnapshot.h"
+#include "CCameraPath.h"
 
 
 class CDrawingState : public QObject
@@ -62,6 +63,8 @@ public:
     CCamera *getCamera();
     void setDrawingStateMutex(QMutex *m);
     void getDrawingStateSnapshot(CDrawingStateSnapshot *dss);       // thread safe (drawingStateMutex)
+    void setCameraPathSample(const CCameraPathSample &sample);      // thread safe (drawingStateMutex)
+    void stopCameraPathReplay();                                    // thread safe (drawingStateMutex)
 
 public slots:
     void SLOTdrawTerrainPointChanged(int state);                    // thread safe (drawingStateMutex)
@@ -87,6 +90,7 @@ public slots:
     void SLOTsunEnabledChanged(int state);                          // thread safe (drawingStateMutex)
     void SLOTtreeUpdatingChanged(int state);                        // thread safe (drawingStateMutex)
     void SLOTlodMultiplierIndexChanged(int index);                  // thread safe (drawingStateMutex)
+    void SLOTtreeUpdatingBudgetIndexChanged(int index);             // thread safe (drawingStateMutex)
     void SLOTdontUseDiskHgtChanged(int state);                      // thread safe (drawingStateMutex)
     void SLOTdontUseDiskRawChanged(int state);                      // thread safe (drawingStateMutex)
     void SLOTdontUseCacheChanged(int state);                        // thread safe (drawingStateMutex)
@@ -114,10 +118,13 @@ private:
     bool drawAxes;
     bool sunEnabled;
     bool treeUpdating;
+    int treeUpdatingBudget;
     double lodMultiplier;
     bool dontUseDiskHgt;
     bool dontUseDiskRaw;
     bool dontUseCache;
+    bool cameraPathReplaying;               // snapshot camera comes from replayed path instead of CCamera
+    CCameraPathSample cameraPathSample;
 };
 
 #endif // CDRAWINGSTATE_H
@@ -70,6 +70,7 @@ public:
     bool drawAxes;
     bool sunEnabled;
     bool treeUpdating;
+    int treeUpdatingBudget;                 // max time of one tree update in ms (0 - no limit)
     QVector3D camPosition;
     QVector3D camLookingDirectionNormal;
     double camClippingAngleCosine;
@@ -88,6 +89,7 @@ public:
     double camDistanceToEarthPoint;
     double camAltGround;
     double camFOV;
+    double camViewportHeight;
     QVector3D sunPositionGlobe;
     QVector3D sunPositionTerrain;
     QVector3D sunLightNormal;
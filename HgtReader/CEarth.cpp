@@ -41,14 +41,22 @@
  */
 
 #include <QDebug>
+#include <QThreadPool>
+#include <QSemaphore>
 #include "CEarth.h"
+#include "CTerrainUpdateTask.h"
 #include "CCacheManager.h"
 #include "CPerformance.h"
+#include "CTraceZone.h"
 
 
 CEarth::CEarth()
 {
     drawingStateSnapshot = 0;
+    terrain = 0;                    // allocated in initLOD_0
+    terrainsUpdated = 0;
+    splitsPostponed = 0;
+    terrainsInTree = 0;
 }
 
 CEarth::~CEarth()
@@ -73,6 +81,7 @@ void CEarth::initLOD_0()
             terrain[i].initTerrainData(lon, lat, 0, drawingStateSnapshot);
             i++;
         }
+    terrainsInTree = 18;
 }
 
 void CEarth::setDrawingStateSnapshot(CDrawingStateSnapshot *dss)
@@ -80,21 +89,64 @@ void CEarth::setDrawingStateSnapshot(CDrawingStateSnapshot *dss)
     drawingStateSnapshot = dss;
 }
 
-void CEarth::updateTerrainTree()
+bool CEarth::updateTerrainTree()
 {
+    CTraceZone zone("CEarth::updateTerrainTree");
     CPerformance *performance = CPerformance::getInstance();
-    int i;
+    CTerrainUpdateTask *tasks[18];
+    CPerformanceCounters counters;
+    QSemaphore tasksDone;
+    double distance[18];
+    double tmpDistance;
+    int order[18];
+    int tmpOrder;
+    int i, j;
 
-    performance->terrainsInTree = 0;
-    performance->maxLOD = -1;
+    updateTime.start();
 
+    // the closest terrains first - when time budget runs out the farthest ones wait for next cycle
     for (i=0; i<18; i++) {
-        terrain[i].updateTerrainTree();
+        order[i] = i;
+        distance[i] = terrain[i].getDistanceToCam();
     }
+    for (i=1; i<18; i++)
+        for (j=i; j>0 && distance[j]<distance[j-1]; j--) {
+            tmpDistance = distance[j]; distance[j] = distance[j-1]; distance[j-1] = tmpDistance;
+            tmpOrder = order[j]; order[j] = order[j-1]; order[j-1] = tmpOrder;
+        }
+
+    // every root terrain is updated by pool thread - closer ones get higher priority
+    for (i=0; i<18; i++) {
+        tasks[i] = new CTerrainUpdateTask(&terrain[order[i]], &tasksDone);
+        QThreadPool::globalInstance()->start(tasks[i], 18-i);
+    }
+    tasksDone.acquire(18);
+
+    for (i=0; i<18; i++) {
+        counters.add(tasks[i]->counters);
+        tasks[i]->unreference();
+    }
+    performance->terrainsInTree = counters.terrainsInTree;
+    performance->maxLOD = counters.maxLOD;
+    terrainsUpdated = counters.terrainsUpdated;
+    splitsPostponed = counters.splitsPostponed;
+    terrainsInTree = counters.terrainsInTree;
+
+    // false when camera didn't change and whole tree was skipped
+    return (terrainsUpdated>0) ? true : false;
+}
+
+bool CEarth::isUpdateBudgetExceeded()
+{
+    if (drawingStateSnapshot->treeUpdatingBudget<=0)
+        return false;
+
+    return (updateTime.elapsed() >= drawingStateSnapshot->treeUpdatingBudget) ? true : false;
 }
 
 void CEarth::draw()
 {
+    CTraceZone zone("CEarth::draw");
     CPerformance *performance = CPerformance::getInstance();
     int i;
 
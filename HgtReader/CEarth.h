@@ -43,6 +43,7 @@
 #ifndef CEARTH_H
 #define CEARTH_H
 
+#include <QTime>
 #include "CTerrain.h"
 #include "CDrawingStateSnapshot.h"
 
@@ -57,11 +58,18 @@ public:
     CDrawingStateSnapshot *drawingStateSnapshot;
     CTerrain *terrain;
     QList<unsigned int> textureIDListToRemoveFromVRAM;
+    int terrainsUpdated;                    // terrains really updated (not skipped) during last tree update
+    int splitsPostponed;                    // splits postponed to next tree update during last one
+    int terrainsInTree;                     // nodes in tree after last update
 
     void initLOD_0();
     void setDrawingStateSnapshot(CDrawingStateSnapshot *dss);
-    void updateTerrainTree();
+    bool updateTerrainTree();
+    bool isUpdateBudgetExceeded();
     void draw();
+
+private:
+    QTime updateTime;
 };
 
 #endif // CEARTH_H
@@ -0,0 +1,127 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "CElevationCodec.h"
+
+QByteArray CElevationCodec::encode(const quint16 *samples, int width, int height)
+{
+    QByteArray planes;
+    uchar *low, *high;
+    quint16 delta, zigzag;
+    int i, x, y;
+
+    planes.resize(2*width*height);
+    low = (uchar *)planes.data();
+    high = low + width*height;
+
+    for (y=0; y<height; y++)
+        for (x=0; x<width; x++) {
+            i = y*width + x;
+            if (y==0)
+                delta = (x==0) ? samples[i] : (quint16)(samples[i] - samples[i-1]);
+            else
+                delta = (quint16)(samples[i] - samples[i-width]);
+
+            zigzag = (quint16)((delta << 1) ^ (((qint16)delta) >> 15));
+            low[i] = (uchar)(zigzag & 0xFF);
+            high[i] = (uchar)(zigzag >> 8);
+        }
+
+    return qCompress(planes);
+}
+
+bool CElevationCodec::decode(const QByteArray &data, quint16 *samples, int width, int height)
+{
+    QByteArray planes = qUncompress(data);
+    const uchar *low, *high;
+    quint16 zigzag, delta;
+    int x, y;
+
+    if (planes.size()!=2*width*height)
+        return false;
+    low = (const uchar *)planes.constData();
+    high = low + width*height;
+
+    // first row - prediction from left sample, serial
+    for (x=0; x<width; x++) {
+        zigzag = (quint16)((high[x] << 8) | low[x]);
+        delta = (quint16)((zigzag >> 1) ^ (0 - (zigzag & 1)));
+        samples[x] = (x==0) ? delta : (quint16)(samples[x-1] + delta);
+    }
+
+    // other rows - prediction from row above, independent samples
+    for (y=1; y<height; y++)
+        decodeRow(low + y*width, high + y*width, samples + (y-1)*width, samples + y*width, width);
+
+    return true;
+}
+
+void CElevationCodec::decodeRow(const uchar *low, const uchar *high, const quint16 *above, quint16 *row, int width)
+{
+    quint16 zigzag, delta;
+    int x = 0;
+
+#ifdef __SSE2__
+    __m128i l, h, z, d, one, zero;
+
+    // 8 samples at once: join byte planes, zigzag decode, add row above
+    one = _mm_set1_epi16(1);
+    zero = _mm_setzero_si128();
+    for (; x+8<=width; x+=8) {
+        l = _mm_loadl_epi64((const __m128i *)(low + x));
+        h = _mm_loadl_epi64((const __m128i *)(high + x));
+        z = _mm_unpacklo_epi8(l, h);
+        d = _mm_xor_si128(_mm_srli_epi16(z, 1), _mm_sub_epi16(zero, _mm_and_si128(z, one)));
+        d = _mm_add_epi16(d, _mm_loadu_si128((const __m128i *)(above + x)));
+        _mm_storeu_si128((__m128i *)(row + x), d);
+    }
+#endif
+
+    for (; x<width; x++) {
+        zigzag = (quint16)((high[x] << 8) | low[x]);
+        delta = (quint16)((zigzag >> 1) ^ (0 - (zigzag & 1)));
+        row[x] = (quint16)(above[x] + delta);
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CELEVATIONCODEC_H
+#define CELEVATIONCODEC_H
+
+#include <QByteArray>
+
+// lossless coding of height samples block:
+//   - first row is predicted from left sample, other rows from sample above
+//   - prediction errors are zigzag coded (small negative values become small positive)
+//   - low and high bytes are stored in two planes - high plane is mostly zeros
+//   - planes are qCompress'ed
+// decoding of rows predicted from row above is vectorised with SSE2 when available
+class CElevationCodec
+{
+public:
+    static QByteArray encode(const quint16 *samples, int width, int height);
+    static bool decode(const QByteArray &data, quint16 *samples, int width, int height);
+
+private:
+    static void decodeRow(const uchar *low, const uchar *high, const quint16 *above, quint16 *row, int width);
+};
+
+#endif // CELEVATIONCODEC_H
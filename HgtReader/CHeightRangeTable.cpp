@@ -0,0 +1,229 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QDataStream>
+#include <math.h>
+#include "CHeightRangeTable.h"
+
+CHeightRange::CHeightRange()
+{
+    chunkMin.resize(HEIGHT_RANGE_CHUNKS*HEIGHT_RANGE_CHUNKS);
+    chunkMax.resize(HEIGHT_RANGE_CHUNKS*HEIGHT_RANGE_CHUNKS);
+    clear();
+}
+
+void CHeightRange::clear()
+{
+    fileMin = 65535;
+    fileMax = 0;
+    chunkMin.fill(65535);
+    chunkMax.fill(0);
+}
+
+void CHeightRange::addSample(int x, int y, int hgt)
+{
+    int cx[2], cy[2];
+    int countX, countY, i, j, index;
+
+    // SRTM data error marked as very hight altidute - same as CHgtFile::fileGetHeightMinMax
+    if (hgt>9000)
+        hgt = 10;
+
+    if (hgt<fileMin) fileMin = hgt;
+    if (hgt>fileMax) fileMax = hgt;
+
+    // edge sample of chunk is also the first sample of next chunk
+    countX = 0;
+    if (x<HEIGHT_RANGE_FILE_SAMPLES - 1) cx[countX++] = x / HEIGHT_RANGE_CHUNK_INTERVALS;
+    if (x>0 && x % HEIGHT_RANGE_CHUNK_INTERVALS==0) cx[countX++] = x / HEIGHT_RANGE_CHUNK_INTERVALS - 1;
+    countY = 0;
+    if (y<HEIGHT_RANGE_FILE_SAMPLES - 1) cy[countY++] = y / HEIGHT_RANGE_CHUNK_INTERVALS;
+    if (y>0 && y % HEIGHT_RANGE_CHUNK_INTERVALS==0) cy[countY++] = y / HEIGHT_RANGE_CHUNK_INTERVALS - 1;
+
+    for (j=0; j<countY; j++)
+        for (i=0; i<countX; i++) {
+            index = cy[j]*HEIGHT_RANGE_CHUNKS + cx[i];
+            if (hgt<chunkMin[index]) chunkMin[index] = hgt;
+            if (hgt>chunkMax[index]) chunkMax[index] = hgt;
+        }
+}
+
+QByteArray CHeightRange::toBytes() const
+{
+    QByteArray bytes;
+    int i;
+
+    // big endian like samples in HGT file
+    bytes.resize(HEIGHT_RANGE_ENTRY_BYTES);
+    bytes[0] = (char)((fileMin & 0xFF00) >> 8);
+    bytes[1] = (char)(fileMin & 0xFF);
+    bytes[2] = (char)((fileMax & 0xFF00) >> 8);
+    bytes[3] = (char)(fileMax & 0xFF);
+    for (i=0; i<HEIGHT_RANGE_CHUNKS*HEIGHT_RANGE_CHUNKS; i++) {
+        bytes[4 + 4*i]     = (char)((chunkMin.at(i) & 0xFF00) >> 8);
+        bytes[4 + 4*i + 1] = (char)(chunkMin.at(i) & 0xFF);
+        bytes[4 + 4*i + 2] = (char)((chunkMax.at(i) & 0xFF00) >> 8);
+        bytes[4 + 4*i + 3] = (char)(chunkMax.at(i) & 0xFF);
+    }
+
+    return bytes;
+}
+
+CHeightRangeTable::CHeightRangeTable()
+{
+    lastModified = 0;
+}
+
+int CHeightRangeTable::getFileIndex(int fx, int fy)
+{
+    return fy*(int)(360.0 / HEIGHT_RANGE_FILE_DEGREE_SIZE) + fx;
+}
+
+bool CHeightRangeTable::open(const QString &fileName)
+{
+    QDataStream *stream;
+    quint32 magic, version, fileSamples, chunkIntervals;
+    quint64 indexOffset, entryCount;
+
+    if (!indexedFile.open(fileName))
+        return false;
+    stream = indexedFile.getStream();
+
+    (*stream) >> magic >> version >> fileSamples >> chunkIntervals;
+    if (magic!=HEIGHT_RANGE_TABLE_MAGIC || version!=HEIGHT_RANGE_TABLE_VERSION ||
+        fileSamples!=HEIGHT_RANGE_FILE_SAMPLES || chunkIntervals!=HEIGHT_RANGE_CHUNK_INTERVALS) {
+        qWarning("Height range table - unknown format of %s", qPrintable(fileName));
+        indexedFile.close();
+        return false;
+    }
+    (*stream) >> indexOffset >> entryCount;
+
+    // all entries have the same size - it isn't stored in index
+    if (!indexedFile.readIndex(HEIGHT_RANGE_TABLE_HEADER_SIZE, indexOffset, entryCount, HEIGHT_RANGE_TABLE_INDEX_RECORD,
+                               HEIGHT_RANGE_ENTRY_BYTES, 0)) {
+        qWarning("Height range table - index of %s is corrupted", qPrintable(fileName));
+        indexedFile.close();
+        return false;
+    }
+    lastModified = indexedFile.lastModified;
+
+    return true;
+}
+
+int CHeightRangeTable::getHeightRange(double tlLon, double tlLat, double degreeSize, CIoCounters *io)
+{
+    double chunkDegreeSize = HEIGHT_RANGE_FILE_DEGREE_SIZE / HEIGHT_RANGE_CHUNKS;
+    int minHeight, maxHeight;
+    int filesPerSide, chunks;
+    int fx, fy, cx, cy, x, y;
+
+    // without table range is unknown - terrain may be split
+    if (!isOpen())
+        return -1;
+
+    // LOD degree sizes are powers of 2 fractions of 60 deg - corners lie exactly on file & chunk boundaries
+    fx = (int)floor(tlLon / HEIGHT_RANGE_FILE_DEGREE_SIZE);
+    fy = (int)floor((90.0 - tlLat) / HEIGHT_RANGE_FILE_DEGREE_SIZE);
+    minHeight = 65535;
+    maxHeight = 0;
+
+    if (degreeSize>=HEIGHT_RANGE_FILE_DEGREE_SIZE) {
+        // terrain covers whole files
+        filesPerSide = (int)(degreeSize / HEIGHT_RANGE_FILE_DEGREE_SIZE + 0.5);
+        for (y=0; y<filesPerSide; y++)
+            for (x=0; x<filesPerSide; x++)
+                if (!addFileRange(fx + x, fy + y, 0, 0, HEIGHT_RANGE_CHUNKS, &minHeight, &maxHeight, io))
+                    return -1;
+    } else {
+        // terrain smaller than chunk gets range of whole chunk - never smaller than real range
+        cx = (int)floor((tlLon - fx*HEIGHT_RANGE_FILE_DEGREE_SIZE) / chunkDegreeSize);
+        cy = (int)floor((90.0 - tlLat - fy*HEIGHT_RANGE_FILE_DEGREE_SIZE) / chunkDegreeSize);
+        chunks = (int)(degreeSize / chunkDegreeSize + 0.5);
+        if (chunks<1) chunks = 1;
+        if (!addFileRange(fx, fy, cx, cy, chunks, &minHeight, &maxHeight, io))
+            return -1;
+    }
+
+    return maxHeight - minHeight;
+}
+
+bool CHeightRangeTable::addFileRange(int fx, int fy, int cx, int cy, int chunks, int *minHeight, int *maxHeight, CIoCounters *io)
+{
+    int width = (int)(360.0 / HEIGHT_RANGE_FILE_DEGREE_SIZE);
+    int height = (int)(180.0 / HEIGHT_RANGE_FILE_DEGREE_SIZE);
+    QByteArray bytes;
+    const uchar *data;
+    quint32 flags;
+    int hgtMin, hgtMax;
+    int x, y, index;
+
+    fx = ((fx % width) + width) % width;
+    if (fy<0 || fy>=height || !indexedFile.read(getFileIndex(fx, fy), &bytes, &flags, io)) {
+        (*minHeight) = 0;                           // no entry - sea level
+        return true;
+    }
+
+    if (bytes.size()!=HEIGHT_RANGE_ENTRY_BYTES) {
+        qWarning("Height range table - entry of file %d %d is corrupted", fx, fy);
+        return false;
+    }
+    data = (const uchar *)bytes.constData();
+
+    if (chunks==HEIGHT_RANGE_CHUNKS) {
+        hgtMin = (data[0] << 8) + data[1];
+        hgtMax = (data[2] << 8) + data[3];
+        if (hgtMin<(*minHeight)) (*minHeight) = hgtMin;
+        if (hgtMax>(*maxHeight)) (*maxHeight) = hgtMax;
+        return true;
+    }
+
+    for (y=cy; y<cy + chunks && y<HEIGHT_RANGE_CHUNKS; y++)
+        for (x=cx; x<cx + chunks && x<HEIGHT_RANGE_CHUNKS; x++) {
+            index = 4 + 4*(y*HEIGHT_RANGE_CHUNKS + x);
+            hgtMin = (data[index] << 8) + data[index + 1];
+            hgtMax = (data[index + 2] << 8) + data[index + 3];
+            if (hgtMin<(*minHeight)) (*minHeight) = hgtMin;
+            if (hgtMax>(*maxHeight)) (*maxHeight) = hgtMax;
+        }
+
+    return true;
+}
@@ -0,0 +1,102 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CHEIGHTRANGETABLE_H
+#define CHEIGHTRANGETABLE_H
+
+#include <QString>
+#include <QVector>
+#include <QByteArray>
+#include "CIndexedFile.h"
+
+#define HEIGHT_RANGE_TABLE_FILE         "heightrange.hgtr"  // min & max height of L09-L13 files and their chunks
+#define HEIGHT_RANGE_TABLE_MAGIC        0x48475452      // "HGTR"
+#define HEIGHT_RANGE_TABLE_VERSION      1
+#define HEIGHT_RANGE_TABLE_HEADER_SIZE  32              // magic, version, file samples, chunk intervals, index offset, entries count
+#define HEIGHT_RANGE_TABLE_INDEX_RECORD INDEXED_FILE_RECORD_FIXED   // key (L09-L13 file index) & offset of one entry
+#define HEIGHT_RANGE_FILE_SAMPLES       4097            // samples along side of L09-L13 file - same as HGT_SOURCE_SIZE_L09_L13
+#define HEIGHT_RANGE_FILE_DEGREE_SIZE   3.75            // same as HGT_SOURCE_DEGREE_SIZE_L09_L13
+#define HEIGHT_RANGE_CHUNK_INTERVALS    64              // chunk has 65x65 samples like chunk of CTerrainContainer
+#define HEIGHT_RANGE_CHUNKS             64              // chunks along side of L09-L13 file
+#define HEIGHT_RANGE_ENTRY_BYTES        (4 + 4*HEIGHT_RANGE_CHUNKS*HEIGHT_RANGE_CHUNKS)   // min & max of file, then of each chunk
+
+// min & max height of one L09-L13 file and of each its chunk - edge samples
+// shared by neighbor chunks are counted in both chunks
+class CHeightRange
+{
+public:
+    CHeightRange();
+
+    int fileMin;
+    int fileMax;
+    QVector<quint16> chunkMin;
+    QVector<quint16> chunkMax;
+
+    void clear();
+    void addSample(int x, int y, int hgt);
+    QByteArray toBytes() const;
+};
+
+// min & max height of L09-L13 files built by HgtPyramidBuilder - height range of terrain
+// of any LOD is found without reading HGT data, files without entry are sea level
+//
+// layout: header, entries, index sorted by file index
+class CHeightRangeTable
+{
+public:
+    CHeightRangeTable();
+
+    unsigned int lastModified;
+
+    bool open(const QString &fileName);
+    bool isOpen() { return indexedFile.isOpen(); }
+    int getHeightRange(double tlLon, double tlLat, double degreeSize, CIoCounters *io);
+
+    static int getFileIndex(int fx, int fy);
+
+private:
+    CIndexedFile indexedFile;
+
+    bool addFileRange(int fx, int fy, int cx, int cy, int chunks, int *minHeight, int *maxHeight, CIoCounters *io);
+};
+
+#endif // CHEIGHTRANGETABLE_H
@@ -40,10 +40,16 @@
  *   -------------------------------------------------------------------------
  */
 
+#include <string.h>
 #include <fstream>
 #include <iostream>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 #include "CHgtFile.h"
 
+#define HGT_FILE_SAVE_CHUNK      65536        // samples converted & written at once by saveFile
+
 using namespace std;
 
 CHgtFile::CHgtFile()
@@ -70,17 +76,33 @@ void CHgtFile::init(int sX, int sY)
     height = new quint16[sizeX*sizeY];
 }
 
-void CHgtFile::exchangeEndian()
+void CHgtFile::convertBigEndian(const quint16 *source, quint16 *destination, int count)
 {
-    unsigned char byte1, byte0;
-    int i;
+    int i = 0;
 
-    for (i=0; i<sizeX*sizeY; i++) {
-        byte1 = (height[i] & 0xFF00) >> 8;
-        byte0 = height[i] & 0xFF;
+    // HGT samples are big endian - nothing to swap on big endian host
+    if (QSysInfo::ByteOrder==QSysInfo::BigEndian) {
+        if (source!=destination)
+            memcpy(destination, source, count*2);
+        return;
+    }
 
-        height[i] = (byte0 << 8) + byte1;
+#ifdef __SSE2__
+    // 8 samples at once - SSE2 is always enabled by x86-64 compilers, other builds use scalar loop
+    for (; i+8<=count; i+=8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(source + i));
+        _mm_storeu_si128((__m128i *)(destination + i), _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
     }
+#endif
+
+    // remaining samples
+    for (; i<count; i++)
+        destination[i] = (quint16)((source[i] << 8) | (source[i] >> 8));
+}
+
+void CHgtFile::exchangeEndian()
+{
+    convertBigEndian(height, height, sizeX*sizeY);
 }
 
 void CHgtFile::savePGM(QString name)
@@ -112,16 +134,27 @@ void CHgtFile::savePGM(QString name)
     filePGM.close();
 }
 
-void CHgtFile::saveFile(QString name)
+bool CHgtFile::saveFile(QString name)
 {
-    if (height==0) return;
+    if (height==0) return false;
     fstream fileHgt;
 
-    // save HGT file to disk
+    quint16 *chunk = new quint16[HGT_FILE_SAVE_CHUNK];
+    int i, count;
+
+    // save HGT file to disk - samples are converted in chunks so heights in memory stay usable
     fileHgt.open(name.toAscii(), fstream::out | fstream::binary);
-    exchangeEndian();
-    fileHgt.write((char *)height, sizeX*sizeY*2);
+    for (i=0; i<sizeX*sizeY; i+=HGT_FILE_SAVE_CHUNK) {
+        count = qMin(HGT_FILE_SAVE_CHUNK, sizeX*sizeY - i);
+        convertBigEndian(height + i, chunk, count);
+        fileHgt.write((char *)chunk, count*2);
+    }
     fileHgt.close();
+
+    delete []chunk;
+
+    // failbit stays set after any failed open or write (full disk)
+    return fileHgt.fail() ? false : true;
 }
 
 void CHgtFile::loadFile(QString name, int x, int y)
@@ -192,7 +225,19 @@ void CHgtFile::fileOpen(QString name, int sX, int sY)
 {
     sizeX = sX;
     sizeY = sY;
+    file.clear();           // failed open or read of previous file must not block this one
+    ioTimer.start();
     file.open(name.toAscii(), fstream::in | fstream::out | fstream::binary);
+    io.opens++;
+    io.timeNs += ioTimer.nsecsElapsed();
+}
+
+CIoCounters CHgtFile::takeIoCounters()
+{
+    CIoCounters counters = io;
+
+    io.clear();
+    return counters;
 }
 
 void CHgtFile::fileClose()
@@ -215,36 +260,107 @@ int CHgtFile::fileGetHeight(int x, int y)
 {
     char byte[2];
 
+    ioTimer.start();
     file.seekg((y*sizeX + x)*2);
     file.read(byte, 2);
+    io.seeks++;
+    io.reads++;
+    io.bytesRead += file.gcount();
+    io.timeNs += ioTimer.nsecsElapsed();
 
     return (int)( (((unsigned char)byte[0]) << 8) + ((unsigned char)byte[1]) );
 }
 
+// span is scratch of (sx-1)*skip+1 samples given by caller for whole block, unused when skip is 1
+void CHgtFile::fileReadRow(quint16 *buffer, quint16 *span, int x, int y, int sx, int skip)
+{
+    int spanSize;
+    int X;
+
+    // one read of whole row span instead of seek & read for each sample
+    spanSize = (sx-1)*skip + 1;
+    ioTimer.start();
+    file.seekg((y*sizeX + x)*2);
+    io.seeks++;
+    io.reads++;
+    if (skip==1) {
+        file.read((char *)buffer, sx*2);
+        io.bytesRead += file.gcount();
+        io.timeNs += ioTimer.nsecsElapsed();
+        convertBigEndian(buffer, buffer, sx);
+        return;
+    }
+
+    file.read((char *)span, spanSize*2);
+    io.bytesRead += file.gcount();
+    io.timeNs += ioTimer.nsecsElapsed();
+    convertBigEndian(span, span, spanSize);
+    for (X=0; X<sx; X++)
+        buffer[X] = span[X*skip];
+}
+
 void CHgtFile::fileGetHeightBlock(int *buffer, int x, int y, int sx, int sy, int skip)
 {
-    int i;
+    quint16 *row;
+    quint16 *span = 0;
     int X, Y;
 
-    i = 0;
-    for (Y=0; Y<sy; Y++)
-        for (X=0; X<sx; X++) {
-            buffer[i] = fileGetHeight(x + X*skip, y + Y*skip);
-            i++;
-        }
+    if (sx<=0 || sy<=0)
+        return;
+
+    // buffers are allocated once for whole block, not for each row
+    row = new quint16[sx];
+    if (skip>1)
+        span = new quint16[(sx-1)*skip + 1];
+    for (Y=0; Y<sy; Y++) {
+        fileReadRow(row, span, x, y + Y*skip, sx, skip);
+        for (X=0; X<sx; X++)
+            buffer[Y*sx + X] = (int)row[X];
+    }
+    delete []span;
+    delete []row;
 }
 
 void CHgtFile::fileGetHeightBlock(quint16 *buffer, int x, int y, int sx, int sy, int skip)
 {
-    int i;
-    int X, Y;
+    quint16 *span = 0;
+    int Y;
 
-    i = 0;
+    if (sx<=0 || sy<=0)
+        return;
+
+    if (skip>1)
+        span = new quint16[(sx-1)*skip + 1];
     for (Y=0; Y<sy; Y++)
+        fileReadRow(buffer + Y*sx, span, x, y + Y*skip, sx, skip);
+    delete []span;
+}
+
+void CHgtFile::fileGetHeightMinMax(int x, int y, int sx, int sy, int *minHeight, int *maxHeight)
+{
+    quint16 *row = new quint16[sx];
+    int hgt;
+    int X, Y;
+
+    (*minHeight) = 65535;
+    (*maxHeight) = 0;
+
+    // whole row is read at once - block is usually much bigger than 9x9
+    for (Y=0; Y<sy; Y++) {
+        fileReadRow(row, 0, x, y + Y, sx, 1);
         for (X=0; X<sx; X++) {
-            buffer[i] = (quint16)fileGetHeight(x + X*skip, y + Y*skip);
-            i++;
+            hgt = row[X];
+
+            // SRTM data error marked as very hight altidute
+            if (hgt>9000)
+                hgt = 10;
+
+            if (hgt<(*minHeight)) (*minHeight) = hgt;
+            if (hgt>(*maxHeight)) (*maxHeight) = hgt;
         }
+    }
+
+    delete []row;
 }
 
 void CHgtFile::fileSetHeightBlock(int *buffer, int x, int y, int sx, int sy, int skip)
@@ -44,7 +44,9 @@
 #define CHGTFILE_H
 
 #include <QString>
+#include <QElapsedTimer>
 #include <fstream>
+#include "CIoCounters.h"
 
 using namespace std;
 
@@ -55,7 +57,7 @@ public:
     ~CHgtFile();
 
     void init(int sX, int sY);
-    void saveFile(QString name);
+    bool saveFile(QString name);
     void loadFile(QString name, int x, int y);
     int getHeight(int x, int y) { return (int)height[y*sizeX + x]; }
     void setHeight(int x, int y, int hgt) { height[y*sizeX + x] = (quint16)hgt; }
@@ -69,17 +71,24 @@ public:
     int fileGetHeight(int x, int y);
     void fileGetHeightBlock(int *buffer, int x, int y, int sx, int sy, int skip);
     void fileGetHeightBlock(quint16 *buffer, int x, int y, int sx, int sy, int skip);
+    void fileGetHeightMinMax(int x, int y, int sx, int sy, int *minHeight, int *maxHeight);
     void fileSetHeightBlock(int *buffer, int x, int y, int sx, int sy, int skip);
     void fileSetHeightBlock(quint16 *buffer, int x, int y, int sx, int sy, int skip);
     void savePGM(QString name);
+    CIoCounters takeIoCounters();
+
+    static void convertBigEndian(const quint16 *source, quint16 *destination, int count);
 
 private:
     fstream file;
     quint16 *height;
     int sizeX;
     int sizeY;
+    CIoCounters io;                         // I/O of file* functions since last takeIoCounters
+    QElapsedTimer ioTimer;
 
     void exchangeEndian();
+    void fileReadRow(quint16 *buffer, quint16 *span, int x, int y, int sx, int skip);
 };
 
 #endif // CHGTFILE_H
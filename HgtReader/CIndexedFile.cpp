@@ -0,0 +1,171 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QFileInfo>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QtAlgorithms>
+#include "CIndexedFile.h"
+
+CIndexedFile::CIndexedFile()
+{
+    lastModified = 0;
+    fileSize = 0;
+    fileMap = 0;
+    opened = false;
+    stream.setDevice(&file);
+}
+
+CIndexedFile::~CIndexedFile()
+{
+    close();
+}
+
+bool CIndexedFile::open(const QString &fileName)
+{
+    close();
+
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    fileSize = file.size();
+    stream.resetStatus();
+
+    return true;
+}
+
+void CIndexedFile::close()
+{
+    if (fileMap!=0)
+        file.unmap(fileMap);
+    fileMap = 0;
+    file.close();
+    keys.clear();
+    entries.clear();
+    opened = false;
+}
+
+bool CIndexedFile::readIndex(quint64 headerSize, quint64 indexOffset, quint64 entryCount, int recordSize,
+                             quint32 entrySize, quint32 maxFlags)
+{
+    quint64 i;
+
+    // index must fit between entries and end of file - checked before anything is allocated
+    if (stream.status()!=QDataStream::Ok ||
+        indexOffset<headerSize || indexOffset>fileSize ||
+        entryCount!=(fileSize - indexOffset)/recordSize)
+        return false;
+
+    // whole index is read at once
+    file.seek(indexOffset);
+    keys.resize(entryCount);
+    entries.resize(entryCount);
+    for (i=0; i<entryCount; i++) {
+        stream >> keys[i] >> entries[i].offset;
+        if (recordSize==INDEXED_FILE_RECORD_SIZED) {
+            stream >> entries[i].size >> entries[i].flags;
+        } else {
+            entries[i].size = entrySize;
+            entries[i].flags = 0;
+        }
+    }
+
+    if (stream.status()!=QDataStream::Ok || !checkIndex(headerSize, indexOffset, maxFlags)) {
+        keys.clear();
+        entries.clear();
+        return false;
+    }
+
+    fileMap = file.map(0, fileSize);
+    lastModified = QFileInfo(file).lastModified().toTime_t();
+    opened = true;
+
+    return true;
+}
+
+bool CIndexedFile::checkIndex(quint64 headerSize, quint64 indexOffset, quint32 maxFlags)
+{
+    int i;
+
+    // keys are searched by qBinaryFind - they must be sorted, entries must lie before index
+    for (i=0; i<entries.size(); i++) {
+        if (i>0 && keys.at(i)<=keys.at(i - 1))
+            return false;
+        if (entries.at(i).offset<headerSize || entries.at(i).offset>indexOffset ||
+            entries.at(i).size>indexOffset - entries.at(i).offset)
+            return false;
+        if (entries.at(i).flags>maxFlags)
+            return false;
+    }
+
+    return true;
+}
+
+bool CIndexedFile::read(quint64 key, QByteArray *bytes, quint32 *flags, CIoCounters *io)
+{
+    QVector<quint64>::const_iterator it;
+    CIndexedFileEntry entry;
+    QElapsedTimer ioTimer;
+
+    it = qBinaryFind(keys.constBegin(), keys.constEnd(), key);
+    if (it==keys.constEnd())
+        return false;
+    entry = entries.at(it - keys.constBegin());
+
+    // page faults of mapped file are paid when entry is used - only bytes are counted then
+    ioTimer.start();
+    if (fileMap!=0) {
+        (*bytes) = QByteArray::fromRawData((const char *)(fileMap + entry.offset), entry.size);
+    } else {
+        QMutexLocker locker(&mutex);
+        file.seek(entry.offset);
+        (*bytes) = file.read(entry.size);
+        io->seeks++;
+    }
+    io->reads++;
+    io->bytesRead += bytes->size();
+    io->timeNs += ioTimer.nsecsElapsed();
+    (*flags) = entry.flags;
+
+    return true;
+}
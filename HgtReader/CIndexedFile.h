@@ -0,0 +1,98 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CINDEXEDFILE_H
+#define CINDEXEDFILE_H
+
+#include <QString>
+#include <QFile>
+#include <QDataStream>
+#include <QMutex>
+#include <QVector>
+#include "CIoCounters.h"
+
+#define INDEXED_FILE_RECORD_FIXED       16              // key & offset - all entries have the same size
+#define INDEXED_FILE_RECORD_SIZED       24              // key, offset, size & flags
+
+class CIndexedFileEntry
+{
+public:
+    quint64 offset;
+    quint32 size;
+    quint32 flags;
+};
+
+// read only file with header, entries and index sorted by key - base of CTerrainContainer
+// and CTextureTiles, owner reads its header through getStream() and then the index,
+// entries are read from memory when file fits in address space
+class CIndexedFile
+{
+public:
+    CIndexedFile();
+    ~CIndexedFile();
+
+    unsigned int lastModified;
+
+    bool open(const QString &fileName);
+    bool readIndex(quint64 headerSize, quint64 indexOffset, quint64 entryCount, int recordSize,
+                   quint32 entrySize, quint32 maxFlags);
+    void close();
+    bool isOpen() { return opened; }
+    QDataStream *getStream() { return &stream; }
+    quint64 getFileSize() { return fileSize; }
+    quint64 getLastKey() { return keys.isEmpty() ? 0 : keys.last(); }
+    bool read(quint64 key, QByteArray *bytes, quint32 *flags, CIoCounters *io);
+
+private:
+    QMutex mutex;                           // guards file reads when file could not be mapped
+    QFile file;
+    QDataStream stream;
+    quint64 fileSize;
+    uchar *fileMap;
+    bool opened;
+    QVector<quint64> keys;                  // sorted - same order as entries in file
+    QVector<CIndexedFileEntry> entries;
+
+    bool checkIndex(quint64 headerSize, quint64 indexOffset, quint32 maxFlags);
+};
+
+#endif // CINDEXEDFILE_H
@@ -0,0 +1,81 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CIOCOUNTERS_H
+#define CIOCOUNTERS_H
+
+#include <QtGlobal>
+
+// file I/O done by one file object - file classes are used also by tools without CIoStats so it is header only
+class CIoCounters
+{
+public:
+    CIoCounters() { clear(); }
+
+    qint64 opens;
+    qint64 seeks;
+    qint64 reads;                           // read calls - buffered stream may join them into fewer syscalls
+    qint64 bytesRead;
+    qint64 timeNs;                          // spent in open, seek and read
+    qint64 tiles;                           // terrains fetched with this I/O - set by CCacheManager
+
+    void clear()
+    {
+        opens = 0;
+        seeks = 0;
+        reads = 0;
+        bytesRead = 0;
+        timeNs = 0;
+        tiles = 0;
+    }
+    void add(const CIoCounters &counters)
+    {
+        opens += counters.opens;
+        seeks += counters.seeks;
+        reads += counters.reads;
+        bytesRead += counters.bytesRead;
+        timeNs += counters.timeNs;
+        tiles += counters.tiles;
+    }
+};
+
+#endif // CIOCOUNTERS_H
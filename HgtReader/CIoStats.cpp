@@ -0,0 +1,113 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QMutexLocker>
+#include "CIoStats.h"
+
+CIoStats::CIoStats()
+{
+    infoTimer.start();
+}
+
+void CIoStats::add(int source, const CIoCounters &ioCounters)
+{
+    QMutexLocker locker(&mutex);
+
+    if (source<0 || source>=IO_SOURCES)
+        return;
+    counters[source].add(ioCounters);
+}
+
+CIoCounters CIoStats::getCounters(int source)
+{
+    QMutexLocker locker(&mutex);
+
+    if (source<0 || source>=IO_SOURCES)
+        return CIoCounters();
+    return counters[source];
+}
+
+void CIoStats::clear()
+{
+    QMutexLocker locker(&mutex);
+    int i;
+
+    for (i=0; i<IO_SOURCES; i++)
+        counters[i].clear();
+}
+
+void CIoStats::updateIoInfo()
+{
+    CIoCounters ioCounters;
+    int i;
+
+    // called after every tree update - UI doesn't need it so often
+    if (infoTimer.elapsed() < IO_STATS_INTERVAL_MS)
+        return;
+    infoTimer.start();
+
+    for (i=0; i<IO_SOURCES; i++) {
+        ioCounters = getCounters(i);
+        emit SIGNALupdateIoInfo(i, (int)ioCounters.opens, (int)ioCounters.seeks, (int)ioCounters.reads,
+                                ioCounters.bytesRead/1048576.0, ioCounters.timeNs/1000000.0,
+                                ioCounters.tiles>0 ? ioCounters.bytesRead/1024.0/ioCounters.tiles : 0.0);
+    }
+}
+
+QString CIoStats::getSourceName(int source)
+{
+    switch (source) {
+        case IO_SOURCE_L00_L03:     return QString("L00_L03");
+        case IO_SOURCE_L04_L08:     return QString("L04_L08");
+        case IO_SOURCE_L09_L13:     return QString("L09_L13");
+        case IO_SOURCE_SRTM:        return QString("SRTM");
+        case IO_SOURCE_TEX_L00_L02: return QString("TEX_L00_L02");
+        case IO_SOURCE_TEX_L03_L05: return QString("TEX_L03_L05");
+        case IO_SOURCE_TEX_L06_L08: return QString("TEX_L06_L08");
+        case IO_SOURCE_TEX_L09_L10: return QString("TEX_L09_L10");
+        case IO_SOURCE_CONTAINER:   return QString("CONTAINER");
+        case IO_SOURCE_TEXTURE_TILES: return QString("TEXTURE_TILES");
+        case IO_SOURCE_HEIGHT_RANGE:  return QString("HEIGHT_RANGE");
+    }
+
+    return QString("unknown");
+}
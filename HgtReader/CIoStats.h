@@ -0,0 +1,91 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CIOSTATS_H
+#define CIOSTATS_H
+
+#include <QObject>
+#include <QMutex>
+#include <QString>
+#include <QElapsedTimer>
+#include "CIoCounters.h"
+
+#define IO_SOURCE_L00_L03            0
+#define IO_SOURCE_L04_L08            1
+#define IO_SOURCE_L09_L13            2
+#define IO_SOURCE_SRTM               3
+#define IO_SOURCE_TEX_L00_L02        4
+#define IO_SOURCE_TEX_L03_L05        5
+#define IO_SOURCE_TEX_L06_L08        6
+#define IO_SOURCE_TEX_L09_L10        7
+#define IO_SOURCE_CONTAINER          8      // terrain.hgtc - all HGT levels
+#define IO_SOURCE_TEXTURE_TILES      9      // textures.hgtx - pre-built textures
+#define IO_SOURCE_HEIGHT_RANGE      10      // heightrange.hgtr - pre-built height ranges of L09-L13
+#define IO_SOURCES                  11
+
+#define IO_STATS_INTERVAL_MS       500      // how often counters are sent to UI
+
+// I/O since program start for each source directory or file - filled by CCacheManager from its file objects
+class CIoStats : public QObject
+{
+    Q_OBJECT
+
+Q_SIGNALS:
+    void SIGNALupdateIoInfo(int source, int opens, int seeks, int reads, double megabytesRead,
+                            double ioTimeMs, double kilobytesPerTile);
+
+public:
+    CIoStats();
+
+    void add(int source, const CIoCounters &counters);
+    CIoCounters getCounters(int source);
+    void clear();
+    void updateIoInfo();
+    static QString getSourceName(int source);
+
+private:
+    QMutex mutex;
+    CIoCounters counters[IO_SOURCES];
+    QElapsedTimer infoTimer;                // time since counters were sent to UI
+};
+
+#endif // CIOSTATS_H
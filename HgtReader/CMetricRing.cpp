@@ -0,0 +1,134 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <math.h>
+#include <QtAlgorithms>
+#include "CMetricRing.h"
+
+CMetricStats::CMetricStats()
+{
+    count = 0;
+    meanMs = 0.0;
+    p50Ms = 0.0;
+    p95Ms = 0.0;
+    p99Ms = 0.0;
+    maxMs = 0.0;
+}
+
+CMetricRing::CMetricRing() : samples(METRIC_RING_SIZE)
+{
+}
+
+void CMetricRing::push(qint64 timeNs, qint64 valueNs)
+{
+    CMetricSample s;
+
+    s.timeNs = timeNs;
+    s.valueNs = valueNs;
+    samples.push(s);
+}
+
+void CMetricRing::getSamples(qint64 sinceNs, QVector<CMetricSample> *result) const
+{
+    CMetricSample s;
+    qint64 h, i;
+    int j;
+
+    result->clear();
+
+    // samples are ordered by time - walked from the newest one, sample overwritten
+    // during reading means that all older ones are overwritten too
+    h = samples.getHead();
+    for (i=h-1; i>=qMax((qint64)0, h - METRIC_RING_SIZE); i--) {
+        if (!samples.read(i, &s) || s.timeNs<sinceNs)
+            break;
+        result->append(s);
+    }
+
+    // the oldest first
+    for (j=0; j<result->size()/2; j++) {
+        s = result->at(j);
+        (*result)[j] = result->at(result->size()-1-j);
+        (*result)[result->size()-1-j] = s;
+    }
+}
+
+CMetricStats CMetricRing::getStats(qint64 sinceNs) const
+{
+    QVector<CMetricSample> period;
+    QVector<qint64> values;
+    CMetricStats stats;
+    qint64 total = 0;
+    int i;
+
+    getSamples(sinceNs, &period);
+    if (period.isEmpty())
+        return stats;
+
+    values.resize(period.size());
+    for (i=0; i<period.size(); i++) {
+        values[i] = period.at(i).valueNs;
+        total += values[i];
+    }
+    qSort(values.begin(), values.end());
+
+    stats.count = values.size();
+    stats.meanMs = total/1000000.0/values.size();
+    stats.p50Ms = getPercentile(values, 50.0);
+    stats.p95Ms = getPercentile(values, 95.0);
+    stats.p99Ms = getPercentile(values, 99.0);
+    stats.maxMs = values.last()/1000000.0;
+
+    return stats;
+}
+
+double CMetricRing::getPercentile(const QVector<qint64> &sortedValues, double percent)
+{
+    int index;
+
+    // nearest rank - one slow frame of hundred is p99
+    index = (int)ceil(percent/100.0 * sortedValues.size()) - 1;
+    if (index<0) index = 0;
+    if (index>=sortedValues.size()) index = sortedValues.size()-1;
+
+    return sortedValues.at(index)/1000000.0;
+}
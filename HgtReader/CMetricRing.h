@@ -0,0 +1,88 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CMETRICRING_H
+#define CMETRICRING_H
+
+#include <QVector>
+#include "CSeqRing.h"
+
+#define METRIC_RING_SIZE        65536       // samples kept for each metric (power of two) - about 18 minutes of 60 fps
+
+class CMetricSample
+{
+public:
+    qint64 timeNs;                          // when sample was taken (CPerformance clock)
+    qint64 valueNs;                         // measured duration
+};
+
+class CMetricStats
+{
+public:
+    CMetricStats();
+
+    int count;
+    double meanMs;
+    double p50Ms;
+    double p95Ms;
+    double p99Ms;
+    double maxMs;
+};
+
+// samples of one metric - pushed by single thread without lock, read by any thread, the oldest are overwritten
+class CMetricRing
+{
+public:
+    CMetricRing();
+
+    void push(qint64 timeNs, qint64 valueNs);
+    void getSamples(qint64 sinceNs, QVector<CMetricSample> *result) const;
+    CMetricStats getStats(qint64 sinceNs) const;
+    static int getMemoryBytes() { return sizeof(CMetricRing) + METRIC_RING_SIZE*CSeqRing<CMetricSample>::getSlotBytes(); }
+
+private:
+    CSeqRing<CMetricSample> samples;
+
+    static double getPercentile(const QVector<qint64> &sortedValues, double percent);
+};
+
+#endif // CMETRICRING_H
@@ -44,6 +44,7 @@
 #include "COpenGlThread.h"
 #include "CRawFile.h"
 #include "CCommons.h"
+#include "CTraceZone.h"
 
 
 COpenGlThread::COpenGlThread(COpenGl *openGlPointer) : QThread(openGlPointer), openGl(openGlPointer)
@@ -94,6 +95,7 @@ void COpenGlThread::run()
     unsigned int texID;
     CEarth *tmp;
 
+    CTraceZone::setThreadName("OpenGL");
     openGl->makeCurrent();
     openGl->drawingState.getDrawingStateSnapshot(&dss);      // get current scene state
     initializeScene();
@@ -118,6 +120,7 @@ void COpenGlThread::run()
         // ### OpenGL scene END
 
         openGl->swapBuffers();
+        openGl->performance.checkConvergence();              // earth is exchanged after drawing so ready tree was already drawn
         openGl->drawingState.getDrawingStateSnapshot(&dss);  // get current scene state
 
         // check if new earth was loaded from disk in parraler thread
@@ -144,7 +147,7 @@ void COpenGlThread::run()
 
         // update performance info
         msleep(1);
-        openGl->performance.setFrameRenderingTime(time.elapsed());
+        openGl->performance.setFrameRenderingTime(time.nsecsElapsed());
         openGl->performance.updateFrameRenderingInfo();
     }
 }
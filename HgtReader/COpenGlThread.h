@@ -44,7 +44,7 @@
 #define COPENGLTHREAD_H
 
 #include <QThread>
-#include <QTime>
+#include <QElapsedTimer>
 #include "COpenGl.h"
 #include "CObjects.h"
 #include "CEarth.h"
@@ -69,7 +69,7 @@ protected:
 private:
     COpenGl *openGl;
     CObjects objects;
-    QTime time;
+    QElapsedTimer time;
     CDrawingStateSnapshot dss;
     QMutex doMutex;
     bool doResize;
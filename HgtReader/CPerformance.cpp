@@ -46,6 +46,31 @@
 #include "CPerformance.h"
 #include "CCacheManager.h"
 
+CPerformanceCounters::CPerformanceCounters()
+{
+    terrainsInTree = 0;
+    terrainsUpdated = 0;
+    maxLOD = -1;
+    splitsPostponed = 0;
+}
+
+void CPerformanceCounters::add(const CPerformanceCounters &counters)
+{
+    terrainsInTree += counters.terrainsInTree;
+    terrainsUpdated += counters.terrainsUpdated;
+    splitsPostponed += counters.splitsPostponed;
+    if (counters.maxLOD > maxLOD)
+        maxLOD = counters.maxLOD;
+}
+
+CTerrainDataCounters::CTerrainDataCounters()
+{
+    cacheFinds = 0;
+    cacheHits = 0;
+    built = 0;
+    loadedFromDisk = 0;
+}
+
 CPerformance *CPerformance::instance;
 
 CPerformance::CPerformance()
@@ -58,16 +83,14 @@ CPerformance::CPerformance()
     maxLOD = 0;
     fps = 0.0;
     tups = 0.0;
-    fpsGlobalTime = 0.0;
-    tupsGlobalTime = 0.0;
-
-    // create history arrays
-    fpsHistory = new double[3600];            // at least one hour buffer
-    tupsHistory = new double[3600];           // at least one hour buffer
-    fpsGlobalTimeHistory = new double[3600];
-    tupsGlobalTimeHistory = new double[3600];
-    fpsSavedMeasurements = 0;
-    tupsSavedMeasurements = 0;
+    clock.start();
+    historyStartNs = 0;
+    frameStatsSentNs = 0;
+    treeUpdateStatsSentNs = 0;
+    convergenceStartNs = -1;
+    convergenceTreeReady = false;
+
+    // frame and tree update times are kept in rings - events in arrays
     eventsName = new QString[300];
     eventsTime = new double[300];
     eventsCount = 0;
@@ -79,10 +102,6 @@ CPerformance::~CPerformance()
 {
     saveLog();
 
-    delete []fpsGlobalTimeHistory;
-    delete []tupsGlobalTimeHistory;
-    delete []fpsHistory;
-    delete []tupsHistory;
     delete []eventsName;
     delete []eventsTime;
 
@@ -93,10 +112,15 @@ void CPerformance::resetHistory()
 {
     QMutexLocker locker(&mutex);
     eventsCount = 0;
-    fpsSavedMeasurements = 0;
-    tupsSavedMeasurements = 0;
-    fpsGlobalTime = 0.0;
-    tupsGlobalTime = 0.0;
+    historyStartNs = clock.nsecsElapsed();
+    convergenceStartNs = -1;
+    convergenceTreeReady = false;
+}
+
+qint64 CPerformance::getHistoryStartNs()
+{
+    QMutexLocker locker(&mutex);
+    return historyStartNs;
 }
 
 void CPerformance::disableSavingToHistory()
@@ -111,16 +135,59 @@ void CPerformance::enableSavingToHistory()
     saveToHistory = true;
 }
 
+void CPerformance::countTerrainDataFind(bool found)
+{
+    QMutexLocker locker(&mutex);
+    terrainDataCounters.cacheFinds++;
+    if (found) terrainDataCounters.cacheHits++;
+}
+
+void CPerformance::countTerrainDataInit(bool fromDiskCache)
+{
+    QMutexLocker locker(&mutex);
+    if (fromDiskCache)
+        terrainDataCounters.loadedFromDisk++;
+    else
+        terrainDataCounters.built++;
+}
+
+CTerrainDataCounters CPerformance::getTerrainDataCounters()
+{
+    QMutexLocker locker(&mutex);
+    return terrainDataCounters;
+}
+
+qint64 CPerformance::getHistoryMemoryBytes()
+{
+    QMutexLocker locker(&mutex);
+    qint64 bytes;
+    int i;
+
+    // frame, tree update and full detail rings are allocated whole at start, event names grow with history
+    bytes = 3*CMetricRing::getMemoryBytes();
+    bytes += 300*(sizeof(QString) + sizeof(double));
+    for (i=0; i<eventsCount; i++)
+        bytes += eventsName[i].size()*sizeof(QChar);
+
+    return bytes;
+}
+
 void CPerformance::saveLog()
 {
     QLocale locale;
     CCacheManager *cacheManager = CCacheManager::getInstance();
     QFile file(cacheManager->pathBase + "log.txt");
+    QVector<CMetricSample> frames, treeUpdates, convergences;
+    qint64 startNs = getHistoryStartNs();
     int i;
 
     if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
         return;
 
+    frameTimes.getSamples(startNs, &frames);
+    treeUpdateTimes.getSamples(startNs, &treeUpdates);
+    convergenceTimes.getSamples(startNs, &convergences);
+
     QTextStream out(&file);
     out << "Events:" << endl;
     for (i=0; i<eventsCount; i++) {
@@ -128,19 +195,49 @@ void CPerformance::saveLog()
     }
     out << endl;
     out << "--------------------------------------------------------" << endl << endl;
+    writeStats(out, "Frame time", frameTimes.getStats(startNs));
+    writeStats(out, "Tree update time", treeUpdateTimes.getStats(startNs));
+    writeStats(out, "Time to full detail", convergenceTimes.getStats(startNs));
+    out << endl;
+    out << "--------------------------------------------------------" << endl << endl;
     out << "FPS history:" << endl;
-    for (i=0; i<fpsSavedMeasurements; i++) {
-        out << locale.toString(fpsGlobalTimeHistory[i], 'f', 3) << ";" << locale.toString(fpsHistory[i], 'f', 1) << endl;
-    }
+    writeHistory(out, frames, startNs);
     out << endl;
     out << "--------------------------------------------------------" << endl << endl;
     out << "TUPS history:" << endl;
-    for (i=0; i<tupsSavedMeasurements; i++) {
-        out << locale.toString(tupsGlobalTimeHistory[i], 'f', 3) << ";" << locale.toString(tupsHistory[i], 'f', 1) << endl;
-    }
+    writeHistory(out, treeUpdates, startNs);
+    out << endl;
+    out << "--------------------------------------------------------" << endl << endl;
+    out << "Time to full detail history:" << endl;
+    writeHistory(out, convergences, startNs);
     file.close();
 }
 
+void CPerformance::writeStats(QTextStream &out, const QString &name, const CMetricStats &stats)
+{
+    QLocale locale;
+
+    out << name << " [ms]: count " << stats.count
+        << ", mean " << locale.toString(stats.meanMs, 'f', 2)
+        << ", p50 " << locale.toString(stats.p50Ms, 'f', 2)
+        << ", p95 " << locale.toString(stats.p95Ms, 'f', 2)
+        << ", p99 " << locale.toString(stats.p99Ms, 'f', 2)
+        << ", max " << locale.toString(stats.maxMs, 'f', 2) << endl;
+}
+
+void CPerformance::writeHistory(QTextStream &out, const QVector<CMetricSample> &samples, qint64 startNs)
+{
+    QLocale locale;
+    int i;
+
+    // time since history reset [s];updates per second;duration [ms]
+    for (i=0; i<samples.size(); i++) {
+        out << locale.toString((samples.at(i).timeNs - startNs)/1000000000.0, 'f', 3) << ";"
+            << locale.toString(1000000000.0/qMax((qint64)1, samples.at(i).valueNs), 'f', 1) << ";"
+            << locale.toString(samples.at(i).valueNs/1000000.0, 'f', 3) << endl;
+    }
+}
+
 CPerformance *CPerformance::getInstance()
 {
     return instance;
@@ -148,47 +245,133 @@ CPerformance *CPerformance::getInstance()
 
 void CPerformance::updateFrameRenderingInfo()
 {
+    CMetricStats stats;
+    qint64 nowNs = clock.nsecsElapsed();
+
     emit SIGNALupdateFrameRenderingInfo(terrainsQuarterDrawed, fps);
+
+    // percentiles are sorted from few hundreds of samples - not in every frame
+    if (nowNs - frameStatsSentNs >= (qint64)PERFORMANCE_STATS_INTERVAL_MS*1000000) {
+        frameStatsSentNs = nowNs;
+        stats = getFrameTimeStats();
+        emit SIGNALupdateFrameTimeInfo(stats.p50Ms, stats.p95Ms, stats.p99Ms, stats.maxMs);
+    }
 }
 
 void CPerformance::updateTerrainTreeUpdatingInfo()
 {
+    CMetricStats stats;
+    qint64 nowNs = clock.nsecsElapsed();
+
     emit SIGNALupdateTerrainTreeUpdatingInfo(terrainsInTree, maxLOD, tups);
+
+    if (nowNs - treeUpdateStatsSentNs >= (qint64)PERFORMANCE_STATS_INTERVAL_MS*1000000) {
+        treeUpdateStatsSentNs = nowNs;
+        stats = getTreeUpdateTimeStats();
+        emit SIGNALupdateTreeUpdateTimeInfo(stats.p50Ms, stats.p95Ms, stats.p99Ms, stats.maxMs);
+    }
 }
 
-void CPerformance::addEventToHistory(QString evName)
+CMetricStats CPerformance::getFrameTimeStats()
+{
+    return frameTimes.getStats(clock.nsecsElapsed() - (qint64)PERFORMANCE_STATS_PERIOD_MS*1000000);
+}
+
+CMetricStats CPerformance::getTreeUpdateTimeStats()
+{
+    return treeUpdateTimes.getStats(clock.nsecsElapsed() - (qint64)PERFORMANCE_STATS_PERIOD_MS*1000000);
+}
+
+qint64 CPerformance::getTimeNs()
+{
+    return clock.nsecsElapsed();
+}
+
+// time to full detail is measured from camera settling (also end of animation) until
+// first frame drawn from tree which has no postponed splits - textures are bound while
+// drawing so at the end of that frame every visible terrain has its texture in VRAM
+void CPerformance::startConvergence(qint64 settledNs)
 {
     QMutexLocker locker(&mutex);
+    convergenceStartNs = settledNs;
+    convergenceTreeReady = false;
+}
 
-    if (saveToHistory && eventsCount<300) {
-        eventsName[eventsCount] = evName;
-        eventsTime[eventsCount] = fpsGlobalTime;
-        eventsCount++;
-    }
+void CPerformance::cancelConvergence()
+{
+    QMutexLocker locker(&mutex);
+    convergenceStartNs = -1;
+    convergenceTreeReady = false;
 }
 
-void CPerformance::setFrameRenderingTime(int fms)
+void CPerformance::setConvergenceTreeReady(qint64 snapshotNs)
 {
     QMutexLocker locker(&mutex);
 
-    fps = 1000.0 / (double)(fms);
-    if (saveToHistory && fpsSavedMeasurements<3600) {
-        fpsHistory[fpsSavedMeasurements] = fps;
-        fpsGlobalTimeHistory[fpsSavedMeasurements] = fpsGlobalTime;
-        fpsGlobalTime = fpsGlobalTime + 1.0/fps;
-        fpsSavedMeasurements++;
+    // tree built from camera state older than settling doesn't count
+    if (convergenceStartNs>=0 && snapshotNs>=convergenceStartNs)
+        convergenceTreeReady = true;
+}
+
+void CPerformance::checkConvergence()
+{
+    qint64 latencyNs;
+
+    // called after every frame - mutex is taken only when tree is ready
+    if (!convergenceTreeReady)
+        return;
+
+    QMutexLocker locker(&mutex);
+    if (convergenceStartNs<0) {
+        convergenceTreeReady = false;
+        return;
     }
+    latencyNs = clock.nsecsElapsed() - convergenceStartNs;
+    if (saveToHistory) {
+        convergenceTimes.push(clock.nsecsElapsed(), latencyNs);
+        if (eventsCount<300) {
+            eventsName[eventsCount] = QString("[FULL DETAIL] ms: ") + QString::number(latencyNs/1000000.0, 'f', 1);
+            eventsTime[eventsCount] = (clock.nsecsElapsed() - historyStartNs)/1000000000.0;
+            eventsCount++;
+        }
+    }
+    convergenceStartNs = -1;
+    convergenceTreeReady = false;
+}
+
+CMetricStats CPerformance::getConvergenceStats()
+{
+    return convergenceTimes.getStats(getHistoryStartNs());
 }
 
-void CPerformance::setTerrainTreeUpdatingTime(int tums)
+void CPerformance::addEventToHistory(QString evName)
 {
     QMutexLocker locker(&mutex);
 
-    tups = 1000.0 / (double)(tums);
-    if (saveToHistory && tupsSavedMeasurements<3600) {
-        tupsHistory[tupsSavedMeasurements] = tups;
-        tupsGlobalTimeHistory[tupsSavedMeasurements] = tupsGlobalTime;
-        tupsGlobalTime = tupsGlobalTime + 1.0/tups;
-        tupsSavedMeasurements++;
+    if (saveToHistory && eventsCount<300) {
+        eventsName[eventsCount] = evName;
+        eventsTime[eventsCount] = (clock.nsecsElapsed() - historyStartNs)/1000000000.0;
+        eventsCount++;
     }
 }
+
+void CPerformance::setFrameRenderingTime(qint64 frameNs)
+{
+    // called in every frame - only OpenGL thread writes fps and frame ring so no lock is needed
+    fps = 1000000000.0 / (double)qMax((qint64)1, frameNs);
+    if (saveToHistory)
+        frameTimes.push(clock.nsecsElapsed(), frameNs);
+}
+
+void CPerformance::setTerrainTreeUpdatingTime(qint64 updateNs)
+{
+    // only terrain loader thread writes tups and tree update ring
+    tups = 1000000000.0 / (double)qMax((qint64)1, updateNs);
+    if (saveToHistory)
+        treeUpdateTimes.push(clock.nsecsElapsed(), updateNs);
+}
+
+void CPerformance::setTerrainTreeUpdatingIdle()
+{
+    tups = 0.0;
+}
@@ -45,6 +45,38 @@
 
 #include <QObject>
 #include <QMutex>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include "CMetricRing.h"
+
+#define PERFORMANCE_STATS_PERIOD_MS     5000      // rolling period of frame and tree update percentiles
+#define PERFORMANCE_STATS_INTERVAL_MS    500      // how often percentiles are sent to UI
+
+// counters of one tree updating task - tasks run in parallel so each one has its own copy
+class CPerformanceCounters
+{
+public:
+    CPerformanceCounters();
+
+    int terrainsInTree;
+    int terrainsUpdated;
+    int maxLOD;
+    int splitsPostponed;                    // splits left for next update because time budget ran out
+
+    void add(const CPerformanceCounters &counters);
+};
+
+// where terrain data came from since program start - terrains are created by many tasks so it is guarded by mutex
+class CTerrainDataCounters
+{
+public:
+    CTerrainDataCounters();
+
+    int cacheFinds;                         // terrains searched in memory cache
+    int cacheHits;                          // terrains found in memory cache
+    int built;                              // terrains built from HGT and RAW files
+    int loadedFromDisk;                     // terrains read from tile disk cache
+};
 
 class CPerformance : public QObject
 {
@@ -53,6 +85,8 @@ class CPerformance : public QObject
 Q_SIGNALS:
     void SIGNALupdateFrameRenderingInfo(int terrainsQuarterDrawed, double fps);
     void SIGNALupdateTerrainTreeUpdatingInfo(int terrainsInTree, int maxLOD, double tups);
+    void SIGNALupdateFrameTimeInfo(double p50Ms, double p95Ms, double p99Ms, double maxMs);
+    void SIGNALupdateTreeUpdateTimeInfo(double p50Ms, double p95Ms, double p99Ms, double maxMs);
 
 public:
     CPerformance();
@@ -65,33 +99,51 @@ public:
     static CPerformance *getInstance();
     void updateFrameRenderingInfo();
     void updateTerrainTreeUpdatingInfo();
-    void setFrameRenderingTime(int fms);
-    void setTerrainTreeUpdatingTime(int tums);
+    void setFrameRenderingTime(qint64 frameNs);
+    void setTerrainTreeUpdatingTime(qint64 updateNs);
+    CMetricStats getFrameTimeStats();
+    CMetricStats getTreeUpdateTimeStats();
+    qint64 getTimeNs();
+    void startConvergence(qint64 settledNs);
+    void cancelConvergence();
+    void setConvergenceTreeReady(qint64 snapshotNs);
+    void checkConvergence();
+    CMetricStats getConvergenceStats();
+    void setTerrainTreeUpdatingIdle();
     void addEventToHistory(QString evName);
     void resetHistory();
     void disableSavingToHistory();
     void enableSavingToHistory();
+    void countTerrainDataFind(bool found);
+    void countTerrainDataInit(bool fromDiskCache);
+    CTerrainDataCounters getTerrainDataCounters();
+    qint64 getHistoryMemoryBytes();
 
 private:
     static CPerformance *instance;
 
     QMutex mutex;
-    double fps;
-    double tups;
-    double *fpsHistory;
-    double *tupsHistory;
-    double *fpsGlobalTimeHistory;
-    double *tupsGlobalTimeHistory;
-    int fpsSavedMeasurements;
-    int tupsSavedMeasurements;
-    double fpsGlobalTime;
-    double tupsGlobalTime;
+    QElapsedTimer clock;                    // time of samples and events
+    qint64 historyStartNs;                  // samples and events before resetHistory() are not logged
+    double fps;                             // written and read only by OpenGL thread
+    double tups;                            // written and read only by terrain loader thread
+    qint64 frameStatsSentNs;
+    qint64 treeUpdateStatsSentNs;
+    CMetricRing frameTimes;                 // pushed only by OpenGL thread
+    CMetricRing treeUpdateTimes;            // pushed only by terrain loader thread
+    CMetricRing convergenceTimes;           // time to full detail - pushed under mutex
+    qint64 convergenceStartNs;              // camera settled, -1 when nobody waits for full detail
+    volatile bool convergenceTreeReady;     // tree from snapshot taken after settling has no postponed splits
     QString *eventsName;
     double *eventsTime;
     int eventsCount;
-    bool saveToHistory;
+    volatile bool saveToHistory;
+    CTerrainDataCounters terrainDataCounters;
 
+    qint64 getHistoryStartNs();
     void saveLog();
+    static void writeStats(QTextStream &out, const QString &name, const CMetricStats &stats);
+    static void writeHistory(QTextStream &out, const QVector<CMetricSample> &samples, qint64 startNs);
 };
 
 #endif // CPERFORMANCE_H
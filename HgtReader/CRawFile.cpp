@@ -165,7 +165,19 @@ void CRawFile::fileOpen(QString name, int sX, int sY)
 {
     sizeX = sX;
     sizeY = sY;
+    file.clear();           // failed open or read of previous file must not block this one
+    ioTimer.start();
     file.open(name.toAscii(), fstream::in | fstream::out | fstream::binary);
+    io.opens++;
+    io.timeNs += ioTimer.nsecsElapsed();
+}
+
+CIoCounters CRawFile::takeIoCounters()
+{
+    CIoCounters counters = io;
+
+    io.clear();
+    return counters;
 }
 
 void CRawFile::fileClose()
@@ -183,23 +195,46 @@ CRawPixel CRawFile::fileGetPixel(int x, int y)
 {
     CRawPixel pix;
 
+    ioTimer.start();
     file.seekg((y*sizeX + x)*3);
     file.read((char *)(&pix), 3);
+    io.seeks++;
+    io.reads++;
+    io.bytesRead += file.gcount();
+    io.timeNs += ioTimer.nsecsElapsed();
 
     return pix;
 }
 
 void CRawFile::fileGetPixelBlock(CRawPixel *buffer, int x, int y, int sx, int sy, int skip)
 {
-    int i;
+    CRawPixel *span;
+    int spanSize;
     int X, Y;
 
-    i = 0;
-    for (Y=0; Y<sy; Y++)
-        for (X=0; X<sx; X++) {
-            buffer[i] = fileGetPixel(x + X*skip, y + Y*skip);
-            i++;
+    if (sx<=0 || sy<=0)
+        return;
+
+    // one read of whole row span instead of seek & read for each pixel,
+    // without skipping span is read directly to buffer
+    spanSize = (sx-1)*skip + 1;
+    span = (skip==1) ? 0 : new CRawPixel[spanSize];
+    for (Y=0; Y<sy; Y++) {
+        ioTimer.start();
+        file.seekg((((qint64)(y + Y*skip))*sizeX + x)*3);
+        if (skip==1) {
+            file.read((char *)(buffer + Y*sx), sx*3);
+        } else {
+            file.read((char *)span, spanSize*3);
+            for (X=0; X<sx; X++)
+                buffer[Y*sx + X] = span[X*skip];
         }
+        io.seeks++;
+        io.reads++;
+        io.bytesRead += file.gcount();
+        io.timeNs += ioTimer.nsecsElapsed();
+    }
+    delete []span;
 }
 
 void CRawFile::fileSetPixelBlock(CRawPixel *buffer, int x, int y, int sx, int sy, int skip)
@@ -44,7 +44,9 @@
 #define CRAWFILE_H
 
 #include <QString>
+#include <QElapsedTimer>
 #include <fstream>
+#include "CIoCounters.h"
 
 using namespace std;
 
@@ -92,6 +94,7 @@ public:
     void savePGM(QString name);
     unsigned char *getPixelsPointer();
     void setPixelsPointer(int sx, int sy, CRawPixel *p);
+    CIoCounters takeIoCounters();
 
 private:
     fstream file;
@@ -99,6 +102,8 @@ private:
     int sizeX;
     int sizeY;
     bool externalPixelPointer;
+    CIoCounters io;                         // I/O of file* functions since last takeIoCounters
+    QElapsedTimer ioTimer;
 };
 
 #endif // CRAWFILE_H
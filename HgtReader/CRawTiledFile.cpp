@@ -0,0 +1,228 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <string.h>
+#include <QDataStream>
+#include <QByteArray>
+#include "CRawTiledFile.h"
+
+CRawTiledFile::CRawTiledFile()
+{
+    sizePx = 0;
+    blocks = 0;
+    groupBlocks = 0;
+}
+
+CRawTiledFile::~CRawTiledFile()
+{
+    fileClose();
+}
+
+void CRawTiledFile::getLayout(int size, int *blocks, int *groupBlocks)
+{
+    (*blocks) = size / RAW_TILED_BLOCK_SIZE;
+
+    // biggest power of 2 dividing blocks count, for example 768 blocks = 3 groups * 256 blocks
+    (*groupBlocks) = 1;
+    while ((*blocks) % ((*groupBlocks)*2) == 0)
+        (*groupBlocks) *= 2;
+}
+
+qint64 CRawTiledFile::getBlockOffset(int bx, int by, int blocks, int groupBlocks)
+{
+    int groups = blocks / groupBlocks;
+    qint64 rank;
+    int gx, gy, lx, ly, i;
+
+    gx = bx / groupBlocks;
+    gy = by / groupBlocks;
+    lx = bx % groupBlocks;
+    ly = by % groupBlocks;
+
+    // Z-order (Morton code) inside group
+    rank = 0;
+    for (i=0; (1 << i) < groupBlocks; i++) {
+        rank |= ((qint64)((lx >> i) & 1)) << (2*i);
+        rank |= ((qint64)((ly >> i) & 1)) << (2*i + 1);
+    }
+    rank += ((qint64)(gy*groups + gx)) * groupBlocks * groupBlocks;
+
+    return RAW_TILED_HEADER_SIZE + rank * RAW_TILED_BLOCK_BYTES;
+}
+
+bool CRawTiledFile::fileOpen(const QString &name, int size)
+{
+    QDataStream stream(&file);
+    quint32 magic, version, fileSize, blockSize;
+
+    fileClose();
+    file.setFileName(name);
+    ioTimer.start();
+    io.opens++;
+    if (!file.open(QIODevice::ReadOnly)) {
+        io.timeNs += ioTimer.nsecsElapsed();
+        return false;
+    }
+
+    stream >> magic >> version >> fileSize >> blockSize;
+    io.reads++;
+    io.bytesRead += RAW_TILED_HEADER_SIZE;
+    io.timeNs += ioTimer.nsecsElapsed();
+    if (magic!=RAW_TILED_MAGIC || version!=RAW_TILED_VERSION || (int)fileSize!=size || blockSize!=RAW_TILED_BLOCK_SIZE) {
+        file.close();
+        return false;
+    }
+
+    sizePx = size;
+    getLayout(sizePx, &blocks, &groupBlocks);
+
+    return true;
+}
+
+void CRawTiledFile::fileClose()
+{
+    if (file.isOpen())
+        file.close();
+}
+
+CIoCounters CRawTiledFile::takeIoCounters()
+{
+    CIoCounters counters = io;
+
+    io.clear();
+    return counters;
+}
+
+void CRawTiledFile::fileGetPixelBlock(CRawPixel *buffer, int x, int y, int sx, int sy, int skip)
+{
+    unsigned char block[RAW_TILED_BLOCK_BYTES];
+    qint64 bytes;
+    int bx, by, bxMin, bxMax, byMin, byMax;
+    int X, Y, XMin, XMax, YMin, YMax;
+    int px, py;
+
+    if (!file.isOpen() || sx<=0 || sy<=0)
+        return;
+
+    bxMin = x / RAW_TILED_BLOCK_SIZE;
+    bxMax = (x + (sx-1)*skip) / RAW_TILED_BLOCK_SIZE;
+    byMin = y / RAW_TILED_BLOCK_SIZE;
+    byMax = (y + (sy-1)*skip) / RAW_TILED_BLOCK_SIZE;
+
+    // each block with at least one sample is read once
+    for (by=byMin; by<=byMax; by++) {
+        YMin = (by*RAW_TILED_BLOCK_SIZE - y + skip - 1) / skip;
+        YMax = ((by+1)*RAW_TILED_BLOCK_SIZE - 1 - y) / skip;
+        if (YMin<0) YMin = 0;
+        if (YMax>sy-1) YMax = sy-1;
+        if (YMin>YMax) continue;
+
+        for (bx=bxMin; bx<=bxMax; bx++) {
+            XMin = (bx*RAW_TILED_BLOCK_SIZE - x + skip - 1) / skip;
+            XMax = ((bx+1)*RAW_TILED_BLOCK_SIZE - 1 - x) / skip;
+            if (XMin<0) XMin = 0;
+            if (XMax>sx-1) XMax = sx-1;
+            if (XMin>XMax) continue;
+
+            ioTimer.start();
+            file.seek(getBlockOffset(bx, by, blocks, groupBlocks));
+            bytes = file.read((char *)block, RAW_TILED_BLOCK_BYTES);
+            io.seeks++;
+            io.reads++;
+            io.bytesRead += qMax((qint64)0, bytes);
+            io.timeNs += ioTimer.nsecsElapsed();
+            if (bytes!=RAW_TILED_BLOCK_BYTES)
+                return;
+
+            for (Y=YMin; Y<=YMax; Y++)
+                for (X=XMin; X<=XMax; X++) {
+                    px = x + X*skip - bx*RAW_TILED_BLOCK_SIZE;
+                    py = y + Y*skip - by*RAW_TILED_BLOCK_SIZE;
+                    buffer[Y*sx + X] = CRawPixel(block[(py*RAW_TILED_BLOCK_SIZE + px)*3 + 0],
+                                                 block[(py*RAW_TILED_BLOCK_SIZE + px)*3 + 1],
+                                                 block[(py*RAW_TILED_BLOCK_SIZE + px)*3 + 2]);
+                }
+        }
+    }
+}
+
+bool CRawTiledFile::convert(const QString &rawName, const QString &tiledName, int size)
+{
+    QFile raw(rawName);
+    QFile tiled(tiledName);
+    QDataStream stream(&tiled);
+    QByteArray rows;
+    unsigned char block[RAW_TILED_BLOCK_BYTES];
+    int blocks, groupBlocks;
+    int bx, by, py;
+
+    if (size % RAW_TILED_BLOCK_SIZE != 0)
+        return false;
+    if (!raw.open(QIODevice::ReadOnly) || !tiled.open(QIODevice::WriteOnly))
+        return false;
+
+    getLayout(size, &blocks, &groupBlocks);
+    stream << (quint32)RAW_TILED_MAGIC << (quint32)RAW_TILED_VERSION << (quint32)size << (quint32)RAW_TILED_BLOCK_SIZE;
+
+    // one row of blocks in memory at a time
+    for (by=0; by<blocks; by++) {
+        rows = raw.read((qint64)size * 3 * RAW_TILED_BLOCK_SIZE);
+        if (rows.size()!=size * 3 * RAW_TILED_BLOCK_SIZE)
+            return false;
+
+        for (bx=0; bx<blocks; bx++) {
+            for (py=0; py<RAW_TILED_BLOCK_SIZE; py++)
+                memcpy(block + py*RAW_TILED_BLOCK_SIZE*3,
+                       rows.constData() + (py*size + bx*RAW_TILED_BLOCK_SIZE)*3,
+                       RAW_TILED_BLOCK_SIZE*3);
+
+            tiled.seek(getBlockOffset(bx, by, blocks, groupBlocks));
+            if (tiled.write((const char *)block, RAW_TILED_BLOCK_BYTES)!=RAW_TILED_BLOCK_BYTES)
+                return false;
+        }
+    }
+
+    tiled.close();
+    raw.close();
+
+    return true;
+}
@@ -0,0 +1,87 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CRAWTILEDFILE_H
+#define CRAWTILEDFILE_H
+
+#include <QString>
+#include <QFile>
+#include <QElapsedTimer>
+#include "CRawFile.h"
+#include "CIoCounters.h"
+
+#define RAW_TILED_SUFFIX              "rawt"
+#define RAW_TILED_MAGIC               0x52415754    // "RAWT"
+#define RAW_TILED_VERSION             1
+#define RAW_TILED_HEADER_SIZE         16            // magic, version, size in pixels, block size
+#define RAW_TILED_BLOCK_SIZE          32            // block of pixels stored together - same as TEX_TERRAIN_SIZE
+#define RAW_TILED_BLOCK_BYTES       3072            // RAW_TILED_BLOCK_SIZE^2 * 3
+
+// RAW texture file split to 32x32 pixel blocks - blocks are in Z-order inside groups
+// of power of 2 blocks (RAW sizes are 3*2^n pixels), groups are in rows
+// so 32x32 texture window is at most 4 small reads instead of pixel by pixel reading
+class CRawTiledFile
+{
+public:
+    CRawTiledFile();
+    ~CRawTiledFile();
+
+    bool fileOpen(const QString &name, int size);
+    void fileClose();
+    void fileGetPixelBlock(CRawPixel *buffer, int x, int y, int sx, int sy, int skip);
+    CIoCounters takeIoCounters();
+
+    static bool convert(const QString &rawName, const QString &tiledName, int size);
+
+private:
+    QFile file;
+    int sizePx;
+    int blocks;                 // blocks along one side
+    int groupBlocks;            // blocks along one side of Z-order group
+    CIoCounters io;             // I/O of file* functions since last takeIoCounters
+    QElapsedTimer ioTimer;
+
+    static void getLayout(int size, int *blocks, int *groupBlocks);
+    static qint64 getBlockOffset(int bx, int by, int blocks, int groupBlocks);
+};
+
+#endif // CRAWTILEDFILE_H
@@ -0,0 +1,132 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CSEQRING_H
+#define CSEQRING_H
+
+#include <QtGlobal>
+#include <QAtomicInt>
+
+// one item of CSeqRing - sequence is odd while item is written, even when it is complete
+template <class T>
+class CSeqRingSlot
+{
+public:
+    QAtomicInt sequence;
+    T item;
+};
+
+// ring of items pushed by single thread without lock and read by any thread, the oldest items
+// are overwritten - every slot has sequence number of the item it holds so reader drops item
+// overwritten while it was copied (seqlock), head is 64-bit so it never overflows,
+// T is copied as it is so it must be plain data - header only because it is template
+template <class T>
+class CSeqRing
+{
+public:
+    CSeqRing(int ringSize)
+    {
+        size = ringSize;                    // power of two
+        ring = new CSeqRingSlot<T>[size];
+        head = 0;
+    }
+    ~CSeqRing()
+    {
+        delete []ring;
+    }
+
+    void push(const T &item)
+    {
+        qint64 h = head;                    // only writer changes head
+        CSeqRingSlot<T> *slot = &ring[h & (size-1)];
+
+        slot->sequence.fetchAndStoreOrdered(getSequence(h) - 1);
+        slot->item = item;
+        slot->sequence.fetchAndStoreRelease(getSequence(h));
+
+        headSequence.fetchAndAddOrdered(1);
+        head = h + 1;
+        headSequence.fetchAndAddRelease(1);
+    }
+
+    // items pushed so far - items from max(0, head-size) to head-1 can be read
+    qint64 getHead() const
+    {
+        qint64 h;
+        int before, after;
+
+        do {
+            before = headSequence.fetchAndAddAcquire(0);
+            h = head;
+            after = headSequence.fetchAndAddOrdered(0);
+        } while ((before & 1) || before!=after);
+
+        return h;
+    }
+
+    // false when item was already overwritten or it is just being written
+    bool read(qint64 index, T *item) const
+    {
+        CSeqRingSlot<T> *slot = &ring[index & (size-1)];
+        int sequence = getSequence(index);
+
+        if (slot->sequence.fetchAndAddAcquire(0)!=sequence)
+            return false;
+        (*item) = slot->item;
+
+        return (slot->sequence.fetchAndAddOrdered(0)==sequence) ? true : false;
+    }
+
+    int getSize() const { return size; }
+    static int getSlotBytes() { return sizeof(CSeqRingSlot<T>); }
+
+private:
+    CSeqRingSlot<T> *ring;
+    int size;
+    volatile qint64 head;                   // changed only inside odd headSequence
+    mutable QAtomicInt headSequence;
+
+    // even number for each pass of ring - slot never written has 0
+    int getSequence(qint64 index) const { return (int)(quint32)(2*(index/size) + 2); }
+};
+
+#endif // CSEQRING_H
@@ -41,17 +41,31 @@
  */
 
 #include <QDebug>
+#include <QThreadPool>
+#include <math.h>
 #include "CCommons.h"
 #include "CTerrain.h"
 #include "CCacheManager.h"
 #include "CPerformance.h"
 #include "CDrawingStateSnapshot.h"
+#include "CTerrainUpdateTask.h"
 
 
 CTerrain::CTerrain()
 {
     visible = false;
     terrainInCameraFOV = false;
+    hiddenByLod = false;
+    mergeDelayCounter = 0;
+
+    subtreeUpToDate = false;
+    subtreeTerrainsCount = 0;
+    subtreeMaxLOD = -1;
+    subtreeMinClosestDistance = 2000.0*CONST_1GM;
+    updatedCamClippingAngleCosine = 0.0;
+    updatedCamFOV = 0.0;
+    updatedCamViewportHeight = 0.0;
+    updatedLodMultiplier = 0.0;
 
     terrainPointClosestToCam = 0;
     terrainPointClosestToCamDistance = 2000.0*CONST_1GM; // 2 milions km it's far beyond the maximum position of the camera
@@ -146,70 +160,232 @@ bool CTerrain::getTerrainVisibility()
     return (cameraCloseToTerrain || !beyondTheHorizon) ? true : false;
 }
 
-int CTerrain::getLodToRender()
+double CTerrain::getScreenSpaceError()
 {
     CDrawingStateSnapshot *dss = earth->drawingStateSnapshot;
+    double distance;
 
-    if (terrainPointClosestToCamDistance <     5.2*CONST_1KM*dss->lodMultiplier) return 13; else
-    if (terrainPointClosestToCamDistance <    10.4*CONST_1KM*dss->lodMultiplier) return 12; else
-    if (terrainPointClosestToCamDistance <    20.8*CONST_1KM*dss->lodMultiplier) return 11; else
-    if (terrainPointClosestToCamDistance <    41.6*CONST_1KM*dss->lodMultiplier) return 10; else
-    if (terrainPointClosestToCamDistance <    83.2*CONST_1KM*dss->lodMultiplier) return  9; else
-    if (terrainPointClosestToCamDistance <   166.4*CONST_1KM*dss->lodMultiplier) return  8; else
-    if (terrainPointClosestToCamDistance <   332.8*CONST_1KM*dss->lodMultiplier) return  7; else
-    if (terrainPointClosestToCamDistance <   665.6*CONST_1KM*dss->lodMultiplier) return  6; else
-    if (terrainPointClosestToCamDistance <  1331.2*CONST_1KM*dss->lodMultiplier) return  5; else
-    if (terrainPointClosestToCamDistance <  2662.5*CONST_1KM*dss->lodMultiplier) return  4; else
-    if (terrainPointClosestToCamDistance <  5324.9*CONST_1KM*dss->lodMultiplier) return  3; else
-    if (terrainPointClosestToCamDistance < 10649.9*CONST_1KM*dss->lodMultiplier) return  2; else
-    if (terrainPointClosestToCamDistance < 21299.7*CONST_1KM*dss->lodMultiplier) return  1; else
-                                                                                 return  0;
+    distance = terrainPointClosestToCamDistance;
+    if (distance<1.0)
+        distance = 1.0;
+
+    // terrain geometric error projected to screen (in pixels)
+    return (terrainData->geometricError * dss->camViewportHeight) /
+           (2.0 * distance * tan(CONST_PIDIV180 * dss->camFOV / 2.0));
+}
+
+double CTerrain::getDistanceToCam()
+{
+    CDrawingStateSnapshot *dss = earth->drawingStateSnapshot;
+
+    return (terrainData->middleMiddlePoint - dss->camPosition).length();
+}
+
+bool CTerrain::isUpdateNeeded()
+{
+    CDrawingStateSnapshot *dss = earth->drawingStateSnapshot;
+
+    if (!subtreeUpToDate)
+        return true;
+
+    if (dss->lodMultiplier!=updatedLodMultiplier ||
+        dss->camFOV!=updatedCamFOV ||
+        dss->camViewportHeight!=updatedCamViewportHeight ||
+        dss->camClippingAngleCosine!=updatedCamClippingAngleCosine)
+        return true;
+
+    // camera movement is compared with distance to the closest terrain of subtree - far subtrees are rarely updated,
+    // but coarse terrain above finely refined one is updated as often as its finest part
+    if ((dss->camPosition - updatedCamPosition).length() > TREE_UPDATE_CAM_MOVE_RATIO*subtreeMinClosestDistance)
+        return true;
+
+    if (QVector3D::dotProduct(dss->camLookingDirectionNormal, updatedCamLookingDirectionNormal) < TREE_UPDATE_CAM_ROTATION_COSINE)
+        return true;
+
+    return false;
+}
+
+void CTerrain::updateChildrenTerrainTree(CPerformanceCounters *counters)
+{
+    CTerrain *children[4];
+    double distance[4];
+    CTerrainUpdateTask *tasks[4];
+    QSemaphore tasksDone;
+    CTerrain *tmpChild;
+    double tmpDistance;
+    int tasksStarted;
+    int i, j;
+
+    children[0] = NWchild;
+    children[1] = NEchild;
+    children[2] = SWchild;
+    children[3] = SEchild;
+    for (i=0; i<4; i++)
+        distance[i] = children[i]->getDistanceToCam();
+
+    // the closest child first - when time budget runs out the farthest ones wait for next cycle
+    for (i=1; i<4; i++)
+        for (j=i; j>0 && distance[j]<distance[j-1]; j--) {
+            tmpDistance = distance[j]; distance[j] = distance[j-1]; distance[j-1] = tmpDistance;
+            tmpChild = children[j]; children[j] = children[j-1]; children[j-1] = tmpChild;
+        }
+
+    // near the root subtrees are big - farther children go to idle pool threads,
+    // tryStart never waits for a thread but on Qt4 task may still be queued behind
+    // root tasks, so tasks not started yet are claimed back and run on this thread
+    tasksStarted = 0;
+    for (i=0; i<4; i++)
+        tasks[i] = 0;
+    if (terrainData->LOD < TREE_UPDATE_PARALLEL_MAX_LOD) {
+        for (i=1; i<4; i++) {
+            tasks[i] = new CTerrainUpdateTask(children[i], &tasksDone);
+            if (QThreadPool::globalInstance()->tryStart(tasks[i])) {
+                tasksStarted++;
+            } else {
+                delete tasks[i];
+                tasks[i] = 0;
+            }
+        }
+    }
+
+    for (i=0; i<4; i++) {
+        if (tasks[i]==0)
+            children[i]->updateTerrainTree(counters);
+    }
+
+    // pool worker never waits for queued task - only for tasks already running on other threads
+    for (i=0; i<4; i++) {
+        if (tasks[i]!=0 && tasks[i]->claim()) {
+            children[i]->updateTerrainTree(&tasks[i]->counters);
+            tasksStarted--;
+        }
+    }
+
+    tasksDone.acquire(tasksStarted);
+
+    for (i=0; i<4; i++) {
+        if (tasks[i]!=0) {
+            counters->add(tasks[i]->counters);
+            tasks[i]->unreference();
+        }
+        if (!children[i]->subtreeUpToDate)
+            subtreeUpToDate = false;
+        if (children[i]->subtreeMaxLOD > subtreeMaxLOD)
+            subtreeMaxLOD = children[i]->subtreeMaxLOD;
+        if (children[i]->subtreeMinClosestDistance < subtreeMinClosestDistance)
+            subtreeMinClosestDistance = children[i]->subtreeMinClosestDistance;
+    }
 }
 
-void CTerrain::updateTerrainTree()
+void CTerrain::updateTerrainTree(CPerformanceCounters *counters)
 {
     if (terrainData==0)
         qFatal("Terrain in tree - terrainData pointer is NULL!");
 
-    CPerformance *performance = CPerformance::getInstance();
-    int LODtoRender;
+    CDrawingStateSnapshot *dss = earth->drawingStateSnapshot;
+    int terrainsInTreeBefore;
+    double sse, sseTolerance;
+    double chordSag;
+    bool splitNeeded, mergeNeeded;
+
+    // camera almost didn't change since last update - whole subtree stays as it is
+    if (!isUpdateNeeded()) {
+        counters->terrainsInTree += subtreeTerrainsCount;
+        if (subtreeMaxLOD > counters->maxLOD)
+            counters->maxLOD = subtreeMaxLOD;
+        return;
+    }
+
+    counters->terrainsUpdated++;
+    terrainsInTreeBefore = counters->terrainsInTree;
+    subtreeUpToDate = true;
+    subtreeMaxLOD = -1;
+    updatedCamPosition = dss->camPosition;
+    updatedCamLookingDirectionNormal = dss->camLookingDirectionNormal;
+    updatedCamClippingAngleCosine = dss->camClippingAngleCosine;
+    updatedCamFOV = dss->camFOV;
+    updatedCamViewportHeight = dss->camViewportHeight;
+    updatedLodMultiplier = dss->lodMultiplier;
 
     visible = getTerrainVisibility();
+    subtreeMinClosestDistance = terrainPointClosestToCamDistance;
     if (!visible) {
-        merge();
-        performance->terrainsInTree++;
+        mergeDeferred();
+        if (mergeDelayCounter>0)
+            subtreeUpToDate = false;
+        counters->terrainsInTree++;
+        subtreeTerrainsCount = counters->terrainsInTree - terrainsInTreeBefore;
         return;
     }
 
-    LODtoRender = getLodToRender();
-    if (LODtoRender<terrainData->LOD)
-        visible = false;
+    sse = getScreenSpaceError();
+    sseTolerance = LOD_SSE_PIXEL_TOLERANCE / dss->lodMultiplier;
+
+    // terrain is too detailed - parent will draw this quarter (parent error is ~2x bigger)
+    if (terrainData->LOD>0) {
+        if (hiddenByLod) {
+            if (2.0*sse > sseTolerance*(1.0+LOD_SSE_HYSTERESIS))
+                hiddenByLod = false;
+        } else {
+            if (2.0*sse < sseTolerance*(1.0-LOD_SSE_HYSTERESIS))
+                hiddenByLod = true;
+        }
+        if (hiddenByLod)
+            visible = false;
+    }
+
+    // between split and merge tolerance current state of terrain is kept
+    splitNeeded = false;
+    mergeNeeded = true;
+    if (terrainData->LOD<LOD_MAX) {
+        splitNeeded = (sse > sseTolerance*(1.0+LOD_SSE_HYSTERESIS)) ? true : false;
+        mergeNeeded = (sse < sseTolerance*(1.0-LOD_SSE_HYSTERESIS)) ? true : false;
+    }
+
+    // flat terrain (ocean, missing data) - children wouldn't add any detail,
+    // but chords of coarse terrain sag below the sphere so only fine enough terrain is kept
+    chordSag = CONST_EARTH_RADIUS * (1.0 - cos(CONST_PIDIV180 * terrainData->degreeSize / 16.0));
+    if (terrainData->childrenHeightRange>=0 &&
+        terrainData->childrenHeightRange + chordSag <= TERRAIN_FLAT_HEIGHT_RANGE) {
+        splitNeeded = false;
+        mergeNeeded = true;
+    }
 
-    // split terrain when LOD to render is bigger that current terrain LOD
-    if (LODtoRender>terrainData->LOD) {
+    // out of time in this cycle - split is postponed to next tree update
+    if (splitNeeded && NWchild==0 && earth->isUpdateBudgetExceeded()) {
+        splitNeeded = false;
+        subtreeUpToDate = false;
+        counters->splitsPostponed++;
+    }
+
+    if (splitNeeded || (NWchild!=0 && !mergeNeeded)) {
+        mergeDelayCounter = 0;
         split();
-        NWchild->updateTerrainTree();
-        NEchild->updateTerrainTree();
-        SWchild->updateTerrainTree();
-        SEchild->updateTerrainTree();
-    } else
-        if (LODtoRender<=terrainData->LOD) {
-            merge();
-        }
+        updateChildrenTerrainTree(counters);
+    } else {
+        mergeDeferred();
+        if (mergeDelayCounter>0)
+            subtreeUpToDate = false;
+    }
 
     // performance info
-    performance->terrainsInTree++;
-    if (terrainData->LOD > performance->maxLOD)
-        performance->maxLOD = terrainData->LOD;
+    counters->terrainsInTree++;
+    if (terrainData->LOD > counters->maxLOD)
+        counters->maxLOD = terrainData->LOD;
+    if (terrainData->LOD > subtreeMaxLOD)
+        subtreeMaxLOD = terrainData->LOD;
+    subtreeTerrainsCount = counters->terrainsInTree - terrainsInTreeBefore;
 }
 
 void CTerrain::initTerrainData(double lon, double lat, int lod, const CDrawingStateSnapshot *dss)
 {
     CCacheManager *cacheManager = CCacheManager::getInstance();
+    CPerformance *performance = CPerformance::getInstance();
     bool TDfound;
 
     if (!dss->dontUseCache) {
         TDfound = cacheManager->cacheTerrainDataFind(lon, lat, lod, earth, &terrainData);
+        performance->countTerrainDataFind(TDfound);
         if (!TDfound) {
             terrainData = new CTerrainData();
             terrainData->initTerrainData(lon, lat, lod, dss);
@@ -242,8 +418,32 @@ void CTerrain::split()
                              terrainData->LOD+1, dss);
 }
 
+void CTerrain::mergeDeferred()
+{
+    if (NWchild==0) return;
+
+    // children are kept for few cycles to avoid split/merge/split at LOD boundaries
+    mergeDelayCounter++;
+    if (mergeDelayCounter>=LOD_MERGE_DELAY_CYCLES) {
+        merge();
+        return;
+    }
+
+    // hidden children must be updated again when parent splits back within the delay
+    NWchild->visible = false;
+    NEchild->visible = false;
+    SWchild->visible = false;
+    SEchild->visible = false;
+    NWchild->subtreeUpToDate = false;
+    NEchild->subtreeUpToDate = false;
+    SWchild->subtreeUpToDate = false;
+    SEchild->subtreeUpToDate = false;
+}
+
 void CTerrain::merge()
 {
+    mergeDelayCounter = 0;
+
     if (NWchild!=0) {
         delete NWchild; NWchild = 0;
         delete NEchild; NEchild = 0;
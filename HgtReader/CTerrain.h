@@ -47,6 +47,15 @@
 #include <QColor>
 #include "CEarth.h"
 #include "CTerrainData.h"
+#include "CPerformance.h"
+
+#define LOD_MAX                         13
+#define LOD_SSE_PIXEL_TOLERANCE         16.8      // allowed projected error in pixels for lodMultiplier = 1.0
+#define LOD_SSE_HYSTERESIS              0.15      // split above tolerance*(1+h), merge below tolerance*(1-h)
+#define LOD_MERGE_DELAY_CYCLES          30        // tree updates before children are really deleted
+#define TREE_UPDATE_CAM_MOVE_RATIO      0.005     // subtree is updated when camera moved more than ratio*distance
+#define TREE_UPDATE_CAM_ROTATION_COSINE 0.99996   // subtree is updated when camera rotated more than ~0.5 deg
+#define TREE_UPDATE_PARALLEL_MAX_LOD    8         // children of terrains below this LOD may be updated by other threads
 
 
 class CEarth;
@@ -59,7 +68,8 @@ public:
 
     void setEarth(CEarth *earthPtr);
     bool draw();
-    void updateTerrainTree();
+    void updateTerrainTree(CPerformanceCounters *counters);
+    double getDistanceToCam();
     unsigned char *getTexturePointer();
     void initTerrainData(double lon, double lat, int lod, const CDrawingStateSnapshot *dss);
 
@@ -70,6 +80,18 @@ private:
     double terrainPointClosestToCamDistance;
     bool visible;
     bool terrainInCameraFOV;
+    bool hiddenByLod;
+    int mergeDelayCounter;
+    bool subtreeUpToDate;                   // whole subtree was updated (no postponed splits or pending merges)
+    int subtreeTerrainsCount;               // terrains in subtree during last update
+    int subtreeMaxLOD;                      // max LOD in subtree during last update
+    double subtreeMinClosestDistance;       // distance of the closest terrain point in subtree to camera during last update
+    QVector3D updatedCamPosition;           // camera state used during last update
+    QVector3D updatedCamLookingDirectionNormal;
+    double updatedCamClippingAngleCosine;
+    double updatedCamFOV;
+    double updatedCamViewportHeight;
+    double updatedLodMultiplier;
     CTerrainData *terrainData;
     CTerrain *NWchild;
     CTerrain *NEchild;
@@ -78,7 +100,10 @@ private:
 
     void split();
     void merge();
-    int getLodToRender();
+    void mergeDeferred();
+    bool isUpdateNeeded();
+    void updateChildrenTerrainTree(CPerformanceCounters *counters);
+    double getScreenSpaceError();
     void findTerrainPointClosestToCam();
     bool getTerrainVisibility();
 };
@@ -0,0 +1,251 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QDataStream>
+#include "CTerrainContainer.h"
+#include "CElevationCodec.h"
+
+CTerrainContainer::CTerrainContainer()
+{
+    int i;
+
+    lastModified = 0;
+    for (i=0; i<TERRAIN_CONTAINER_LEVELS; i++) {
+        levelWidth[i] = 0;
+        levelHeight[i] = 0;
+    }
+}
+
+quint64 CTerrainContainer::getChunkKey(int level, int cx, int cy)
+{
+    quint64 key = 0;
+    int i;
+
+    // Z-order (Morton code) of chunk inside level, level in highest bits
+    for (i=0; i<28; i++) {
+        key |= ((quint64)((cx >> i) & 1)) << (2*i);
+        key |= ((quint64)((cy >> i) & 1)) << (2*i + 1);
+    }
+
+    return (((quint64)level) << 56) | key;
+}
+
+bool CTerrainContainer::open(const QString &fileName)
+{
+    QDataStream *stream;
+    quint32 magic, version, chunkIntervals, levels;
+    quint64 indexOffset, chunkCount;
+    qint32 width, height;
+    int level;
+
+    if (!indexedFile.open(fileName))
+        return false;
+    stream = indexedFile.getStream();
+
+    (*stream) >> magic >> version >> chunkIntervals >> levels;
+    if (magic!=TERRAIN_CONTAINER_MAGIC || version<1 || version>TERRAIN_CONTAINER_VERSION ||
+        chunkIntervals!=TERRAIN_CONTAINER_CHUNK_INTERVALS || levels!=TERRAIN_CONTAINER_LEVELS) {
+        qWarning("Terrain container - unknown format of %s", qPrintable(fileName));
+        indexedFile.close();
+        return false;
+    }
+    for (level=0; level<TERRAIN_CONTAINER_LEVELS; level++) {
+        (*stream) >> width >> height;
+        levelWidth[level] = width;
+        levelHeight[level] = height;
+    }
+    (*stream) >> indexOffset >> chunkCount;
+
+    if (!checkLevels()) {
+        qWarning("Terrain container - header of %s is corrupted", qPrintable(fileName));
+        indexedFile.close();
+        return false;
+    }
+
+    // level is in highest bits of sorted keys - the last key has the highest level
+    if (!indexedFile.readIndex(TERRAIN_CONTAINER_HEADER_SIZE, indexOffset, chunkCount, TERRAIN_CONTAINER_INDEX_RECORD,
+                               0, TERRAIN_CONTAINER_CHUNK_DELTA) ||
+        (indexedFile.getLastKey() >> 56)>=TERRAIN_CONTAINER_LEVELS) {
+        qWarning("Terrain container - index of %s is corrupted", qPrintable(fileName));
+        indexedFile.close();
+        return false;
+    }
+    lastModified = indexedFile.lastModified;
+
+    return true;
+}
+
+bool CTerrainContainer::checkLevels()
+{
+    int level;
+
+    for (level=0; level<TERRAIN_CONTAINER_LEVELS; level++)
+        if (levelWidth[level]<=0 || levelHeight[level]<=0 ||
+            levelWidth[level]%TERRAIN_CONTAINER_CHUNK_INTERVALS!=0 ||
+            levelHeight[level]%TERRAIN_CONTAINER_CHUNK_INTERVALS!=0)
+            return false;
+
+    return true;
+}
+
+bool CTerrainContainer::readChunk(quint64 key, quint16 *samples, CIoCounters *io)
+{
+    QByteArray bytes;
+    const uchar *data;
+    quint32 flags;
+    int i;
+
+    if (!indexedFile.read(key, &bytes, &flags, io))
+        return false;                       // sea level chunk
+
+    if (flags==TERRAIN_CONTAINER_CHUNK_DELTA) {
+        if (CElevationCodec::decode(bytes, samples, TERRAIN_CONTAINER_CHUNK_SAMPLES, TERRAIN_CONTAINER_CHUNK_SAMPLES))
+            return true;
+    } else {
+        if (flags==TERRAIN_CONTAINER_CHUNK_QCOMPRESS)
+            bytes = qUncompress(bytes);
+        if (bytes.size()==TERRAIN_CONTAINER_CHUNK_SAMPLES*TERRAIN_CONTAINER_CHUNK_SAMPLES*2) {
+            data = (const uchar *)bytes.constData();
+            for (i=0; i<TERRAIN_CONTAINER_CHUNK_SAMPLES*TERRAIN_CONTAINER_CHUNK_SAMPLES; i++)
+                samples[i] = (data[2*i] << 8) + data[2*i + 1];
+            return true;
+        }
+    }
+
+    // corrupted chunk - sea level like missing HGT file
+    qWarning("Terrain container - chunk %llx is corrupted", key);
+    return false;
+}
+
+void CTerrainContainer::findChunkPositions(int level, int x, int y, int sx, int sy, int skip,
+                                           int *cx, int *lx, int *cy, int *ly)
+{
+    int X, Y, sampleX, sampleY;
+
+    // longitude wraps around
+    for (X=0; X<sx; X++) {
+        sampleX = (x + X*skip) % levelWidth[level];
+        if (sampleX<0) sampleX += levelWidth[level];
+        cx[X] = sampleX / TERRAIN_CONTAINER_CHUNK_INTERVALS;
+        lx[X] = sampleX - cx[X]*TERRAIN_CONTAINER_CHUNK_INTERVALS;
+    }
+
+    // outside of poles - sea level like missing HGT file
+    for (Y=0; Y<sy; Y++) {
+        sampleY = y + Y*skip;
+        if (sampleY<0 || sampleY>levelHeight[level]) {
+            cy[Y] = -1;
+            ly[Y] = 0;
+            continue;
+        }
+        cy[Y] = sampleY / TERRAIN_CONTAINER_CHUNK_INTERVALS;
+        if (cy[Y]*TERRAIN_CONTAINER_CHUNK_INTERVALS==levelHeight[level])
+            cy[Y]--;                        // last row is bottom edge of last chunk
+        ly[Y] = sampleY - cy[Y]*TERRAIN_CONTAINER_CHUNK_INTERVALS;
+    }
+}
+
+void CTerrainContainer::getHeightBlock(int *buffer, int level, int x, int y, int sx, int sy, int skip, CIoCounters *io)
+{
+    quint16 samples[TERRAIN_CONTAINER_CHUNK_SAMPLES*TERRAIN_CONTAINER_CHUNK_SAMPLES];
+    QVector<int> cx(sx), lx(sx), cy(sy), ly(sy);
+    int X, Y, runX, runY, endX, endY;
+    bool found;
+
+    findChunkPositions(level, x, y, sx, sy, skip, cx.data(), lx.data(), cy.data(), ly.data());
+
+    // block is walked in runs of rows & columns from the same chunk - each chunk is decoded once
+    for (runY=0; runY<sy; runY=endY) {
+        endY = runY + 1;
+        while (endY<sy && cy[endY]==cy[runY]) endY++;
+
+        for (runX=0; runX<sx; runX=endX) {
+            endX = runX + 1;
+            while (endX<sx && cx[endX]==cx[runX]) endX++;
+
+            found = (cy[runY]!=-1 && readChunk(getChunkKey(level, cx[runX], cy[runY]), samples, io));
+            for (Y=runY; Y<endY; Y++)
+                for (X=runX; X<endX; X++)
+                    buffer[Y*sx + X] = found ? samples[ly[Y]*TERRAIN_CONTAINER_CHUNK_SAMPLES + lx[X]] : 0;
+        }
+    }
+}
+
+void CTerrainContainer::getHeightMinMax(int level, int x, int y, int sx, int sy, int *minHeight, int *maxHeight, CIoCounters *io)
+{
+    quint16 samples[TERRAIN_CONTAINER_CHUNK_SAMPLES*TERRAIN_CONTAINER_CHUNK_SAMPLES];
+    QVector<int> cx(sx), lx(sx), cy(sy), ly(sy);
+    int X, Y, runX, runY, endX, endY, hgt;
+
+    findChunkPositions(level, x, y, sx, sy, 1, cx.data(), lx.data(), cy.data(), ly.data());
+
+    (*minHeight) = 65535;
+    (*maxHeight) = 0;
+
+    // block is walked in runs of rows & columns from the same chunk - each chunk is decoded once
+    for (runY=0; runY<sy; runY=endY) {
+        endY = runY + 1;
+        while (endY<sy && cy[endY]==cy[runY]) endY++;
+
+        for (runX=0; runX<sx; runX=endX) {
+            endX = runX + 1;
+            while (endX<sx && cx[endX]==cx[runX]) endX++;
+
+            if (cy[runY]==-1 || !readChunk(getChunkKey(level, cx[runX], cy[runY]), samples, io)) {
+                (*minHeight) = 0;           // sea level
+                continue;
+            }
+
+            for (Y=runY; Y<endY; Y++)
+                for (X=runX; X<endX; X++) {
+                    hgt = samples[ly[Y]*TERRAIN_CONTAINER_CHUNK_SAMPLES + lx[X]];
+
+                    // SRTM data error marked as very hight altidute
+                    if (hgt>9000)
+                        hgt = 10;
+
+                    if (hgt<(*minHeight)) (*minHeight) = hgt;
+                    if (hgt>(*maxHeight)) (*maxHeight) = hgt;
+                }
+        }
+    }
+}
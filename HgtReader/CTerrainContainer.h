@@ -0,0 +1,94 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CTERRAINCONTAINER_H
+#define CTERRAINCONTAINER_H
+
+#include <QString>
+#include <QVector>
+#include "CIoCounters.h"
+#include "CIndexedFile.h"
+
+#define TERRAIN_CONTAINER_FILE              "terrain.hgtc"  // all HGT levels in one file
+#define TERRAIN_CONTAINER_MAGIC             0x48475443      // "HGTC"
+#define TERRAIN_CONTAINER_VERSION           2               // version 1 files (raw & qCompress chunks only) are read too
+#define TERRAIN_CONTAINER_LEVELS            3               // L00-L03, L04-L08, L09-L13 - same as HGT_SOURCE_xxx
+#define TERRAIN_CONTAINER_CHUNK_INTERVALS   64              // chunk has 65x65 samples, edge samples are shared with neighbor chunk
+#define TERRAIN_CONTAINER_CHUNK_SAMPLES     65
+#define TERRAIN_CONTAINER_HEADER_SIZE       56              // bytes before first chunk
+#define TERRAIN_CONTAINER_INDEX_RECORD      INDEXED_FILE_RECORD_SIZED   // key, offset, size & flags of one chunk
+#define TERRAIN_CONTAINER_CHUNK_RAW         0               // big endian samples like in HGT file
+#define TERRAIN_CONTAINER_CHUNK_QCOMPRESS   1               // qCompress'ed big endian samples
+#define TERRAIN_CONTAINER_CHUNK_DELTA       2               // CElevationCodec - delta, zigzag, byte planes, qCompress
+
+// all HGT levels in one file - each level is one global grid of samples split to chunks,
+// chunks are stored in Z-order so neighbor chunks are mostly close to each other in file,
+// chunks with sea level only are not stored
+//
+// layout: header (magic, version, chunk intervals, levels, width & height of each level
+//         in intervals, index offset, chunks count), chunks, index sorted by chunk key
+class CTerrainContainer
+{
+public:
+    CTerrainContainer();
+
+    unsigned int lastModified;
+
+    bool open(const QString &fileName);
+    bool isOpen() { return indexedFile.isOpen(); }
+    int getLevelWidth(int level) { return levelWidth[level]; }
+    void getHeightBlock(int *buffer, int level, int x, int y, int sx, int sy, int skip, CIoCounters *io);
+    void getHeightMinMax(int level, int x, int y, int sx, int sy, int *minHeight, int *maxHeight, CIoCounters *io);
+
+    static quint64 getChunkKey(int level, int cx, int cy);
+
+private:
+    CIndexedFile indexedFile;
+    int levelWidth[TERRAIN_CONTAINER_LEVELS];         // in sample intervals, longitude wraps around
+    int levelHeight[TERRAIN_CONTAINER_LEVELS];
+
+    bool checkLevels();
+    bool readChunk(quint64 key, quint16 *samples, CIoCounters *io);
+    void findChunkPositions(int level, int x, int y, int sx, int sy, int skip, int *cx, int *lx, int *cy, int *ly);
+};
+
+#endif // CTERRAINCONTAINER_H
@@ -40,9 +40,22 @@
  *   -------------------------------------------------------------------------
  */
 
+#include <string.h>
 #include "CTerrainData.h"
 #include "CCacheManager.h"
 #include "CCommons.h"
+#include "CCompactTerrainData.h"
+#include "CBc1Codec.h"
+#include "CPerformance.h"
+#include "CTraceZone.h"
+
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT  0x83F0
+#endif
+
+// OpenGL 1.3 function - not exported by every OpenGL library so it is resolved at runtime
+typedef void (APIENTRY *PFNCOMPRESSEDTEXIMAGE2D)(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height,
+                                                 GLint border, GLsizei imageSize, const GLvoid *data);
 
 
 CTerrainData::CTerrainData()
@@ -54,14 +67,22 @@ CTerrainData::CTerrainData()
     h = new QVector3D[81];
     sphere = new QVector3D[81];
     n = new QVector3D[81];
-    c = new QColor[81];
+    c = 0;                          // colors & uv are allocated when terrain data is known
     texture = new uint8_t[3*32*32];
-    uv = new QVector2D[81];
+    textureCompressed = 0;          // allocated only when pre-built texture tiles are compressed
+    uv = 0;
+    heights = new quint16[TERRAIN_HEIGHTS_COUNT];
+    textureShared = false;
+    colorsShared = false;
+    uvShared = false;
 
     textureID = 0;
     topLeftLon = 0.0;
     topLeftLat = 0.0;
     degreeSize = -1.0;
+    heightStdDev = 0.0;
+    geometricError = 0.0;
+    childrenHeightRange = -1;
     LOD = -1;
 }
 
@@ -76,9 +97,18 @@ CTerrainData::CTerrainData(CTerrainData *source)
     h = new QVector3D[81];
     sphere = new QVector3D[81];
     n = new QVector3D[81];
-    c = new QColor[81];
-    texture = new uint8_t[3*32*32];
-    uv = new QVector2D[81];
+    textureShared = source->textureShared;
+    colorsShared = source->colorsShared;
+    uvShared = source->uvShared;
+    c = colorsShared ? source->c : new QColor[81];
+    texture = textureShared ? source->texture : new uint8_t[3*32*32];
+    textureCompressed = 0;
+    if (source->textureCompressed!=0) {
+        textureCompressed = new uint8_t[CBc1Codec::getMipmapBytes(TEX_TERRAIN_SIZE)];
+        memcpy(textureCompressed, source->textureCompressed, CBc1Codec::getMipmapBytes(TEX_TERRAIN_SIZE));
+    }
+    uv = uvShared ? source->uv : new QVector2D[81];
+    heights = new quint16[TERRAIN_HEIGHTS_COUNT];
 
     // below data must be copy from source
     topLeftLon = source->topLeftLon;
@@ -86,6 +116,9 @@ CTerrainData::CTerrainData(CTerrainData *source)
     degreeSize = source->degreeSize;
     LOD = source->LOD;
     mustShowDistance = source->mustShowDistance;
+    heightStdDev = source->heightStdDev;
+    geometricError = source->geometricError;
+    childrenHeightRange = source->childrenHeightRange;
     hNW = source->hNW;
     hNE = source->hNE;
     hSW = source->hSW;
@@ -97,10 +130,11 @@ CTerrainData::CTerrainData(CTerrainData *source)
     for (i=0; i<81; i++) h[i] = source->h[i];
     for (i=0; i<81; i++) sphere[i] = source->sphere[i];
     for (i=0; i<81; i++) n[i] = source->n[i];
-    for (i=0; i<81; i++) c[i] = source->c[i];
-    for (i=0; i<3*32*32; i++) texture[i] = source->texture[i];
+    if (!colorsShared) for (i=0; i<81; i++) c[i] = source->c[i];
+    if (!textureShared) for (i=0; i<3*32*32; i++) texture[i] = source->texture[i];
     textureID = source->textureID;
-    for (i=0; i<81; i++) uv[i] = source->uv[i];
+    if (!uvShared) for (i=0; i<81; i++) uv[i] = source->uv[i];
+    for (i=0; i<TERRAIN_HEIGHTS_COUNT; i++) heights[i] = source->heights[i];
     topLeftPoint = source->topLeftPoint;
     topMiddlePoint = source->topMiddlePoint;
     topRightPoint = source->topRightPoint;
@@ -130,9 +164,11 @@ CTerrainData::~CTerrainData()
     delete []h;
     delete []sphere;
     delete []n;
-    delete []c;
-    delete []texture;
-    delete []uv;
+    if (!colorsShared) delete []c;
+    if (!textureShared) delete []texture;
+    delete []textureCompressed;
+    if (!uvShared) delete []uv;
+    delete []heights;
 }
 
 unsigned char *CTerrainData::getTexturePointer()
@@ -150,18 +186,131 @@ unsigned int CTerrainData::getTextureID()
     return (unsigned int)textureID;
 }
 
+int CTerrainData::getMemoryBytes() const
+{
+    int bytes;
+
+    // arrays shared with other terrains are counted once by CCacheManager
+    bytes = sizeof(CTerrainData);
+    bytes += 4*9*sizeof(QVector3D) + 3*81*sizeof(QVector3D);         // neighbor lines, points, sphere, normals
+    bytes += TERRAIN_HEIGHTS_COUNT*sizeof(quint16);
+    if (c!=0 && !colorsShared)    bytes += 81*sizeof(QColor);
+    if (uv!=0 && !uvShared)       bytes += 81*sizeof(QVector2D);
+    if (!textureShared)           bytes += 3*32*32;
+    if (textureCompressed!=0)     bytes += CBc1Codec::getMipmapBytes(TEX_TERRAIN_SIZE);
+
+    return bytes;
+}
+
+int CTerrainData::getPendingTextureBytes() const
+{
+    // texture is uploaded by OpenGL thread when terrain is drawn for the first time
+    if (textureID!=0 || textureShared)
+        return 0;
+
+    return 3*32*32 + (textureCompressed!=0 ? CBc1Codec::getMipmapBytes(TEX_TERRAIN_SIZE) : 0);
+}
+
+int CTerrainData::getVramBytes() const
+{
+    CCacheManager *cacheManager = CCacheManager::getInstance();
+    int bytes, size;
+
+    if (textureID==0 || textureShared)
+        return 0;
+
+    // estimate - driver may pad RGB texels
+    if (textureCompressed!=0 && cacheManager->textureCompressionSupport==1)
+        return CBc1Codec::getMipmapBytes(TEX_TERRAIN_SIZE);
+
+    bytes = 0;
+    for (size=TEX_TERRAIN_SIZE; size>=1; size/=2)
+        bytes += size*size*3;              // RGB mipmaps from gluBuild2DMipmaps
+
+    return bytes;
+}
+
 void CTerrainData::initTerrainData(double lon, double lat, int lod, const CDrawingStateSnapshot *dss)
 {
+    CTraceZone zone("CTerrainData::initTerrainData");
     CCacheManager *cacheManager = CCacheManager::getInstance();
-    double Palt, Px, Py, Pz;
+    CPerformance *performance = CPerformance::getInstance();
+    CCompactTerrainData *compact;
+    bool useDiskCache;
 
     degreeSize = cacheManager->LODdegreeSizeLookUp[lod];
     CCommons::findTopLeftCorner(lon, lat, degreeSize, &topLeftLon, &topLeftLat);
     mustShowDistance = ((degreeSize/8.0)/360.0) * CONST_EARTH_CIRCUMFERENCE;
     LOD = lod;
 
+    // terrain generated in previous run is read from tile disk cache
+    useDiskCache = !dss->dontUseCache && !dss->dontUseDiskHgt && !dss->dontUseDiskRaw;
+    if (useDiskCache) {
+        compact = cacheManager->tileDiskCache->load(topLeftLon, topLeftLat, LOD);
+        if (compact!=0) {
+            initTerrainData(compact);
+            delete compact;
+            performance->countTerrainDataInit(true);
+            return;
+        }
+    }
+
     // build terrain from scaled SRTM data
     getTerrainData(dss);
+    buildTerrainData();
+    setupCornerPoints();
+    performance->countTerrainDataInit(false);
+
+    if (useDiskCache) {
+        compact = new CCompactTerrainData(this);
+        cacheManager->tileDiskCache->store(compact);
+        delete compact;
+    }
+}
+
+void CTerrainData::initTerrainData(const CCompactTerrainData *compact)
+{
+    CCacheManager *cacheManager = CCacheManager::getInstance();
+    QByteArray textureBytes;
+    int i;
+
+    degreeSize = cacheManager->LODdegreeSizeLookUp[compact->LOD];
+    topLeftLon = compact->topLeftLon;
+    topLeftLat = compact->topLeftLat;
+    mustShowDistance = ((degreeSize/8.0)/360.0) * CONST_EARTH_CIRCUMFERENCE;
+    LOD = compact->LOD;
+
+    // source heights & texture kept in cache instead of reading HGT and RAW files again
+    for (i=0; i<TERRAIN_HEIGHTS_COUNT; i++)
+        heights[i] = compact->heights[i];
+    if (compact->texture.isEmpty()) {
+        delete []texture;
+        texture = cacheManager->emptyTexture;
+        textureShared = true;
+    } else {
+        textureBytes = qUncompress(compact->texture);
+        if (textureBytes.size()!=3*32*32)
+            qFatal("Compact terrain data - wrong texture size after uncompress");
+        memcpy(texture, textureBytes.constData(), 3*32*32);
+
+        // compressed texture is not kept in cache - tile is read again from memory mapped file
+        if (cacheManager->textureTiles->isCompressed()) {
+            textureCompressed = new uint8_t[CBc1Codec::getMipmapBytes(TEX_TERRAIN_SIZE)];
+            if (!cacheManager->getTextureTile(topLeftLon, topLeftLat, LOD, 0, textureCompressed)) {
+                delete []textureCompressed;
+                textureCompressed = 0;
+            }
+        }
+    }
+    childrenHeightRange = compact->childrenHeightRange;
+
+    buildTerrainData();
+    setupCornerPoints();
+}
+
+void CTerrainData::setupCornerPoints()
+{
+    double Palt, Px, Py, Pz;
 
     // get corners of terrain (-200m below sea level to avoid z-buffer errors)
     Palt = CONST_EARTH_RADIUS - 200.0;
@@ -269,6 +418,92 @@ void CTerrainData::getNeighborsTerrainData(int *pointNW, int *pointNE, int *poin
 }
 
 void CTerrainData::getTerrainData(const CDrawingStateSnapshot *dss)
+{
+    CCacheManager *cacheManager = CCacheManager::getInstance();
+    int *points = new int[81];
+    int pointNW, pointNE, pointSW, pointSE;
+    int *pointsN = new int[9];
+    int *pointsE = new int[9];
+    int *pointsS = new int[9];
+    int *pointsW = new int[9];
+    int heightMin, heightMax;
+    int colorMin[3], colorMax[3];
+    int i;
+
+    // pre-built compressed texture is uploaded to VRAM without decoding
+    if (!dss->dontUseDiskRaw && cacheManager->textureTiles->isCompressed() && textureCompressed==0)
+        textureCompressed = new uint8_t[CBc1Codec::getMipmapBytes(TEX_TERRAIN_SIZE)];
+
+    // get height data from cache manager
+    cacheManager->getTerrainPoints(topLeftLon, topLeftLat, LOD, points,
+                                   &pointNW, &pointNE, &pointSW, &pointSE,
+                                   pointsN, pointsE, pointsS, pointsW,
+                                   (unsigned char *)texture, (unsigned char *)textureCompressed,
+                                   dss->dontUseDiskHgt, dss->dontUseDiskRaw);
+
+    // terrain without RAW files - texture is shared with other terrains also in VRAM
+    if (memcmp(texture, cacheManager->emptyTexture, 3*32*32)==0) {
+        delete []texture;
+        delete []textureCompressed;
+        texture = cacheManager->emptyTexture;
+        textureCompressed = 0;
+        textureShared = true;
+    }
+
+    // SRTM data error marked as very hight altidute
+    for (i=0; i<81; i++)
+        if (points[i]>9000)
+            points[i] = 10;
+
+    // keep source heights - terrain is rebuilt from them after compacting in cache
+    for (i=0; i<81; i++)
+        heights[i] = (quint16)points[i];
+    heights[TERRAIN_HEIGHT_NW] = (quint16)pointNW;
+    heights[TERRAIN_HEIGHT_NE] = (quint16)pointNE;
+    heights[TERRAIN_HEIGHT_SW] = (quint16)pointSW;
+    heights[TERRAIN_HEIGHT_SE] = (quint16)pointSE;
+    for (i=0; i<9; i++) {
+        heights[TERRAIN_HEIGHTS_N + i] = (quint16)pointsN[i];
+        heights[TERRAIN_HEIGHTS_E + i] = (quint16)pointsE[i];
+        heights[TERRAIN_HEIGHTS_S + i] = (quint16)pointsS[i];
+        heights[TERRAIN_HEIGHTS_W + i] = (quint16)pointsW[i];
+    }
+
+    heightMin = points[0];
+    heightMax = points[0];
+    for (i=0; i<81; i++) {
+        if (points[i]<heightMin) heightMin = points[i];
+        if (points[i]>heightMax) heightMax = points[i];
+    }
+
+    // flat terrain with one color texture (ocean, missing data) - check that children wouldn't add any detail,
+    // above LOD 10 children use fragment of the same texture so only heights are checked
+    childrenHeightRange = -1;
+    if (!dss->dontUseDiskHgt && LOD<LOD_MAX && heightMax-heightMin<=TERRAIN_FLAT_HEIGHT_RANGE) {
+        for (i=0; i<3; i++) {
+            colorMin[i] = texture[i];
+            colorMax[i] = texture[i];
+        }
+        if (LOD<TEX_SOURCE_MAX_LOD) {
+            for (i=0; i<3*32*32; i++) {
+                if (texture[i]<colorMin[i%3]) colorMin[i%3] = texture[i];
+                if (texture[i]>colorMax[i%3]) colorMax[i%3] = texture[i];
+            }
+        }
+        if (colorMax[0]-colorMin[0]<=TERRAIN_FLAT_TEXTURE_COLOR_RANGE &&
+            colorMax[1]-colorMin[1]<=TERRAIN_FLAT_TEXTURE_COLOR_RANGE &&
+            colorMax[2]-colorMin[2]<=TERRAIN_FLAT_TEXTURE_COLOR_RANGE)
+            childrenHeightRange = cacheManager->getChildrenHeightRange(topLeftLon, topLeftLat, LOD);
+    }
+
+    delete []points;
+    delete []pointsN;
+    delete []pointsE;
+    delete []pointsS;
+    delete []pointsW;
+}
+
+void CTerrainData::buildTerrainData()
 {
     QVector3D *v, vSum, vN, vNE, vE, vSE, vS, vSW, vW, vNW;
     QVector3D vN_NE, vNE_E, vE_SE, vSE_S, vS_SW, vSW_W, vW_NW, vNW_N;
@@ -287,16 +522,48 @@ void CTerrainData::getTerrainData(const CDrawingStateSnapshot *dss)
     double Plon, Plat, Palt;
     double Px, Py, Pz;
     double hue, val;
+    double heightSum, heightSquareSum, heightMean;
+    bool seaLevel, seaLevelNeighbors;
     int r, g, b, a;
     int x, y;
     int i;
 
-    // get height data from cache manager
-    cacheManager->getTerrainPoints(topLeftLon, topLeftLat, LOD, points,
-                                   &pointNW, &pointNE, &pointSW, &pointSE,
-                                   pointsN, pointsE, pointsS, pointsW,
-                                   (unsigned char *)texture,
-                                   dss->dontUseDiskHgt, dss->dontUseDiskRaw);
+    // source heights of terrain & neighbors
+    for (i=0; i<81; i++)
+        points[i] = (int)heights[i];
+    pointNW = (int)heights[TERRAIN_HEIGHT_NW];
+    pointNE = (int)heights[TERRAIN_HEIGHT_NE];
+    pointSW = (int)heights[TERRAIN_HEIGHT_SW];
+    pointSE = (int)heights[TERRAIN_HEIGHT_SE];
+    for (i=0; i<9; i++) {
+        pointsN[i] = (int)heights[TERRAIN_HEIGHTS_N + i];
+        pointsE[i] = (int)heights[TERRAIN_HEIGHTS_E + i];
+        pointsS[i] = (int)heights[TERRAIN_HEIGHTS_S + i];
+        pointsW[i] = (int)heights[TERRAIN_HEIGHTS_W + i];
+    }
+
+    seaLevel = true;
+    for (i=0; i<81; i++)
+        if (points[i]!=0)
+            seaLevel = false;
+    seaLevelNeighbors = seaLevel && pointNW==0 && pointNE==0 && pointSW==0 && pointSE==0;
+    for (i=0; i<9; i++)
+        if (pointsN[i]!=0 || pointsE[i]!=0 || pointsS[i]!=0 || pointsW[i]!=0)
+            seaLevelNeighbors = false;
+
+    // uv up to LOD 10 and colors of terrain at sea level are the same for all terrains
+    if (LOD>TEX_SOURCE_MAX_LOD) {
+        uv = new QVector2D[81];
+    } else {
+        uv = cacheManager->terrainUv;
+        uvShared = true;
+    }
+    if (seaLevel) {
+        c = cacheManager->seaLevelColors;
+        colorsShared = true;
+    } else {
+        c = new QColor[81];
+    }
 
     // map points from Neighbors terrains for normal vectors
     getNeighborsTerrainData(&pointNW, &pointNE, &pointSW, &pointSE, pointsN, pointsE, pointsS, pointsW);
@@ -315,22 +582,20 @@ void CTerrainData::getTerrainData(const CDrawingStateSnapshot *dss)
 
 
     // map points to sphere & generate color
+    heightSum = 0.0;
+    heightSquareSum = 0.0;
     i = 0;
     for (y=0; y<9; y++)
         for (x=0; x<9; x++) {
 
-            // texture uv
-            if (LOD>TEX_SOURCE_MAX_LOD) {
+            // texture uv (fragment of LOD10 texture, (...)*0.973 + 0.0135 to avoid Qt texture border :/)
+            if (!uvShared) {
                 uv[i].setX( (lodMAXTEXoffsetLon + (((double)x)/8.0)*lodMAXTEXuvSize)*0.973 + 0.0135 );
                 uv[i].setY( (lodMAXTEXoffsetLat + (((double)y)/8.0)*lodMAXTEXuvSize)*0.973 + 0.0135 );
-            } else {
-                uv[i].setX( (((double)x)/8.0)*0.973 + 0.0135 );   // (...)*0.973 + 0.0135 to avoid Qt texture border :/
-                uv[i].setY( (((double)y)/8.0)*0.973 + 0.0135 );   // (...)*0.973 + 0.0135 to avoid Qt texture border :/
             }
 
-            // SRTM data error marked as very hight altidute
-            if (points[i]>9000)
-                points[i] = 10;
+            heightSum += (double)points[i];
+            heightSquareSum += (double)points[i] * (double)points[i];
 
             Plon = topLeftLon + ((double)x/8.0)*degreeSize;
             Plat = topLeftLat - ((double)y/8.0)*degreeSize;
@@ -349,9 +614,8 @@ void CTerrainData::getTerrainData(const CDrawingStateSnapshot *dss)
             sphere[i].setZ(Pz);
 
             if (points[i]==0) {
-                c[i].setRedF(0.2784);
-                c[i].setGreenF(0.6431);
-                c[i].setBlueF(0.7216);
+                if (!colorsShared)
+                    c[i] = cacheManager->seaLevelColors[i];
             } else {
                 val = 240.0;
                 hue = 170.0 - 170.0 * (((double)points[i])/1500.0);
@@ -375,12 +639,24 @@ void CTerrainData::getTerrainData(const CDrawingStateSnapshot *dss)
             i++;
         }
 
+    // terrain roughness & error of terrain approximation (used by screen space error LOD selection)
+    heightMean = heightSum / 81.0;
+    heightStdDev = heightSquareSum / 81.0 - heightMean*heightMean;
+    heightStdDev = (heightStdDev>0.0) ? sqrt(heightStdDev) : 0.0;
+    geometricError = mustShowDistance + TERRAIN_ROUGHNESS_ERROR_WEIGHT * heightStdDev;
+
     // setup normal vectors
     for (y=0; y<9; y++)
         for (x=0; x<9; x++) {
 
             v = getHeight(x, y);
 
+            // flat terrain at sea level - normal vector is vertical
+            if (seaLevelNeighbors) {
+                (*getNormal(x, y)) = v->normalized();
+                continue;
+            }
+
             if (x==0 || y==0)
                 getNeighborVector(v, x-1, y-1, &vNW); else
                 vNW = (*getHeight(x-1, y-1)) - (*v);
@@ -954,13 +1230,36 @@ void CTerrainData::drawBottomPlaneTexture(const int &xStart, const int &yStart)
 
 void CTerrainData::bindTexture(CTerrainData *terrainData)
 {
+    CTraceZone zone("CTerrainData::bindTexture");
+    CCacheManager *cacheManager = CCacheManager::getInstance();
     GLfloat color[4] = { 0.0, 0.0, 0.0, 0.0 };
     bool wrap = false;
     GLuint textureID;
     unsigned char *textureData;
+    PFNCOMPRESSEDTEXIMAGE2D compressedTexImage2D;
+    QString extensions;
+    int level, size;
 
     textureData = terrainData->getTexturePointer();
 
+    // shared texture is already in VRAM
+    if (terrainData->textureShared && cacheManager->emptyTextureID!=0) {
+        terrainData->setTextureID(cacheManager->emptyTextureID);
+        return;
+    }
+
+    // S3TC support is checked once - OpenGL context is current only in this thread
+    if (terrainData->textureCompressed!=0 && cacheManager->textureCompressionSupport==-1) {
+        extensions = QString((const char *)glGetString(GL_EXTENSIONS));
+        if (extensions.contains("GL_EXT_texture_compression_s3tc")) {
+            cacheManager->compressedTexImage2D = QGLContext::currentContext()->getProcAddress("glCompressedTexImage2D");
+            if (cacheManager->compressedTexImage2D==0)
+                cacheManager->compressedTexImage2D = QGLContext::currentContext()->getProcAddress("glCompressedTexImage2DARB");
+        }
+        cacheManager->textureCompressionSupport = (cacheManager->compressedTexImage2D!=0) ? 1 : 0;
+        qDebug("BC1 texture upload %s", cacheManager->textureCompressionSupport ? "enabled" : "not supported - using RGB textures");
+    }
+
     // uploading texture to VRAM
     // very nice tutorial here http://www.nullterminator.net/gltexture.html :)
     glGenTextures( 1, &textureID );
@@ -971,7 +1270,17 @@ void CTerrainData::bindTexture(CTerrainData *terrainData)
     glTexParameterf( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap ? GL_REPEAT : GL_CLAMP ); // no GL_CLAMP_TO_BORDER_EXT in Qt :/
     glTexParameterf( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap ? GL_REPEAT : GL_CLAMP ); // no GL_CLAMP_TO_BORDER_EXT in Qt :/
     glTexParameterfv( GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, color );
-    gluBuild2DMipmaps( GL_TEXTURE_2D, 3, TEX_TERRAIN_SIZE, TEX_TERRAIN_SIZE, GL_RGB, GL_UNSIGNED_BYTE, textureData );
+    if (terrainData->textureCompressed!=0 && cacheManager->textureCompressionSupport==1) {
+        // pre-built BC1 texture has all mipmap levels - uploaded as it is
+        compressedTexImage2D = (PFNCOMPRESSEDTEXIMAGE2D)cacheManager->compressedTexImage2D;
+        textureData = terrainData->textureCompressed;
+        for (level=0, size=TEX_TERRAIN_SIZE; size>=1; level++, size/=2) {
+            compressedTexImage2D( GL_TEXTURE_2D, level, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, size, size, 0, CBc1Codec::getImageBytes(size), textureData );
+            textureData += CBc1Codec::getImageBytes(size);
+        }
+    } else {
+        gluBuild2DMipmaps( GL_TEXTURE_2D, 3, TEX_TERRAIN_SIZE, TEX_TERRAIN_SIZE, GL_RGB, GL_UNSIGNED_BYTE, textureData );
+    }
 
     // below sample from http://glprogramming.com/red/chapter09.html without mipmaping
     /*
@@ -982,5 +1291,7 @@ void CTerrainData::bindTexture(CTerrainData *terrainData)
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, TEX_TERRAIN_SIZE, TEX_TERRAIN_SIZE, 0, GL_RGB, GL_UNSIGNED_BYTE, textureData);
     */
 
+    if (terrainData->textureShared)
+        cacheManager->emptyTextureID = textureID;
     terrainData->setTextureID(textureID);
 }
@@ -49,19 +49,36 @@
 #include <QtOpenGL>
 #include "CDrawingStateSnapshot.h"
 
+#define TERRAIN_ROUGHNESS_ERROR_WEIGHT   1.0
+#define TERRAIN_FLAT_HEIGHT_RANGE          3      // max height difference + chord sag in meters of terrain that is never split
+#define TERRAIN_FLAT_TEXTURE_COLOR_RANGE   6      // max color channel difference of texture that is never split
+#define TERRAIN_HEIGHTS_COUNT            121      // source heights: 9x9 terrain points, 4 neighbor corners, 4 neighbor lines
+#define TERRAIN_HEIGHT_NW                 81
+#define TERRAIN_HEIGHT_NE                 82
+#define TERRAIN_HEIGHT_SW                 83
+#define TERRAIN_HEIGHT_SE                 84
+#define TERRAIN_HEIGHTS_N                 85
+#define TERRAIN_HEIGHTS_E                 94
+#define TERRAIN_HEIGHTS_S                103
+#define TERRAIN_HEIGHTS_W                112
+
+class CCompactTerrainData;
+
 class CTerrainData
 {
 public:
     CTerrainData();
     CTerrainData(CTerrainData *source);
     ~CTerrainData();
-    friend class CTerrain;          // for full access from CTerrain class
+    friend class CTerrain;              // for full access from CTerrain class
+    friend class CCompactTerrainData;   // for packing terrain data in cache
 
     double topLeftLon;   // top left is general to localize terrain on Earth
     double topLeftLat;   // top left is general to localize terrain on Earth
     int LOD;             // LevelOfDetails is general to localize terrain on Earth
 
     void initTerrainData(double lon, double lat, int lod, const CDrawingStateSnapshot *dss);
+    void initTerrainData(const CCompactTerrainData *compact);
     void drawPoint(const int &xStart, const int &xStop, const int &yStart, const int &yStop, const CDrawingStateSnapshot *dss);
     void drawWire(const int &xStart, const int &xStop, const int &yStart, const int &yStop, const CDrawingStateSnapshot *dss);
     void drawNormals(const int &xStart, const int &xStop, const int &yStart, const int &yStop, const CDrawingStateSnapshot *dss);
@@ -75,10 +92,17 @@ public:
     unsigned char *getTexturePointer();
     void setTextureID(GLuint texID);
     unsigned int getTextureID();
+    int getMemoryBytes() const;
+    int getPendingTextureBytes() const;
+    int getVramBytes() const;
 
 private:
     double mustShowDistance;    // when camera is closer that this value tile must be show
     double degreeSize;
+    double heightStdDev;        // standard deviation of terrain heights in meters
+    double geometricError;      // world space error of tile (sample spacing + roughness) for screen space error LOD
+    int childrenHeightRange;    // height range of source data under children, -1 when children may add any detail
+    quint16 *heights;           // source heights (TERRAIN_HEIGHTS_COUNT) - whole terrain can be rebuilt from them
     QVector3D hNW;              // point in NW neighbor
     QVector3D hNE;              // point in NE neighbor
     QVector3D hSW;              // point in SW neighbor
@@ -92,8 +116,12 @@ private:
     QVector3D *n;               // terrain data normals
     QColor *c;                  // color data
     uint8_t *texture;           // texture data
+    uint8_t *textureCompressed; // BC1 texture with mipmaps from CTextureTiles, 0 when texture is uploaded uncompressed
     GLuint textureID;           // OpenGL texture ID
     QVector2D *uv;              // texture coordinate
+    bool textureShared;         // texture & textureID are shared with other terrains (CCacheManager::emptyTexture)
+    bool colorsShared;          // c is shared with other terrains (CCacheManager::seaLevelColors)
+    bool uvShared;              // uv is shared with other terrains (CCacheManager::terrainUv)
     QVector3D topLeftPoint;
     QVector3D topMiddlePoint;
     QVector3D topRightPoint;
@@ -115,6 +143,8 @@ private:
 
     void bindTexture(CTerrainData *terrainData);
     void getTerrainData(const CDrawingStateSnapshot *dss);
+    void buildTerrainData();
+    void setupCornerPoints();
     QVector3D *getHeight(int x, int y) { return &h[y*9+x]; }                   // inline func
     QVector3D *getNormal(int x, int y) { return &n[y*9+x]; }                   // inline func
     QVector2D *getUv(int x, int y) { return &uv[y*9+x]; }                      // inline func
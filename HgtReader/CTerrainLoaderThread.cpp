@@ -42,6 +42,7 @@
 
 #include <QDebug>
 #include "CTerrainLoaderThread.h"
+#include "CTraceZone.h"
 
 
 CTerrainLoaderThread::CTerrainLoaderThread(COpenGl *openGlPointer) : QThread(openGlPointer), openGl(openGlPointer)
@@ -77,13 +78,22 @@ void CTerrainLoaderThread::run()
 {
     int cachedTDCount, cachedTDInUseCount, cachedTDNotInUseCount, cachedTDEmptyEntryCount;
     unsigned int cacheMinNotInUseTime;
+    CMemoryCounters memory;
+    bool treeUpdated, treeComplete;
+    bool lastExchangedTreeComplete;
 
+    lastExchangedTreeComplete = false;          // nothing was exchanged yet
+
+    CTraceZone::setThreadName("terrain loader");
+    dssTimeNs = openGl->performance.getTimeNs();
     openGl->drawingState.getDrawingStateSnapshot(&dss);      // get current scene state
 
     while (true) {
         time.start();
 
-        if (dss.treeUpdating)  earth->updateTerrainTree();
+        treeUpdated = false;
+        if (dss.treeUpdating)  treeUpdated = earth->updateTerrainTree();
+        treeComplete = (!treeUpdated || earth->splitsPostponed==0) ? true : false;
 
         doMutex.lock();
         if (doClearCache) {
@@ -96,22 +106,51 @@ void CTerrainLoaderThread::run()
         }
         doMutex.unlock();
 
+        // camera is still - there is nothing new for drawing thread so don't spin,
+        // with tree updating switched off buffers are still exchanged & cache is trimmed,
+        // drawing thread's tree with postponed splits is replaced by this complete one first
+        if (dss.treeUpdating && !treeUpdated && lastExchangedTreeComplete) {
+            // drawing thread shows complete tree which still fits camera state from snapshot
+            openGl->performance.setConvergenceTreeReady(dssTimeNs);
+            msleep(TREE_UPDATING_IDLE_SLEEP_MS);
+            dssTimeNs = openGl->performance.getTimeNs();
+            openGl->drawingState.getDrawingStateSnapshot(&dss);  // get current scene state
+            openGl->performance.setTerrainTreeUpdatingIdle();
+            openGl->performance.updateTerrainTreeUpdatingInfo();
+            continue;
+        }
+
         openGl->cacheManager.cacheInfo(&cachedTDCount, &cachedTDInUseCount, &cachedTDNotInUseCount, &cachedTDEmptyEntryCount, &cacheMinNotInUseTime);
         openGl->cacheManager.cacheKeepSize(earth);
         openGl->cacheManager.cacheInfo(&cachedTDCount, &cachedTDInUseCount, &cachedTDNotInUseCount, &cachedTDEmptyEntryCount, &cacheMinNotInUseTime);
-        emit SIGNALupdateCacheInfo(cachedTDCount, cachedTDInUseCount, cachedTDNotInUseCount, cachedTDEmptyEntryCount, cacheMinNotInUseTime);
-
+        openGl->cacheManager.memoryInfo(&memory);
+        emit SIGNALupdateCacheInfo(cachedTDCount, cachedTDInUseCount, cachedTDNotInUseCount, cachedTDEmptyEntryCount, cacheMinNotInUseTime,
+                                   memory.quadtreeBytes/1048576.0, memory.terrainDataBytes/1048576.0, memory.pendingTextureBytes/1048576.0,
+                                   memory.vramBytes/1048576.0, memory.tablesBytes/1048576.0, memory.performanceHistoryBytes/1048576.0);
+        openGl->cacheManager.ioStats->updateIoInfo();
+
+
+        // wait until drawing thread takes new earth
+        {
+            CTraceZone zone("earth buffer swap wait");
+            openGl->earthBufferMutex.lock();
+            openGl->earthBufferReadyToExchange = true;
+            openGl->earthBufferExchange.wait(&openGl->earthBufferMutex);
+            earth->setDrawingStateSnapshot(&dss);
+            openGl->earthBufferMutex.unlock();
+        }
+        lastExchangedTreeComplete = treeComplete;
 
-        openGl->earthBufferMutex.lock();
-        openGl->earthBufferReadyToExchange = true;
-        openGl->earthBufferExchange.wait(&openGl->earthBufferMutex);
-        earth->setDrawingStateSnapshot(&dss);
-        openGl->earthBufferMutex.unlock();
+        // drawing thread has tree with full detail for camera state from snapshot,
+        // tree with postponed splits isn't converged even if camera is still
+        if (lastExchangedTreeComplete)
+            openGl->performance.setConvergenceTreeReady(dssTimeNs);
 
+        dssTimeNs = openGl->performance.getTimeNs();
         openGl->drawingState.getDrawingStateSnapshot(&dss);  // get current scene state
 
         // update performance info
-        openGl->performance.setTerrainTreeUpdatingTime(time.elapsed());
+        openGl->performance.setTerrainTreeUpdatingTime(time.nsecsElapsed());
         openGl->performance.updateTerrainTreeUpdatingInfo();
     }
 }
@@ -44,8 +44,11 @@
 #define CTERRAINLOADERTHREAD_H
 
 #include <QThread>
+#include <QElapsedTimer>
 #include "COpenGl.h"
 
+#define TREE_UPDATING_IDLE_SLEEP_MS     10
+
 class COpenGl;
 
 class CTerrainLoaderThread : public QThread
@@ -54,7 +57,9 @@ class CTerrainLoaderThread : public QThread
 
 Q_SIGNALS:
     void SIGNALupdateCacheInfo(int cachedTDCount, int cachedTDInUseCount, int cachedTDNotInUseCount,
-                               int cachedTDEmptyEntryCount, unsigned int cacheMinNotInUseTime);
+                               int cachedTDEmptyEntryCount, unsigned int cacheMinNotInUseTime,
+                               double quadtreeMB, double terrainDataMB, double pendingTextureMB,
+                               double vramMB, double tablesMB, double performanceHistoryMB);
 
 public:
     CTerrainLoaderThread(COpenGl *openGl);
@@ -70,8 +75,9 @@ protected:
 
 private:
     COpenGl *openGl;
-    QTime time;
+    QElapsedTimer time;
     CDrawingStateSnapshot dss;
+    qint64 dssTimeNs;                       // when dss was taken
     QMutex doMutex;
     bool doTerminate;
     bool doClearCache;
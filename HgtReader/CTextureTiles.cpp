@@ -0,0 +1,116 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QDataStream>
+#include "CTextureTiles.h"
+#include "CTerrainContainer.h"
+#include "CBc1Codec.h"
+
+CTextureTiles::CTextureTiles()
+{
+    lastModified = 0;
+    format = TEXTURE_TILES_FORMAT_RGB;
+    tileBytes = 0;
+}
+
+quint64 CTextureTiles::getTileKey(int lod, int x, int y)
+{
+    // same Z-order key as chunks of CTerrainContainer, LOD in highest bits
+    return CTerrainContainer::getChunkKey(lod, x, y);
+}
+
+int CTextureTiles::getTileBytes(int format, int tileSize)
+{
+    if (format==TEXTURE_TILES_FORMAT_BC1)
+        return CBc1Codec::getMipmapBytes(tileSize);
+
+    return 3*tileSize*tileSize;
+}
+
+bool CTextureTiles::open(const QString &fileName, int tileSize)
+{
+    QDataStream *stream;
+    quint32 magic, version, size, fileFormat;
+    quint64 indexOffset, tileCount;
+
+    if (!indexedFile.open(fileName))
+        return false;
+    stream = indexedFile.getStream();
+
+    (*stream) >> magic >> version >> size >> fileFormat;
+    if (magic!=TEXTURE_TILES_MAGIC || version!=TEXTURE_TILES_VERSION || (int)size!=tileSize ||
+        (fileFormat!=TEXTURE_TILES_FORMAT_RGB && fileFormat!=TEXTURE_TILES_FORMAT_BC1)) {
+        qWarning("Texture tiles - unknown format of %s", qPrintable(fileName));
+        indexedFile.close();
+        return false;
+    }
+    (*stream) >> indexOffset >> tileCount;
+    format = fileFormat;
+    tileBytes = getTileBytes(format, tileSize);
+
+    // all tiles have the same size - it isn't stored in index
+    if (!indexedFile.readIndex(TEXTURE_TILES_HEADER_SIZE, indexOffset, tileCount, TEXTURE_TILES_INDEX_RECORD, tileBytes, 0)) {
+        qWarning("Texture tiles - index of %s is corrupted", qPrintable(fileName));
+        indexedFile.close();
+        return false;
+    }
+    lastModified = indexedFile.lastModified;
+
+    return true;
+}
+
+bool CTextureTiles::readTile(int lod, int x, int y, QByteArray *bytes, CIoCounters *io)
+{
+    quint32 flags;
+
+    if (!indexedFile.read(getTileKey(lod, x, y), bytes, &flags, io))
+        return false;                       // no RAW file under terrain
+
+    // short read - texture is built like without tiles file
+    if (bytes->size()!=tileBytes) {
+        qWarning("Texture tiles - tile %d %d of LOD %d is corrupted", x, y, lod);
+        bytes->clear();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,86 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CTEXTURETILES_H
+#define CTEXTURETILES_H
+
+#include <QString>
+#include "CIoCounters.h"
+#include "CIndexedFile.h"
+
+#define TEXTURE_TILES_FILE              "textures.hgtx" // pre-built texture of each terrain up to TEXTURE_TILES_MAX_LOD
+#define TEXTURE_TILES_MAGIC             0x48475458      // "HGTX"
+#define TEXTURE_TILES_VERSION           1
+#define TEXTURE_TILES_HEADER_SIZE       32              // magic, version, tile size, format, index offset, tiles count
+#define TEXTURE_TILES_INDEX_RECORD      INDEXED_FILE_RECORD_FIXED   // key & offset of one tile
+#define TEXTURE_TILES_MAX_LOD           10              // same as TEX_SOURCE_MAX_LOD - above it terrains use fragment of LOD 10 texture
+#define TEXTURE_TILES_FORMAT_RGB        0               // 3*size*size bytes like texture of CTerrainData
+#define TEXTURE_TILES_FORMAT_BC1        1               // CBc1Codec blocks of all mipmap levels
+
+// texture of each terrain resampled from RAW files by HgtPyramidBuilder - one tile
+// per terrain up to TEXTURE_TILES_MAX_LOD, all tiles have the same size in bytes,
+// tiles are stored in Z-order of each LOD, tiles without any RAW file are not stored
+//
+// layout: header, tiles, index sorted by tile key
+class CTextureTiles
+{
+public:
+    CTextureTiles();
+
+    unsigned int lastModified;
+
+    bool open(const QString &fileName, int tileSize);
+    bool isOpen() { return indexedFile.isOpen(); }
+    bool isCompressed() { return format==TEXTURE_TILES_FORMAT_BC1; }
+    int getTileBytes() { return tileBytes; }
+    bool readTile(int lod, int x, int y, QByteArray *bytes, CIoCounters *io);
+
+    static quint64 getTileKey(int lod, int x, int y);
+    static int getTileBytes(int format, int tileSize);
+
+private:
+    CIndexedFile indexedFile;
+    int format;
+    int tileBytes;
+};
+
+#endif // CTEXTURETILES_H
@@ -0,0 +1,318 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QDir>
+#include <QDebug>
+#include <QDataStream>
+#include <QTextStream>
+#include <QStringList>
+#include <QMutexLocker>
+#include "CTileDiskCache.h"
+#include "CCacheManager.h"
+
+CTileDiskCache::CTileDiskCache(const QString &path)
+{
+    QDir dir;
+
+    dataMap = 0;
+    dataMapSize = 0;
+    ready = false;
+
+    dir.mkpath(path);
+    dataFile.setFileName(path + TILE_DISK_CACHE_DATA_FILE);
+    indexFile.setFileName(path + TILE_DISK_CACHE_INDEX_FILE);
+    if (!dataFile.open(QIODevice::ReadWrite) || !indexFile.open(QIODevice::ReadWrite)) {
+        qDebug("Tile disk cache - can't open files, disk cache disabled");
+        return;
+    }
+
+    // records of other format version would be served as if they were valid
+    if (!checkHeader(&dataFile) || !checkHeader(&indexFile)) {
+        if (dataFile.size()>0 || indexFile.size()>0)
+            qDebug("Tile disk cache - format of cache changed, cached terrains discarded");
+        dataFile.resize(0);
+        indexFile.resize(0);
+        writeHeader(&dataFile);
+        writeHeader(&indexFile);
+    }
+
+    readIndex();
+    invalidateAreas(path + TILE_DISK_CACHE_INVALIDATE_FILE);
+
+    // records stored in previous runs are read from memory
+    dataMapSize = dataFile.size();
+    if (dataMapSize>0)
+        dataMap = dataFile.map(0, dataMapSize);
+    if (dataMap==0)
+        dataMapSize = 0;
+
+    ready = true;
+}
+
+CTileDiskCache::~CTileDiskCache()
+{
+    if (dataMap!=0)
+        dataFile.unmap(dataMap);
+    dataFile.close();
+    indexFile.close();
+}
+
+quint64 CTileDiskCache::getKey(const double &tlLon, const double &tlLat, const int &lod)
+{
+    CCacheManager *cacheManager = CCacheManager::getInstance();
+    double degreeSize = cacheManager->LODdegreeSizeLookUp[lod];
+    quint64 x, y;
+
+    // position of terrain in LOD grid
+    x = (quint64)(tlLon/degreeSize + 0.5);
+    y = (quint64)((90.0 - tlLat)/degreeSize + 0.5);
+
+    return (((quint64)lod) << 48) | (x << 24) | y;
+}
+
+bool CTileDiskCache::checkHeader(QFile *file)
+{
+    QDataStream stream(file);
+    quint32 magic, version;
+
+    file->seek(0);
+    stream >> magic >> version;
+
+    return (stream.status()==QDataStream::Ok && magic==TILE_DISK_CACHE_MAGIC && version==TILE_DISK_CACHE_VERSION) ? true : false;
+}
+
+void CTileDiskCache::writeHeader(QFile *file)
+{
+    QDataStream stream(file);
+
+    file->seek(0);
+    stream << (quint32)TILE_DISK_CACHE_MAGIC << (quint32)TILE_DISK_CACHE_VERSION;
+    file->flush();
+}
+
+void CTileDiskCache::readIndex()
+{
+    QDataStream stream(&indexFile);
+    CTileDiskCacheEntry entry;
+    quint64 key;
+    qint64 records, i;
+
+    // newer record of the same terrain replaces older one
+    records = (indexFile.size() - TILE_DISK_CACHE_HEADER_SIZE) / TILE_DISK_CACHE_INDEX_RECORD;
+    indexFile.seek(TILE_DISK_CACHE_HEADER_SIZE);
+    for (i=0; i<records; i++) {
+        stream >> key >> entry.stamp >> entry.offset >> entry.size >> entry.checksum;
+        if (entry.offset + entry.size > dataFile.size())
+            break;                                  // record not written completely
+        if (entry.offset<TILE_DISK_CACHE_HEADER_SIZE || entry.size<0)
+            break;                                  // damaged index
+        index.insert(key, entry);
+    }
+
+    // next records are appended after last complete one
+    indexFile.resize(TILE_DISK_CACHE_HEADER_SIZE + i*TILE_DISK_CACHE_INDEX_RECORD);
+    indexFile.seek(TILE_DISK_CACHE_HEADER_SIZE + i*TILE_DISK_CACHE_INDEX_RECORD);
+}
+
+void CTileDiskCache::invalidateAreas(const QString &fileName)
+{
+    CCacheManager *cacheManager = CCacheManager::getInstance();
+    QFile file(fileName);
+    QTextStream stream(&file);
+    QHash<quint64, CTileDiskCacheEntry>::iterator i;
+    QList<double> areas;
+    QStringList fields;
+    double lonMin, latMin, lonMax, latMax, shift;
+    double degreeSize;
+    int j, k, lod, removed;
+    bool inArea;
+
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    while (!stream.atEnd()) {
+        fields = stream.readLine().split(' ');
+        if (fields.size()!=4)
+            continue;
+        for (j=0; j<4; j++)
+            areas.append(fields.at(j).toDouble());
+    }
+    file.close();
+
+    // terrain depends on HGT files of its neighbors too - one terrain size is added around
+    removed = 0;
+    i = index.begin();
+    while (i!=index.end()) {
+        lod = (int)(i.key() >> 48);
+        degreeSize = cacheManager->LODdegreeSizeLookUp[lod];
+        lonMin = ((i.key() >> 24) & 0xFFFFFF) * degreeSize - degreeSize;
+        lonMax = lonMin + 3.0*degreeSize;
+        latMax = 90.0 - (i.key() & 0xFFFFFF) * degreeSize + degreeSize;
+        latMin = latMax - 3.0*degreeSize;
+
+        inArea = false;
+        for (j=0; j<areas.size() && !inArea; j+=4)
+            for (k=-1; k<=1; k++) {
+                shift = k * 360.0;
+                if (lonMin < areas.at(j+2) + shift && lonMax > areas.at(j) + shift &&
+                    latMin < areas.at(j+3) && latMax > areas.at(j+1))
+                    inArea = true;
+            }
+
+        if (inArea) {
+            i = index.erase(i);
+            removed++;
+        } else {
+            ++i;
+        }
+    }
+
+    // index file without removed records replaces old one, data file is not compacted
+    writeIndex();
+    file.remove();
+    qDebug("Tile disk cache - %d terrains invalidated by pyramid rebuild", removed);
+}
+
+void CTileDiskCache::writeIndex()
+{
+    QDataStream stream(&indexFile);
+    QHash<quint64, CTileDiskCacheEntry>::const_iterator i;
+
+    indexFile.resize(0);
+    writeHeader(&indexFile);
+    for (i=index.constBegin(); i!=index.constEnd(); ++i)
+        stream << i.key() << i.value().stamp << i.value().offset << i.value().size << i.value().checksum;
+    indexFile.flush();
+}
+
+CCompactTerrainData *CTileDiskCache::load(const double &tlLon, const double &tlLat, const int &lod)
+{
+    CCacheManager *cacheManager = CCacheManager::getInstance();
+    CCompactTerrainData *compact;
+    CTileDiskCacheEntry entry;
+    QByteArray record;
+    quint64 key;
+    unsigned int stamp;
+
+    if (!ready)
+        return 0;
+
+    key = getKey(tlLon, tlLat, lod);
+    stamp = cacheManager->getSourceStamp(tlLon, tlLat, lod);
+
+    QMutexLocker locker(&mutex);
+
+    if (!index.contains(key))
+        return 0;
+    entry = index.value(key);
+
+    // source files changed since terrain was generated
+    if (entry.stamp!=stamp)
+        return 0;
+
+    if (entry.offset + entry.size <= dataMapSize) {
+        record = QByteArray::fromRawData((const char *)(dataMap + entry.offset), entry.size);
+    } else {
+        dataFile.seek(entry.offset);
+        record = dataFile.read(entry.size);
+    }
+
+    // damaged record is generated again - it must never reach CTerrainData::initTerrainData
+    QDataStream stream(record);
+    compact = new CCompactTerrainData();
+    if (record.size()!=entry.size || qChecksum(record.constData(), record.size())!=entry.checksum ||
+        !compact->load(stream) || !checkRecord(compact, key, lod)) {
+        qDebug("Tile disk cache - corrupted record");
+        delete compact;
+        return 0;
+    }
+
+    return compact;
+}
+
+bool CTileDiskCache::checkRecord(const CCompactTerrainData *compact, quint64 key, int lod)
+{
+    const uchar *data;
+
+    if (compact->LOD!=lod || getKey(compact->topLeftLon, compact->topLeftLat, compact->LOD)!=key ||
+        compact->childrenHeightRange<-1)
+        return false;
+
+    // qCompress stores uncompressed size in first 4 bytes (big endian)
+    if (compact->texture.isEmpty())
+        return true;
+    if (compact->texture.size()<4)
+        return false;
+    data = (const uchar *)compact->texture.constData();
+
+    return (((data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3])==3*32*32) ? true : false;
+}
+
+void CTileDiskCache::store(const CCompactTerrainData *compact)
+{
+    CCacheManager *cacheManager = CCacheManager::getInstance();
+    CTileDiskCacheEntry entry;
+    QByteArray record;
+    QDataStream recordStream(&record, QIODevice::WriteOnly);
+    QDataStream indexStream(&indexFile);
+    quint64 key;
+
+    if (!ready)
+        return;
+
+    key = getKey(compact->topLeftLon, compact->topLeftLat, compact->LOD);
+    entry.stamp = cacheManager->getSourceStamp(compact->topLeftLon, compact->topLeftLat, compact->LOD);
+    compact->save(recordStream);
+    entry.checksum = qChecksum(record.constData(), record.size());
+
+    QMutexLocker locker(&mutex);
+
+    // data record first - index record points only to complete data
+    entry.offset = dataFile.size();
+    entry.size = record.size();
+    dataFile.seek(entry.offset);
+    if (dataFile.write(record)!=record.size())
+        return;
+    dataFile.flush();
+
+    indexStream << key << entry.stamp << entry.offset << entry.size << entry.checksum;
+    index.insert(key, entry);
+}
@@ -0,0 +1,97 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CTILEDISKCACHE_H
+#define CTILEDISKCACHE_H
+
+#include <QString>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include "CCompactTerrainData.h"
+
+#define TILE_DISK_CACHE_DATA_FILE     "tiles.dat"     // compact terrain data records, only appended
+#define TILE_DISK_CACHE_INDEX_FILE    "tiles.idx"     // key, stamp, offset & size of each record, only appended
+#define TILE_DISK_CACHE_INVALIDATE_FILE "tiles.inv"   // areas rebuilt by HgtPyramidBuilder, one "lonMin latMin lonMax latMax" per line
+#define TILE_DISK_CACHE_INDEX_RECORD   28             // bytes of one index record
+#define TILE_DISK_CACHE_MAGIC          0x48544443     // "HTDC"
+#define TILE_DISK_CACHE_VERSION        3              // increased when meaning of record changes - older cache is discarded
+#define TILE_DISK_CACHE_HEADER_SIZE    8              // magic & version at start of both files
+
+class CTileDiskCacheEntry
+{
+public:
+    quint32 stamp;              // newest modification time of source files used by terrain
+    qint64 offset;
+    qint32 size;
+    quint32 checksum;           // qChecksum of data record
+};
+
+// generated terrains stored on disk between runs - below cache in memory
+class CTileDiskCache
+{
+public:
+    CTileDiskCache(const QString &path);
+    ~CTileDiskCache();
+
+    CCompactTerrainData *load(const double &tlLon, const double &tlLat, const int &lod);
+    void store(const CCompactTerrainData *compact);
+
+private:
+    QMutex mutex;
+    QFile dataFile;
+    QFile indexFile;
+    uchar *dataMap;             // data file mapped to memory when cache was opened
+    qint64 dataMapSize;
+    QHash<quint64, CTileDiskCacheEntry> index;
+    bool ready;
+
+    quint64 getKey(const double &tlLon, const double &tlLat, const int &lod);
+    bool checkHeader(QFile *file);
+    bool checkRecord(const CCompactTerrainData *compact, quint64 key, int lod);
+    void writeHeader(QFile *file);
+    void readIndex();
+    void invalidateAreas(const QString &fileName);
+    void writeIndex();
+};
+
+#endif // CTILEDISKCACHE_H
@@ -0,0 +1,91 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CTILEFILENAME_H
+#define CTILEFILENAME_H
+
+#include <QString>
+
+// name of HGT & RAW files of every level, for example N50,63_E016,88.hgt - top left corner
+// of file with longitude 0-360 - header only so tools don't need CCommons & CCacheManager
+class CTileFileName
+{
+public:
+    static QString getBaseName(double lon, double lat)
+    {
+        double tmpLon, tmpLat;
+        QChar fnLonSide, fnLatSide;
+        QString fnLon, fnLat, name;
+
+        if (lon>=180.0) {
+            tmpLon = 360.0 - lon;
+            fnLonSide = 'W';
+        } else {
+            tmpLon = lon;
+            fnLonSide = 'E';
+        }
+
+        if (lat>=0.0) {
+            tmpLat = lat;
+            fnLatSide = 'N';
+        } else {
+            tmpLat = -1.0 * lat;
+            fnLatSide = 'S';
+        }
+
+        fnLon = QString::number(tmpLon, 'f', 2).rightJustified(6, QChar('0'));
+        fnLat = QString::number(tmpLat, 'f', 2).rightJustified(5, QChar('0'));
+
+        name = fnLatSide + fnLat + '_' + fnLonSide + fnLon;
+        name[3] = ',';
+        name[11] = ',';
+
+        return name;
+    }
+
+    static QString getName(double lon, double lat, const QString &suffix)
+    {
+        return getBaseName(lon, lat) + "." + suffix;
+    }
+};
+
+#endif // CTILEFILENAME_H
@@ -0,0 +1,172 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QMutexLocker>
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+#include "CTraceZone.h"
+
+volatile bool CTraceZone::enabled = false;
+QElapsedTimer CTraceZone::clock;
+QMutex CTraceZone::registryMutex;
+QList<CTraceThreadBuffer *> CTraceZone::buffers;
+QList<CTraceThreadBuffer *> CTraceZone::freeBuffers;
+QMap<int, QString> CTraceZone::threadNames;
+int CTraceZone::lastThreadId = 0;
+QThreadStorage<CTraceThreadSlot *> *CTraceZone::threadSlots = 0;
+
+CTraceThreadBuffer::CTraceThreadBuffer() : events(TRACE_RING_SIZE)
+{
+    id = 0;
+}
+
+CTraceThreadSlot::~CTraceThreadSlot()
+{
+    CTraceZone::releaseThreadBuffer(buffer);
+}
+
+void CTraceZone::setEnabled(bool enable)
+{
+    QMutexLocker locker(&registryMutex);
+
+    // thread storage and clock must exist before first zone sees enabled flag
+    if (threadSlots==0)
+        threadSlots = new QThreadStorage<CTraceThreadSlot *>;
+    if (!clock.isValid())
+        clock.start();
+    enabled = enable;
+}
+
+void CTraceZone::setThreadName(const QString &threadName)
+{
+    CTraceThreadBuffer *buffer;
+
+    if (!enabled)
+        return;
+
+    buffer = getThreadBuffer();
+    QMutexLocker locker(&registryMutex);
+    threadNames[buffer->id] = threadName;
+}
+
+CTraceThreadBuffer *CTraceZone::getThreadBuffer()
+{
+    CTraceThreadBuffer *buffer;
+
+    if (threadSlots->hasLocalData())
+        return threadSlots->localData()->buffer;
+
+    // first zone in this thread - reuse ring of finished thread or create new one
+    registryMutex.lock();
+    if (!freeBuffers.isEmpty()) {
+        buffer = freeBuffers.takeLast();
+    } else {
+        buffer = new CTraceThreadBuffer();
+        buffers.append(buffer);
+    }
+    assignThreadId(buffer);
+    registryMutex.unlock();
+
+    threadSlots->setLocalData(new CTraceThreadSlot(buffer));
+
+    return buffer;
+}
+
+void CTraceZone::assignThreadId(CTraceThreadBuffer *buffer)
+{
+    // registry mutex is held - name of previous owner is not inherited
+    lastThreadId++;
+    buffer->id = lastThreadId;
+    threadNames[lastThreadId] = QString("thread %1").arg(lastThreadId);
+}
+
+void CTraceZone::releaseThreadBuffer(CTraceThreadBuffer *buffer)
+{
+    QMutexLocker locker(&registryMutex);
+
+    freeBuffers.append(buffer);
+}
+
+bool CTraceZone::writeChromeTrace(const QString &fileName)
+{
+    QFile file(fileName);
+    CTraceThreadBuffer *buffer;
+    CTraceEvent e;
+    QMap<int, QString>::const_iterator it;
+    bool first = true;
+    qint64 head, j;
+    int i;
+    QMutexLocker locker(&registryMutex);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning("Trace - could not write %s", qPrintable(fileName));
+        return false;
+    }
+
+    // chrome://tracing and ui.perfetto.dev format - complete events with times in us
+    QTextStream out(&file);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << endl;
+    for (it=threadNames.constBegin(); it!=threadNames.constEnd(); ++it) {
+        out << (first ? "" : ",\n");
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << it.key()
+            << ",\"args\":{\"name\":\"" << it.value() << "\"}}";
+        first = false;
+    }
+    for (i=0; i<buffers.size(); i++) {
+        buffer = buffers.at(i);
+
+        // events overwritten by writer during dump are skipped
+        head = buffer->events.getHead();
+        for (j=qMax((qint64)0, head - TRACE_RING_SIZE); j<head; j++) {
+            if (!buffer->events.read(j, &e))
+                continue;
+            out << ",\n{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.threadId
+                << ",\"ts\":" << QString::number(e.startNs/1000.0, 'f', 3)
+                << ",\"dur\":" << QString::number(e.durationNs/1000.0, 'f', 3) << "}";
+        }
+    }
+    out << endl << "]}" << endl;
+    out.flush();
+
+    return (file.error()==QFile::NoError) ? true : false;
+}
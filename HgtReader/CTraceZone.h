@@ -0,0 +1,144 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#ifndef CTRACEZONE_H
+#define CTRACEZONE_H
+
+#include <QString>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QThreadStorage>
+#include "CSeqRing.h"
+
+#define TRACE_RING_SIZE         16384       // last events kept for each thread (power of two)
+#define TRACE_FILE_PREFIX       "trace_"    // Chrome trace dumped by F12 - trace_yyyyMMdd_hhmmss.json
+
+// one finished zone - name is string literal so nothing is allocated in hot path
+class CTraceEvent
+{
+public:
+    const char *name;
+    int threadId;                           // tid of thread which owned ring when event was written
+    qint64 startNs;
+    qint64 durationNs;
+};
+
+// ring of events written only by owning thread - dump reads it without stopping writer,
+// reused ring keeps events of finished thread under its old tid
+class CTraceThreadBuffer
+{
+public:
+    CTraceThreadBuffer();
+
+    int id;                                 // tid of current owner - new one for each thread
+    CSeqRing<CTraceEvent> events;
+
+    void append(const char *name, qint64 startNs, qint64 durationNs)
+    {
+        CTraceEvent e;
+
+        e.name = name;
+        e.threadId = id;
+        e.startNs = startNs;
+        e.durationNs = durationNs;
+        events.push(e);
+    }
+};
+
+// thread local handle - buffer is given back for reuse when thread (e.g. from QThreadPool) ends
+class CTraceThreadSlot
+{
+public:
+    CTraceThreadSlot(CTraceThreadBuffer *b) : buffer(b) { }
+    ~CTraceThreadSlot();
+
+    CTraceThreadBuffer *buffer;
+};
+
+// scoped timing zone - time between constructor and destructor is stored in ring of current thread
+class CTraceZone
+{
+public:
+    CTraceZone(const char *zoneName)
+    {
+        buffer = 0;
+        if (enabled) {
+            buffer = getThreadBuffer();
+            name = zoneName;
+            startNs = clock.nsecsElapsed();
+        }
+    }
+    ~CTraceZone()
+    {
+        if (buffer!=0)
+            buffer->append(name, startNs, clock.nsecsElapsed() - startNs);
+    }
+
+    static void setEnabled(bool enable);
+    static bool isEnabled() { return enabled; }
+    static void setThreadName(const QString &threadName);
+    static bool writeChromeTrace(const QString &fileName);
+
+private:
+    CTraceThreadBuffer *buffer;
+    const char *name;
+    qint64 startNs;
+
+    static volatile bool enabled;
+    static QElapsedTimer clock;
+    static QMutex registryMutex;
+    static QList<CTraceThreadBuffer *> buffers;
+    static QList<CTraceThreadBuffer *> freeBuffers;
+    static QMap<int, QString> threadNames;      // every tid given so far - names stay for dump
+    static int lastThreadId;
+    static QThreadStorage<CTraceThreadSlot *> *threadSlots;
+
+    static CTraceThreadBuffer *getThreadBuffer();
+    static void assignThreadId(CTraceThreadBuffer *buffer);
+    static void releaseThreadBuffer(CTraceThreadBuffer *buffer);
+
+    friend class CTraceThreadSlot;
+};
+
+#endif // CTRACEZONE_H
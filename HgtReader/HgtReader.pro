@@ -31,7 +31,22 @@ SOURCES += main.cpp\
     CTerrainData.cpp \
     CCachedTerrainDataGroup.cpp \
     CCachedTerrainData.cpp \
-    CRawFile.cpp
+    CRawFile.cpp \
+    CTerrainUpdateTask.cpp \
+    CCompactTerrainData.cpp \
+    CTileDiskCache.cpp \
+    CTerrainContainer.cpp \
+    CIndexedFile.cpp \
+    CHeightRangeTable.cpp \
+    CElevationCodec.cpp \
+    CRawTiledFile.cpp \
+    CBc1Codec.cpp \
+    CTextureTiles.cpp \
+    CCameraPath.cpp \
+    CCacheTrace.cpp \
+    CTraceZone.cpp \
+    CMetricRing.cpp \
+    CIoStats.cpp
 
 HEADERS  += mainwindow.h \
     CTerrain.h \
@@ -53,6 +68,24 @@ HEADERS  += mainwindow.h \
     CTerrainData.h \
     CCachedTerrainDataGroup.h \
     CCachedTerrainData.h \
-    CRawFile.h
+    CRawFile.h \
+    CTerrainUpdateTask.h \
+    CCompactTerrainData.h \
+    CTileDiskCache.h \
+    CTerrainContainer.h \
+    CIndexedFile.h \
+    CHeightRangeTable.h \
+    CElevationCodec.h \
+    CRawTiledFile.h \
+    CBc1Codec.h \
+    CTextureTiles.h \
+    CCameraPath.h \
+    CCacheTrace.h \
+    CTraceZone.h \
+    CMetricRing.h \
+    CSeqRing.h \
+    CIoStats.h \
+    CIoCounters.h \
+    CTileFileName.h
 
 FORMS    += mainwindow.ui
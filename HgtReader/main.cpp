@@ -42,10 +42,12 @@
 
 #include <QtGui/QApplication>
 #include "mainwindow.h"
+#include "CTraceZone.h"
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+    CTraceZone::setEnabled(true);           // last events of each thread are dumped with F12
     MainWindow w;
     w.show();
 
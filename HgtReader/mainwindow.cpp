@@ -46,6 +46,7 @@
 #include "CDrawingState.h"
 #include "CCommons.h"
 #include "CCamera.h"
+#include "CTraceZone.h"
 
 /*
   sizeof(QVector3D) = 12 bytes
@@ -89,7 +90,9 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
     SLOTreloadEarthPointsSelect(0);
 
     QObject::connect(ui->cacheClearButton, SIGNAL(clicked()), openGl->terrainLoaderThread, SLOT(SLOTclearCache()));
-    QObject::connect(openGl->terrainLoaderThread, SIGNAL(SIGNALupdateCacheInfo(int,int,int,int,unsigned int)), this, SLOT(SLOTupdateCacheInfo(int,int,int,int,unsigned int)));
+    QObject::connect(openGl->terrainLoaderThread, SIGNAL(SIGNALupdateCacheInfo(int,int,int,int,unsigned int,double,double,double,double,double,double)),
+                     this, SLOT(SLOTupdateCacheInfo(int,int,int,int,unsigned int,double,double,double,double,double,double)));
+    QObject::connect(openGl->cacheManager.ioStats, SIGNAL(SIGNALupdateIoInfo(int,int,int,int,double,double,double)), this, SLOT(SLOTupdateIoInfo(int,int,int,int,double,double,double)));
     QObject::connect(ui->benchmarkButton, SIGNAL(clicked()), openGl->animationThread, SLOT(SLOTstartBenchmark()));
     QObject::connect(camera, SIGNAL(SIGNALanimateToEarthPoint(double,double,double,double,double,double)), openGl->animationThread,
                              SLOT(SLOTanimateToEarthPoint(double,double,double,double,double,double)));
@@ -107,6 +110,8 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
     QObject::connect(camera, SIGNAL(SIGNALreloadEarthPointSelect(int)), this, SLOT(SLOTreloadEarthPointsSelect(int)));
     QObject::connect(&(openGl->performance), SIGNAL(SIGNALupdateFrameRenderingInfo(int,double)), this, SLOT(SLOTupdateFrameRenderingInfo(int,double)));
     QObject::connect(&(openGl->performance), SIGNAL(SIGNALupdateTerrainTreeUpdatingInfo(int,int,double)), this, SLOT(SLOTupdateTerrainTreeUpdatingInfo(int,int,double)));
+    QObject::connect(&(openGl->performance), SIGNAL(SIGNALupdateFrameTimeInfo(double,double,double,double)), this, SLOT(SLOTupdateFrameTimeInfo(double,double,double,double)));
+    QObject::connect(&(openGl->performance), SIGNAL(SIGNALupdateTreeUpdateTimeInfo(double,double,double,double)), this, SLOT(SLOTupdateTreeUpdateTimeInfo(double,double,double,double)));
     QObject::connect(ui->drawTerrainPointCheckBox, SIGNAL(stateChanged(int)), drawingState, SLOT(SLOTdrawTerrainPointChanged(int)));
     QObject::connect(ui->drawTerrainPointColorCheckBox, SIGNAL(stateChanged(int)), drawingState, SLOT(SLOTdrawTerrainPointColorChanged(int)));
     QObject::connect(ui->drawTerrainWireCheckBox, SIGNAL(stateChanged(int)), drawingState, SLOT(SLOTdrawTerrainWireChanged(int)));
@@ -129,6 +134,7 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
     QObject::connect(ui->drawAxesCheckBox, SIGNAL(stateChanged(int)), drawingState, SLOT(SLOTdrawAxesChanged(int)));
     QObject::connect(ui->sunEnabledCheckBox, SIGNAL(stateChanged(int)), drawingState, SLOT(SLOTsunEnabledChanged(int)));
     QObject::connect(ui->treeUpdatingCheckBox, SIGNAL(stateChanged(int)), drawingState, SLOT(SLOTtreeUpdatingChanged(int)));
+    QObject::connect(ui->treeUpdatingBudgetSelect, SIGNAL(currentIndexChanged(int)), drawingState, SLOT(SLOTtreeUpdatingBudgetIndexChanged(int)));
     QObject::connect(ui->dontUseDiskHgtCheckBox, SIGNAL(stateChanged(int)), drawingState, SLOT(SLOTdontUseDiskHgtChanged(int)));
     QObject::connect(ui->dontUseDiskRawCheckBox, SIGNAL(stateChanged(int)), drawingState, SLOT(SLOTdontUseDiskRawChanged(int)));
     QObject::connect(ui->dontUseCacheCheckBox, SIGNAL(stateChanged(int)), drawingState, SLOT(SLOTdontUseCacheChanged(int)));
@@ -158,6 +164,37 @@ void MainWindow::keyPressEvent(QKeyEvent *event)
             ui->tabWidget->show(); else
             ui->tabWidget->hide();
     }
+    if (event->key() == Qt::Key_F9)
+        openGl->animationThread->SLOTtoggleCameraPathRecording();
+    if (event->key() == Qt::Key_F10)
+        openGl->animationThread->SLOTstartCameraPathReplay();
+    if (event->key() == Qt::Key_F11)
+        toggleCacheTrace();
+    if (event->key() == Qt::Key_F12)
+        dumpTrace();
+}
+
+void MainWindow::toggleCacheTrace()
+{
+    CCacheTrace *cacheTrace = openGl->cacheManager.cacheTrace;
+
+    // trace is replayed offline by HgtCacheReplay
+    if (cacheTrace->isRecording()) {
+        cacheTrace->stop();
+        openGl->performance.addEventToHistory(QString("[CACHE TRACE STOP] records: ") + QString::number(cacheTrace->getRecordCount()));
+    } else if (cacheTrace->start(openGl->cacheManager.pathBase + CACHE_TRACE_FILE)) {
+        openGl->performance.addEventToHistory("[CACHE TRACE START]");
+    }
+}
+
+void MainWindow::dumpTrace()
+{
+    QString fileName;
+
+    // open in chrome://tracing or ui.perfetto.dev
+    fileName = openGl->cacheManager.pathBase + TRACE_FILE_PREFIX + QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss") + ".json";
+    if (CTraceZone::writeChromeTrace(fileName))
+        openGl->performance.addEventToHistory(QString("[TRACE DUMP] ") + fileName);
 }
 
 void MainWindow::SLOTearthPointAddButtonClicked()
@@ -199,7 +236,8 @@ void MainWindow::changeEvent(QEvent *e)
     }
 }
 
-void MainWindow::SLOTupdateCacheInfo(int cachedTDCount, int cachedTDInUseCount, int cachedTDNotInUseCount, int cachedTDEmptyEntryCount, unsigned int cacheMinNotInUseTime)
+void MainWindow::SLOTupdateCacheInfo(int cachedTDCount, int cachedTDInUseCount, int cachedTDNotInUseCount, int cachedTDEmptyEntryCount, unsigned int cacheMinNotInUseTime,
+                                     double quadtreeMB, double terrainDataMB, double pendingTextureMB, double vramMB, double tablesMB, double performanceHistoryMB)
 {
     int usedunused = cachedTDInUseCount + cachedTDNotInUseCount;
 
@@ -211,6 +249,39 @@ void MainWindow::SLOTupdateCacheInfo(int cachedTDCount, int cachedTDInUseCount,
                                          QString::number(usedunused*REAL_SIZEOF_CTERRAINDATA_CLASS, 'f', 2) + QString(" MB)") );
     ui->erasedTerrainLabel->setText( QString::number(cachedTDEmptyEntryCount) + QString(" (") +
                                      QString::number(cachedTDEmptyEntryCount*REAL_SIZEOF_CTERRAINDATA_CLASS, 'f', 2) + QString(" MB)") );
+
+    ui->quadtreeMemoryLabel->setText( QString::number(quadtreeMB, 'f', 2) + QString(" MB") );
+    ui->terrainDataMemoryLabel->setText( QString::number(terrainDataMB, 'f', 2) + QString(" MB") );
+    ui->pendingTextureMemoryLabel->setText( QString::number(pendingTextureMB, 'f', 2) + QString(" MB") );
+    ui->vramMemoryLabel->setText( QString::number(vramMB, 'f', 2) + QString(" MB") );
+    ui->tablesMemoryLabel->setText( QString::number(tablesMB, 'f', 2) + QString(" MB") );
+    ui->performanceHistoryMemoryLabel->setText( QString::number(performanceHistoryMB, 'f', 2) + QString(" MB") );
+}
+
+void MainWindow::SLOTupdateIoInfo(int source, int opens, int seeks, int reads, double megabytesRead, double ioTimeMs, double kilobytesPerTile)
+{
+    QString text;
+    int i;
+
+    if (source<0 || source>=IO_SOURCES)
+        return;
+
+    ioInfo[source] = CIoStats::getSourceName(source) + QString(": ") +
+                     QString::number(opens) + QString(" opens, ") +
+                     QString::number(seeks) + QString(" seeks, ") +
+                     QString::number(reads) + QString(" reads, ") +
+                     QString::number(megabytesRead, 'f', 2) + QString(" MB (") +
+                     QString::number(kilobytesPerTile, 'f', 1) + QString(" KB/terrain), ") +
+                     QString::number(ioTimeMs, 'f', 1) + QString(" ms");
+
+    // whole table is refreshed once - after the last source
+    if (source!=IO_SOURCES-1)
+        return;
+    for (i=0; i<IO_SOURCES; i++) {
+        if (i>0) text += QString("\n");
+        text += ioInfo[i];
+    }
+    ui->ioInfoLabel->setText(text);
 }
 
 void MainWindow::SLOTupdateCameraInteractMode(int interactState)
@@ -295,6 +366,18 @@ void MainWindow::SLOTupdateTerrainTreeUpdatingInfo(int terrainsInTree, int maxLO
     ui->maxLODLabel->setText( QString::number(maxLOD) );
 }
 
+void MainWindow::SLOTupdateFrameTimeInfo(double p50Ms, double p95Ms, double p99Ms, double maxMs)
+{
+    ui->frameTimeLabel->setText( QString::number(p50Ms, 'f', 1) + QString(" / ") + QString::number(p95Ms, 'f', 1) + QString(" / ") +
+                                 QString::number(p99Ms, 'f', 1) + QString(" / ") + QString::number(maxMs, 'f', 1) );
+}
+
+void MainWindow::SLOTupdateTreeUpdateTimeInfo(double p50Ms, double p95Ms, double p99Ms, double maxMs)
+{
+    ui->treeUpdateTimeLabel->setText( QString::number(p50Ms, 'f', 1) + QString(" / ") + QString::number(p95Ms, 'f', 1) + QString(" / ") +
+                                      QString::number(p99Ms, 'f', 1) + QString(" / ") + QString::number(maxMs, 'f', 1) );
+}
+
 void MainWindow::SLOTkeyMapButtonClicked()
 {
     QMessageBox::about(this, tr("HgtReader - Key map"),
@@ -304,6 +387,10 @@ void MainWindow::SLOTkeyMapButtonClicked()
                 "F3 - switch camera mode to Terrain-Orbit<br/>"
                 "F4 - switch camera mode to Terrain-Free<br/>"
                 "F5 - turn on/off sun moving<br/>"
+                "F9 - start/stop camera path recording<br/>"
+                "F10 - replay recorded camera path<br/>"
+                "F11 - start/stop cache trace<br/>"
+                "F12 - dump timing zones as Chrome trace<br/>"
                 "WSAD - walking in 'Free' camera mode<br/>"
                 "Z - camera FOV +<br/>"
                 "X - camera FOV -<br/>"
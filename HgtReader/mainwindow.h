@@ -45,6 +45,7 @@
 
 #include <QMainWindow>
 #include "COpenGl.h"
+#include "CIoStats.h"
 
 namespace Ui {
     class MainWindow;
@@ -67,9 +68,13 @@ public slots:
     void SLOTearthPointAddButtonClicked();
     void SLOTupdateFrameRenderingInfo(int terrainsQuarterDrawed, double fps);
     void SLOTupdateTerrainTreeUpdatingInfo(int terrainsInTree, int maxLOD, double tups);
+    void SLOTupdateFrameTimeInfo(double p50Ms, double p95Ms, double p99Ms, double maxMs);
+    void SLOTupdateIoInfo(int source, int opens, int seeks, int reads, double megabytesRead, double ioTimeMs, double kilobytesPerTile);
+    void SLOTupdateTreeUpdateTimeInfo(double p50Ms, double p95Ms, double p99Ms, double maxMs);
     void SLOTupdateCameraInteractMode(int interactState);
     void SLOTupdateSunInteractMode(bool sunMoving);
-    void SLOTupdateCacheInfo(int cachedTDCount, int cachedTDInUseCount, int cachedTDNotInUseCount, int cachedTDEmptyEntryCount, unsigned int cacheMinNotInUseTime);
+    void SLOTupdateCacheInfo(int cachedTDCount, int cachedTDInUseCount, int cachedTDNotInUseCount, int cachedTDEmptyEntryCount, unsigned int cacheMinNotInUseTime,
+                             double quadtreeMB, double terrainDataMB, double pendingTextureMB, double vramMB, double tablesMB, double performanceHistoryMB);
 
 protected:
     void changeEvent(QEvent *e);
@@ -78,6 +83,10 @@ protected:
 private:
     Ui::MainWindow *ui;
     COpenGl *openGl;
+    QString ioInfo[IO_SOURCES];             // one line of I/O tab for each source directory
+
+    void toggleCacheTrace();
+    void dumpTrace();
 
 private slots:
     void SLOTaboutButtonClicked();
@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# Converter of RAW texture files to blocked
+# layout read by CRawTiledFile
+#
+#-------------------------------------------------
+
+QT       += core
+QT       -= gui
+
+TARGET = RawTiler
+CONFIG   += console
+CONFIG   -= app_bundle
+TEMPLATE = app
+
+INCLUDEPATH += ../HgtReader
+
+SOURCES += main.cpp \
+    ../HgtReader/CRawTiledFile.cpp
+
+HEADERS += ../HgtReader/CRawTiledFile.h
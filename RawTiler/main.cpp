@@ -0,0 +1,110 @@
+/*
+ *   -------------------------------------------------------------------------
+ *    HgtReader v1.0
+ *                                                    (c) Robert Rypula 156520
+ *                                   Wroclaw University of Technology - Poland
+ *                                                      http://www.pwr.wroc.pl
+ *                                                           2011.01 - 2011.06
+ *   -------------------------------------------------------------------------
+ *
+ *   What is this:
+ *     - graphic system based on OpenGL to visualize entire Earth including
+ *       terrain topography & satellite images
+ *     - part of my thesis "Rendering of complex 3D scenes"
+ *
+ *   What it use:
+ *     - Nokia Qt cross-platform C++ application framework
+ *     - OpenGL graphic library
+ *     - NASA SRTM terrain elevation data:
+ *         oryginal dataset
+ *           http://dds.cr.usgs.gov/srtm/version2_1/SRTM3/
+ *         corrected part of earth:
+ *           http://www.viewfinderpanoramas.org/dem3.html
+ *         SRTM v4 highest quality SRTM dataset avaiable:
+ *           http://srtm.csi.cgiar.org/
+ *     - TrueMarble satellite images
+ *         free version from Unearthed Outdoors (250m/pix):
+ *           http://www.unearthedoutdoors.net/global_data/true_marble/download
+ *     - ALGLIB cross-platform numerical analysis and data processing library
+ *       for SRTM dataset bicubic interpolation from 90m to 103m (more
+ *       flexible LOD division)
+ *         ALGLIB website:
+ *           http://www.alglib.net/
+ *
+ *   Contact to author:
+ *            phone    +48 505-363-331
+ *            e-mail   robert.rypula@gmail.com
+ *            GG       1578139
+ *
+ *                                                   program under GNU licence
+ *   -------------------------------------------------------------------------
+ */
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileInfoList>
+#include <QDateTime>
+#include <math.h>
+#include "CRawTiledFile.h"
+
+// converts RAW texture files to CRawTiledFile layout - .rawt file is written next
+// to each .raw file, HgtReader uses .rawt file when both exist
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QStringList args = a.arguments();
+    QDir dir;
+    QFileInfo fileInfo, tiledInfo;
+    QFileInfoList list;
+    QString tiledName;
+    int i, j, size, converted;
+
+    if (args.size()<2) {
+        qDebug("usage: RawTiler <texture dir> [texture dir] ...");
+        return 1;
+    }
+
+    converted = 0;
+    for (i=1; i<args.size(); i++) {
+        dir.setPath(args.at(i));
+        dir.setFilter(QDir::Files | QDir::NoSymLinks);
+        dir.setSorting(QDir::Name);
+        list = dir.entryInfoList();
+
+        for (j=0; j<list.size(); j++) {
+            fileInfo = list.at(j);
+            if (fileInfo.suffix()!="raw")
+                continue;
+
+            // square RGB texture, side is multiple of block size
+            size = (int)(sqrt(fileInfo.size() / 3.0) + 0.5);
+            if ((qint64)size*size*3 != fileInfo.size() || size % RAW_TILED_BLOCK_SIZE != 0) {
+                qWarning("%s - not a square RAW texture, skipped", qPrintable(fileInfo.fileName()));
+                continue;
+            }
+
+            // already converted after last change of RAW file
+            tiledName = fileInfo.absolutePath() + "/" + fileInfo.completeBaseName() + "." + RAW_TILED_SUFFIX;
+            tiledInfo.setFile(tiledName);
+            if (tiledInfo.exists() && tiledInfo.lastModified()>=fileInfo.lastModified())
+                continue;
+
+            if (!CRawTiledFile::convert(fileInfo.absoluteFilePath(), tiledName + ".tmp", size)) {
+                qWarning("%s - conversion failed", qPrintable(fileInfo.fileName()));
+                QFile::remove(tiledName + ".tmp");
+                continue;
+            }
+            QFile::remove(tiledName);
+            QFile::rename(tiledName + ".tmp", tiledName);
+            converted++;
+            qDebug("%s converted", qPrintable(fileInfo.fileName()));
+        }
+    }
+
+    qDebug("%d files converted", converted);
+
+    return 0;
+}